@@ -18,7 +18,8 @@
 AirShotChipAction::AirShotChipAction(Character * owner, int damage) : ChipAction(owner, "PLAYER_SHOOTING", &attachment, "Buster"), attachmentAnim(NODE_ANIM) {
   this->damage = damage;
 
-  airshot.setTexture(*TextureResourceManager::GetInstance().LoadTextureFromFile(NODE_PATH));
+  airshotTexture = TEXTURES.LoadTexture(NODE_PATH);
+  airshot.setTexture(*airshotTexture);
   this->attachment = new SpriteSceneNode(airshot);
   this->attachment->SetLayer(-1);
 
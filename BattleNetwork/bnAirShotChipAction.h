@@ -2,12 +2,14 @@
 #include "bnChipAction.h"
 #include "bnAnimation.h"
 #include <SFML/Graphics.hpp>
+#include "bnTextureResourceManager.h"
 
 class SpriteSceneNode;
 class Character;
 class AirShotChipAction : public ChipAction {
 private:
   sf::Sprite airshot;
+  TextureHandle airshotTexture;
   SpriteSceneNode* attachment;
   Animation attachmentAnim;
   int damage;
@@ -28,18 +28,18 @@ AlphaArm::AlphaArm(Field* _field, Team _team, AlphaArm::Type type)
   AddDefenseRule(new DefenseIndestructable());
 
   shadow = new SpriteSceneNode();
-  shadow->setTexture(LOAD_TEXTURE(MISC_SHADOW));
+  shadow->setTexture(TEXTURES.LoadTexture(TextureType::MISC_SHADOW));
   shadow->SetLayer(1);
 
   totalElapsed = 0;
 
-  this->setTexture(LOAD_TEXTURE(MOB_ALPHA_ATLAS));
+  this->setTexture(TEXTURES.LoadTexture(TextureType::MOB_ALPHA_ATLAS));
   auto animComponent = (AnimationComponent*)RegisterComponent(new AnimationComponent(this));
   animComponent->Setup(RESOURCE_PATH);
   animComponent->Load();
 
   blueShadow = new SpriteSceneNode();
-  blueShadow->setTexture(LOAD_TEXTURE(MOB_ALPHA_ATLAS));
+  blueShadow->setTexture(TEXTURES.LoadTexture(TextureType::MOB_ALPHA_ATLAS));
   blueShadow->SetLayer(1);
 
   Animation blueShadowAnim(animComponent->GetFilePath());
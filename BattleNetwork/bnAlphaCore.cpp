@@ -25,7 +25,7 @@ AlphaCore::AlphaCore(Rank _rank)
   totalElapsed = 0;
   coreHP = prevCoreHP = 40;
   coreRegen = 0;
-  setTexture(*TEXTURES.GetTexture(TextureType::MOB_ALPHA_ATLAS));
+  setTexture(TEXTURES.LoadTexture(TextureType::MOB_ALPHA_ATLAS));
   setScale(2.f, 2.f);
 
   SetName("Alpha");
@@ -50,40 +50,40 @@ AlphaCore::AlphaCore(Rank _rank)
 
   acid = new SpriteSceneNode();
   acid->SetLayer(1);
-  acid->setTexture(*TEXTURES.GetTexture(TextureType::MOB_ALPHA_ATLAS));
+  acid->setTexture(TEXTURES.LoadTexture(TextureType::MOB_ALPHA_ATLAS));
   animation.SetAnimation("ACID");
   animation.Update(0, *acid);
 
   head = new SpriteSceneNode();
-  head->setTexture(*TEXTURES.GetTexture(TextureType::MOB_ALPHA_ATLAS));
+  head->setTexture(TEXTURES.LoadTexture(TextureType::MOB_ALPHA_ATLAS));
   head->SetLayer(-2);
   animation.SetAnimation("HEAD");
   animation.Update(0, *head);
 
   side = new SpriteSceneNode();
-  side->setTexture(*TEXTURES.GetTexture(TextureType::MOB_ALPHA_ATLAS));
+  side->setTexture(TEXTURES.LoadTexture(TextureType::MOB_ALPHA_ATLAS));
   side->SetLayer(-1);
   animation.SetAnimation("SIDE");
   animation.Update(0, *side);
 
   leftShoulder = new SpriteSceneNode();
-  leftShoulder->setTexture(*TEXTURES.GetTexture(TextureType::MOB_ALPHA_ATLAS));
+  leftShoulder->setTexture(TEXTURES.LoadTexture(TextureType::MOB_ALPHA_ATLAS));
   leftShoulder->SetLayer(0);
   animation.SetAnimation("LEFT_SHOULDER");
   animation.Update(0, *leftShoulder);
 
   rightShoulder = new SpriteSceneNode();
-  rightShoulder->setTexture(*TEXTURES.GetTexture(TextureType::MOB_ALPHA_ATLAS));
+  rightShoulder->setTexture(TEXTURES.LoadTexture(TextureType::MOB_ALPHA_ATLAS));
   rightShoulder->SetLayer(-3);
   animation.SetAnimation("RIGHT_SHOULDER");
   animation.Update(0, *rightShoulder);
 
   rightShoulderShoot= new SpriteSceneNode();
-  rightShoulderShoot->setTexture(*TEXTURES.GetTexture(TextureType::MOB_ALPHA_ATLAS));
+  rightShoulderShoot->setTexture(TEXTURES.LoadTexture(TextureType::MOB_ALPHA_ATLAS));
   rightShoulderShoot->SetLayer(-4);
 
   leftShoulderShoot = new SpriteSceneNode();
-  leftShoulderShoot->setTexture(*TEXTURES.GetTexture(TextureType::MOB_ALPHA_ATLAS));
+  leftShoulderShoot->setTexture(TEXTURES.LoadTexture(TextureType::MOB_ALPHA_ATLAS));
   leftShoulderShoot->SetLayer(-4);
 
   this->AddNode(acid);
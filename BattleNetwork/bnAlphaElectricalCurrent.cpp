@@ -7,7 +7,7 @@
 
 AlphaElectricCurrent::AlphaElectricCurrent(Field* field, Team team, int count) : countMax(count), count(0), Spell(field, team)
 {
-  this->setTexture(LOAD_TEXTURE(MOB_ALPHA_ATLAS));
+  this->setTexture(TEXTURES.LoadTexture(TextureType::MOB_ALPHA_ATLAS));
   anim = (AnimationComponent*)RegisterComponent(new AnimationComponent(this));
   anim->Setup(RESOURCE_PATH);
   anim->Load();
@@ -14,8 +14,8 @@ AlphaRocket::AlphaRocket(Field* _field, Team _team) : Obstacle(_field, _team)  {
   this->ShareTileSpace(true);
   SetLayer(-1);
 
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_ALPHA_ROCKET);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_ALPHA_ROCKET);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   this->SetSlideTime(sf::seconds(0.5f));
@@ -34,7 +34,7 @@ AlphaRocket::AlphaRocket(Field* _field, Team _team) : Obstacle(_field, _team)  {
 
   SetHealth(100);
 
-  Logger::Log("rocket spawned");
+  LOG_TRACE(BATTLE, "rocket spawned");
 }
 
 AlphaRocket::~AlphaRocket() {
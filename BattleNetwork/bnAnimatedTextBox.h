@@ -23,6 +23,7 @@
 class AnimatedTextBox : public sf::Drawable, public sf::Transformable {
 private:
   mutable sf::Sprite frame; /*!< Size is calculated from the frame sprite */ 
+  TextureHandle frameTexture; /*!< Keeps the frame texture loaded */
   mutable Animation mugAnimator; /*!< Animators the mugshot frames */
   bool isPaused; /*!< Pause text flag */
   bool isReady; /*!< Ready to type text flag */
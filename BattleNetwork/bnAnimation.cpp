@@ -4,6 +4,8 @@ using sf::IntRect;
 
 #include "bnAnimation.h"
 #include "bnFileUtil.h"
+#include "bnAnimationCache.h"
+#include "bnKeyValueReader.h"
 #include "bnLogger.h"
 #include "bnEntity.h"
 #include <cmath>
@@ -27,7 +29,8 @@ Animation::Animation(const Animation& rhs) {
 
 Animation & Animation::operator=(const Animation & rhs)
 {
-  this->animations = rhs.animations;
+  this->frameLists = rhs.frameLists;
+  this->overrides = rhs.overrides;
   this->animator = rhs.animator;
   this->currAnimation = rhs.currAnimation;
   this->path = rhs.path;
@@ -39,110 +42,91 @@ Animation::~Animation() {
 }
 
 void Animation::Reload() {
-  int frameAnimationIndex = -1;
-  vector<FrameList> frameLists;
-  string currentState = "";
-  float currentAnimationDuration = 0.0f;
+  progress = 0;
+  frameLists = ANIMATIONS.Load(path);
+}
+
+void Animation::Parse(const string& data, FrameListMap& animations, const string& source) {
+  KeyValueReader reader(data, source);
+
+  FrameList frameList;
+  string currentState;
+  bool hasState = false;
   int currentWidth = 0;
   int currentHeight = 0;
   bool legacySupport = false;
-  progress = 0;
-  string data = FileUtil::Read(path);
-  int endline = 0;
-  do {
-    endline = (int)data.find("\n");
-    string line = data.substr(0, endline);
+
+  while (reader.Next()) {
+    std::string_view tag = reader.GetTag();
 
     // NOTE: Support older animation files until we upgrade completely...
-    if (line.find("VERSION") != string::npos) {
-      string version = ValueOf("VERSION", line);
-      if (version == "1.0") legacySupport = true;
+    if (tag.empty()) {
+      std::string_view version;
 
+      if (reader.Find("VERSION", version) && version == "1.0") {
+        legacySupport = true;
+      }
     }
-    else if (line.find("animation") != string::npos) {
-      if (!frameLists.empty()) {
-        //std::cout << "animation total seconds: " << sf::seconds(currentAnimationDuration).asSeconds() << "\n";
-        //std::cout << "animation name push " << currentState << endl;
-        animations.insert(std::make_pair(currentState, frameLists.at(frameAnimationIndex)));
-        currentAnimationDuration = 0.0f;
+    else if (tag == "animation") {
+      if (hasState) {
+        animations.insert(std::make_pair(currentState, std::move(frameList)));
+        frameList = FrameList();
       }
-      string state = ValueOf("state", line);
-      currentState = state;
+
+      currentState = KeyValueReader::ToString(reader.Require("state"));
+      hasState = true;
 
       std::transform(currentState.begin(), currentState.end(), currentState.begin(), ::toupper);
 
       if (legacySupport) {
-        string width = ValueOf("width", line);
-        string height = ValueOf("height", line);
-        //std::cout << "animation name in " << currentState << endl;
-
-        currentWidth = atoi(width.c_str());
-        currentHeight = atoi(height.c_str());
+        currentWidth = KeyValueReader::ToInt(reader.Require("width"));
+        currentHeight = KeyValueReader::ToInt(reader.Require("height"));
       }
-
-      frameLists.push_back(FrameList());
-      frameAnimationIndex++;
     }
-    else if (line.find("frame") != string::npos) {
-      string duration = ValueOf("duration", line);
-      float currentFrameDuration = (float)atof(duration.c_str());
-
-      int currentStartx = 0;
-      int currentStarty = 0;
-      float originX = 0;
-      float originY = 0;
-
-      if (legacySupport) {
-        string startx = ValueOf("startx", line);
-        string starty = ValueOf("starty", line);
-
-        currentStartx = atoi(startx.c_str());
-        currentStarty = atoi(starty.c_str());
-      }
-      else {
-        string x = ValueOf("x", line);
-        string y = ValueOf("y", line);
-        string w = ValueOf("w", line);
-        string h = ValueOf("h", line);
-        string ox = ValueOf("originx", line);
-        string oy = ValueOf("originy", line);
-
-        currentStartx = atoi(x.c_str());
-        currentStarty = atoi(y.c_str());
-        currentWidth = atoi(w.c_str());
-        currentHeight = atoi(h.c_str());
-        originX = (float)atoi(ox.c_str());
-        originY = (float)atoi(oy.c_str());
+    else if (tag == "frame") {
+      if (!hasState) {
+        reader.Error("Frame does not belong to an animation");
+        continue;
       }
 
-      currentAnimationDuration += currentFrameDuration;
+      float currentFrameDuration = KeyValueReader::ToFloat(reader.Require("duration"));
 
       if (legacySupport) {
-        frameLists.at(frameAnimationIndex).Add(currentFrameDuration, IntRect(currentStartx, currentStarty, currentWidth, currentHeight));
+        int currentStartx = KeyValueReader::ToInt(reader.Require("startx"));
+        int currentStarty = KeyValueReader::ToInt(reader.Require("starty"));
+
+        frameList.Add(currentFrameDuration, IntRect(currentStartx, currentStarty, currentWidth, currentHeight));
       }
       else {
-        frameLists.at(frameAnimationIndex).Add(currentFrameDuration, IntRect(currentStartx, currentStarty, currentWidth, currentHeight), sf::Vector2f(originX, originY));
+        int currentStartx = KeyValueReader::ToInt(reader.Require("x"));
+        int currentStarty = KeyValueReader::ToInt(reader.Require("y"));
+        currentWidth = KeyValueReader::ToInt(reader.Require("w"));
+        currentHeight = KeyValueReader::ToInt(reader.Require("h"));
+        float originX = (float)KeyValueReader::ToInt(reader.Require("originx"));
+        float originY = (float)KeyValueReader::ToInt(reader.Require("originy"));
+
+        frameList.Add(currentFrameDuration, IntRect(currentStartx, currentStarty, currentWidth, currentHeight), sf::Vector2f(originX, originY));
       }
     }
-    else if (line.find("point") != string::npos) {
-      string pointName = ValueOf("label", line);
-      string xStr = ValueOf("x", line);
-      string yStr = ValueOf("y", line);
+    else if (tag == "point") {
+      if (frameList.IsEmpty()) {
+        reader.Error("Point does not belong to a frame");
+        continue;
+      }
 
-      std::transform(pointName.begin(), pointName.end(), pointName.begin(), ::toupper);
+      string pointName = KeyValueReader::ToString(reader.Require("label"));
+      int x = KeyValueReader::ToInt(reader.Require("x"));
+      int y = KeyValueReader::ToInt(reader.Require("y"));
 
-      int x = atoi(xStr.c_str());
-      int y = atoi(yStr.c_str());
+      std::transform(pointName.begin(), pointName.end(), pointName.begin(), ::toupper);
 
-      frameLists[frameAnimationIndex].SetPoint(pointName, x, y);
+      frameList.SetPoint(pointName, x, y);
     }
-
-    data = data.substr(endline + 1);
-  } while (endline > -1);
+  }
 
   // One more addAnimation to do if file is good
-  if (frameAnimationIndex >= 0) {
-    animations.insert(std::make_pair(currentState, frameLists.at(frameAnimationIndex)));
+  if (hasState) {
+    animations.insert(std::make_pair(currentState, std::move(frameList)));
   }
 }
 
@@ -151,11 +135,22 @@ void Animation::Load()
   Reload();
 }
 
-string Animation::ValueOf(string _key, string _line) {
-  int keyIndex = (int)_line.find(_key);
-  // assert(keyIndex > -1 && "Key was not found in .animation file.");
-  string s = _line.substr(keyIndex + _key.size() + 2);
-  return s.substr(0, s.find("\""));
+const FrameList& Animation::Find(const string& state) const {
+  static const FrameList empty;
+
+  auto iter = overrides.find(state);
+  if (iter != overrides.end()) return iter->second;
+
+  if (frameLists) {
+    auto shared = frameLists->find(state);
+    if (shared != frameLists->end()) return shared->second;
+  }
+
+  return empty;
+}
+
+const bool Animation::HasAnimation(const string& state) const {
+  return overrides.find(state) != overrides.end() || (frameLists && frameLists->find(state) != frameLists->end());
 }
 
 void Animation::Refresh(sf::Sprite& target) {
@@ -169,16 +164,16 @@ void Animation::Update(float elapsed, sf::Sprite& target, double playbackSpeed)
 
   std::string stateNow = currAnimation;
 
-  animator(progress, target, animations[currAnimation]);
+  animator(progress, target, Find(currAnimation));
 
   if(currAnimation != stateNow) {
 	  // it was changed during a callback
 	  // apply new state to target on same frame
-	  animator(0, target, animations[currAnimation]);
+	  animator(0, target, Find(currAnimation));
 	  progress = 0;
   }
 
-  const float duration = animations[currAnimation].GetTotalDuration();
+  const float duration = Find(currAnimation).GetTotalDuration();
 
   if(duration <= 0.f) return;
 
@@ -195,21 +190,22 @@ void Animation::SyncTime(float newTime)
 
 void Animation::SetFrame(int frame, sf::Sprite& target)
 {
-  if(path.empty() || animations.empty() || animations.find(currAnimation) == animations.end()) return;
+  if(path.empty() || !HasAnimation(currAnimation)) return;
 
-  auto size = animations[currAnimation].GetFrameCount();
+  const FrameList& list = Find(currAnimation);
+  auto size = list.GetFrameCount();
 
   if (frame <= 0 || frame > size) {
     progress = 0.0f;
-    animator.SetFrame(int(size), target, animations[currAnimation]);
+    animator.SetFrame(int(size), target, list);
 
   }
   else {
-    animator.SetFrame(frame, target, animations[currAnimation]);
+    animator.SetFrame(frame, target, list);
     progress = 0.0f;
 
     while (frame) {
-      progress += animations[currAnimation].GetFrame(--frame).duration;
+      progress += list.GetFrame(--frame).duration;
     }
   }
 }
@@ -220,11 +216,9 @@ void Animation::SetAnimation(string state) {
 
    std::transform(state.begin(), state.end(), state.begin(), ::toupper);
 
-   auto pos = animations.find(state);
-
-   if (pos == animations.end()) {
+   if (!HasAnimation(state)) {
      //throw std::runtime_error(std::string("No animation found in file for " + currAnimation));
-     Logger::Log("No animation found in file for " + state);
+     LOG_WARN(CONTENT, "No animation found in file for %s", state.c_str());
    }
    else {
      currAnimation = state;
@@ -241,10 +235,10 @@ const std::string Animation::GetAnimationString() const
   return currAnimation;
 }
 
-FrameList & Animation::GetFrameList(std::string animation)
+const FrameList & Animation::GetFrameList(std::string animation)
 {
   std::transform(animation.begin(), animation.end(), animation.begin(), ::toupper);
-  return animations[animation];
+  return Find(animation);
 }
 
 Animation & Animation::operator<<(Animator::On rhs)
@@ -288,7 +282,8 @@ void Animation::OverrideAnimationFrames(const std::string& animation, std::list
     uuid = animation + "@" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
   }
 
-  this->animations.emplace(uuid, std::move(this->animations[animation].MakeNewFromOverrideData(data)));
+  // Shared frame lists are immutable. Overrides belong to this animation only.
+  this->overrides.emplace(uuid, Find(animation).MakeNewFromOverrideData(data));
 }
 
 void Animation::SyncAnimation(Animation & other)
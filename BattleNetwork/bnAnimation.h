@@ -6,6 +6,7 @@
 #include <iostream>
 
 #include "bnAnimator.h"
+#include "bnAnimationCache.h"
 
 using std::string;
 using std::to_string;
@@ -44,6 +45,12 @@ using std::to_string;
  * ```
  *
  * etc.
+ *
+ * Parsed files are compiled to a binary cache next to the text file and
+ * loaded from it until the text changes. @see CompiledAnimation
+ *
+ * Frame lists are shared with every other Animation of the same file.
+ * Only playback state and frame overrides belong to each instance. @see AnimationCache
  */
 class Animation {
 public:
@@ -138,7 +145,7 @@ public:
    * @return FrameList&
    * @warning Make sure this animation exists otherwise could return an empty frame list or throw
    */
-  FrameList& GetFrameList(std::string animation);
+  const FrameList& GetFrameList(std::string animation);
 
   /**
    * @brief Append frame callback
@@ -173,18 +180,34 @@ public:
 
   void SyncAnimation(Animation& other);
 
+  /**
+   * @brief Parses the text format into FrameLists
+   * @param data contents of an animation file
+   * @param animations FrameLists are added to this map by state name
+   * @param source name of the file for error messages
+   */
+  static void Parse(const string& data, FrameListMap& animations, const string& source = "");
+
 private:
+
+  /**
+   * @brief Find the FrameList for a state
+   * @param state upper case state name
+   * @return overridden or shared FrameList. An empty FrameList if there is no such state.
+   */
+  const FrameList& Find(const string& state) const;
+
   /**
-   * @brief Strips the key-value from a file format
-   * @param _key to look for value of
-   * @param _line string input
-   * @return value as string or empty string
+   * @brief Query if a state exists
+   * @param state upper case state name
+   * @return true if the state is overridden or in the file
    */
-  string ValueOf(string _key, string _line);
+  const bool HasAnimation(const string& state) const;
 protected:
   Animator animator; /*!< Internal animator to delegate most of the work to */
   string path; /*!< Path to the animation file */
   string currAnimation; /*!< Name of the current animation state */
   float progress; /*!< Current progress of animation */
-  std::map<string, FrameList> animations; /*!< Dictionary of FrameLists read from file */
+  SharedFrameLists frameLists; /*!< FrameLists read from file. Shared with every Animation of the same file */
+  std::map<string, FrameList> overrides; /*!< FrameLists made by OverrideAnimationFrames() for this instance */
 };
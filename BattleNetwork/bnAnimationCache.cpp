@@ -0,0 +1,93 @@
+#include "bnAnimationCache.h"
+#include "bnAnimation.h"
+#include "bnCompiledAnimation.h"
+#include "bnFileUtil.h"
+
+AnimationCache& AnimationCache::GetInstance() {
+  static AnimationCache instance;
+  return instance;
+}
+
+void AnimationCache::Read(const std::string& path, FrameListMap& animations) {
+  std::string data;
+
+  if (!CompiledAnimation::Load(path, animations, data)) {
+    if (data.empty()) {
+      data = FileUtil::Read(path);
+    }
+
+    Animation::Parse(data, animations, path);
+
+    if (!animations.empty()) {
+      CompiledAnimation::Save(path, data, animations);
+    }
+  }
+}
+
+SharedFrameLists AnimationCache::Load(const std::string& path) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto iter = cache.find(path);
+    if (iter != cache.end()) return iter->second;
+  }
+
+  // Load without the lock so other threads can load other files
+  auto animations = std::make_shared<FrameListMap>();
+  Read(path, *animations);
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // If another thread loaded it first, share theirs
+  return cache.insert(std::make_pair(path, animations)).first->second;
+}
+
+void AnimationCache::Invalidate(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex);
+  cache.erase(path);
+}
+
+bool AnimationCache::Reload(const std::string& path) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cache.find(path) == cache.end()) return false;
+  }
+
+  FrameListMap animations;
+  Read(path, animations);
+
+  // A half written file parses to nothing. Keep what we had.
+  if (animations.empty()) return false;
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto iter = cache.find(path);
+  if (iter == cache.end()) return false;
+
+  // Animations that hold the old map keep it. The next Load() gets the new one.
+  iter->second = std::make_shared<const FrameListMap>(std::move(animations));
+  return true;
+}
+
+std::size_t AnimationCache::Prune() {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  std::size_t count = 0;
+
+  for (auto iter = cache.begin(); iter != cache.end();) {
+    if (iter->second.use_count() == 1) {
+      iter = cache.erase(iter);
+      count++;
+    }
+    else {
+      iter++;
+    }
+  }
+
+  return count;
+}
+
+const std::size_t AnimationCache::GetSize() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return cache.size();
+}
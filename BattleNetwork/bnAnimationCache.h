@@ -0,0 +1,89 @@
+/*! \file bnAnimationCache.h */
+
+/*! \brief Shares parsed animation files between every Animation that uses them
+ *
+ * Frame lists never change after they are loaded, so each file is loaded once
+ * and every Animation holds a reference to the same data. Copying an Animation
+ * or spawning another projectile with the same file costs a reference count
+ * instead of a deep copy of every frame and point.
+ *
+ * Entries live until Prune() finds that nothing else references them.
+ * Reload() is the one exception to frame lists never changing. It swaps new
+ * data in behind the same reference so every Animation picks up the edit.
+ */
+#pragma once
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "bnAnimator.h"
+
+/*! \brief Immutable frame lists of one animation file by state name */
+typedef std::map<std::string, FrameList> FrameListMap;
+typedef std::shared_ptr<const FrameListMap> SharedFrameLists;
+
+class AnimationCache {
+public:
+  /**
+   * @brief If this is the first call, initializes the cache.
+   * @return Returns reference to the cache.
+   */
+  static AnimationCache& GetInstance();
+
+  /**
+   * @brief Get the frame lists for an animation file, loading them if needed
+   * @param path relative path from application to file
+   * @return shared frame lists. Empty if the file has no animations.
+   *
+   * Safe to call from loading threads
+   */
+  SharedFrameLists Load(const std::string& path);
+
+  /**
+   * @brief Drop a file so the next Load() reads it again
+   * @param path
+   *
+   * Animations that already hold the old data keep it
+   */
+  void Invalidate(const std::string& path);
+
+  /**
+   * @brief Parse a file again and replace the cached frame lists
+   * @param path
+   * @return false if the file was not loaded
+   *
+   * Animations that already hold the old data keep it until they load again
+   *
+   * Must be called from the main thread between frames
+   */
+  bool Reload(const std::string& path);
+
+  /**
+   * @brief Drop every file that no Animation is using
+   * @return number of files dropped
+   */
+  std::size_t Prune();
+
+  /**
+   * @brief Query how many files are loaded
+   * @return file count
+   */
+  const std::size_t GetSize();
+
+private:
+  AnimationCache() = default;
+
+  /**
+   * @brief Read the compiled cache or parse the text file
+   * @param path
+   * @param animations filled with the frame lists
+   */
+  static void Read(const std::string& path, FrameListMap& animations);
+
+  std::mutex mutex; /*!< Guards cache */
+  std::map<std::string, SharedFrameLists> cache; /*!< Loaded files by path. Never written through once shared. */
+};
+
+/*! \brief Shorthand to get instance of the animation cache */
+#define ANIMATIONS AnimationCache::GetInstance()
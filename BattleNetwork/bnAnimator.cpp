@@ -41,13 +41,13 @@ Animator::~Animator() {
   this->queuedOnFinish = nullptr;
 }
 
-void Animator::UpdateCurrentPoints(int frameIndex, FrameList& sequence) {
+void Animator::UpdateCurrentPoints(int frameIndex, const FrameList& sequence) {
   if (sequence.frames.size() <= frameIndex) return;
 
   currentPoints = sequence.frames[frameIndex].points;
 }
 
-void Animator::operator() (float progress, sf::Sprite& target, FrameList& sequence) {
+void Animator::operator() (float progress, sf::Sprite& target, const FrameList& sequence) {
   float startProgress = progress;
 
   // If we did not progress while in an update, do not merge the queues and ignore this request 
@@ -328,7 +328,7 @@ const sf::Vector2f Animator::GetPoint(const std::string& pointName) {
   auto str = pointName;
   std::transform(str.begin(), str.end(), str.begin(), ::toupper);
   if (currentPoints.find(str) == currentPoints.end()) {
-    Logger::Log("Could not find point in current sequence named " + str);
+    LOG_DEBUG(CONTENT, "Could not find point in current sequence named %s", str.c_str());
     return sf::Vector2f();
   }
   return currentPoints[str];
@@ -340,10 +340,10 @@ void Animator::Clear() {
   nextLoopCallbacks.clear(); callbacks.clear(); onetimeCallbacks.clear(); onFinish = nullptr; playbackMode = 0;
 }
 
-void Animator::SetFrame(int frameIndex, sf::Sprite & target, FrameList& sequence)
+void Animator::SetFrame(int frameIndex, sf::Sprite & target, const FrameList& sequence)
 {
   int index = 0;
-  for (Frame& frame : sequence.frames) {
+  for (const Frame& frame : sequence.frames) {
     index++;
 
     if (index == frameIndex) {
@@ -358,6 +358,6 @@ void Animator::SetFrame(int frameIndex, sf::Sprite & target, FrameList& sequence
     }
   }
 
-  Logger::Log("finished without applying frame. Frame sizes: " + std::to_string(sequence.frames.size()));
+  LOG_DEBUG(CONTENT, "finished without applying frame. Frame sizes: %i", (int)sequence.frames.size());
 
 }
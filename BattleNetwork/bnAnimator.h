@@ -87,7 +87,7 @@ public:
     totalDuration = rhs.totalDuration;
   }
 
-  FrameList MakeNewFromOverrideData(std::list<OverrideFrame> data) {
+  FrameList MakeNewFromOverrideData(std::list<OverrideFrame> data) const {
     auto iter = data.begin();
 
     FrameList res;
@@ -141,14 +141,14 @@ public:
  * @brief Get the total number of frames in this list
  * @return const unsigned int
  */
-  const size_t GetFrameCount() { return this->frames.size(); }
+  const size_t GetFrameCount() const { return this->frames.size(); }
 
   /**
   * @brief Get the frame data at the given index
   * @param index of the frame in the list (base 0)
   * @return const Frame immutable
   */
-  const Frame& GetFrame(const int index) { return this->frames[index]; }
+  const Frame& GetFrame(const int index) const { return this->frames[index]; }
 
   /**
    * @brief Get the total duration for the list of frames
@@ -192,7 +192,7 @@ private:
   bool isUpdating; /*!< Flag if in the middle of update */
   bool callbacksAreValid; /*!< Flag for queues. If false, all added callbacks are discarded. */
   
-  void UpdateCurrentPoints(int frameIndex, FrameList& sequence);
+  void UpdateCurrentPoints(int frameIndex, const FrameList& sequence);
 
 public:
   inline static const std::function<void()> NoCallback = [](){};
@@ -269,7 +269,7 @@ public:
    * @param target sprite to apply frames to
    * @param sequence list of frames
    */
-  void operator() (float progress, sf::Sprite& target, FrameList& sequence);
+  void operator() (float progress, sf::Sprite& target, const FrameList& sequence);
   
   /**
    * @brief Applies a callback
@@ -297,5 +297,5 @@ public:
    * @param target sprite to apply frame to
    * @param sequence frame is pulled from list using index
    */
-  void SetFrame(int frameIndex, sf::Sprite& target, FrameList& sequence);
+  void SetFrame(int frameIndex, sf::Sprite& target, const FrameList& sequence);
 };
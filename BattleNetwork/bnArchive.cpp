@@ -0,0 +1,290 @@
+#include "bnArchive.h"
+#include "bnFileUtil.h"
+#include "bnLogger.h"
+
+#include <cstring>
+#include <algorithm>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__ANDROID__)
+#include <SFML/System.hpp>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+Archive& Archive::GetInstance() {
+  static Archive instance;
+  return instance;
+}
+
+Archive::Archive() : data(nullptr), size(0), entries(nullptr), entryCount(0), modified(0) {
+#if defined(_WIN32)
+  fileHandle = mappingHandle = nullptr;
+#endif
+}
+
+Archive::~Archive() {
+  Unmount();
+}
+
+bool Archive::Mount(const std::string& path) {
+  Unmount();
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) return false;
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    CloseHandle(file);
+    return false;
+  }
+
+  const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!view) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  fileHandle = file;
+  mappingHandle = mapping;
+  data = static_cast<const char*>(view);
+  size = static_cast<std::size_t>(fileSize.QuadPart);
+#elif defined(__ANDROID__)
+  // The archive is an APK asset. There is no file descriptor to map.
+  sf::FileInputStream in;
+  if (!in.open(path) || in.getSize() <= 0) return false;
+
+  buffer.resize(static_cast<std::size_t>(in.getSize()));
+  in.read(buffer.data(), in.getSize());
+
+  data = buffer.data();
+  size = buffer.size();
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    close(fd);
+    return false;
+  }
+
+  void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping keeps the file alive
+  close(fd);
+
+  if (view == MAP_FAILED) return false;
+
+  data = static_cast<const char*>(view);
+  size = static_cast<std::size_t>(info.st_size);
+#endif
+
+  const Header* header = reinterpret_cast<const Header*>(data);
+
+  bool valid = size >= sizeof(Header)
+    && std::memcmp(header->magic, "OBNP", 4) == 0
+    && header->version == VERSION
+    && sizeof(Header) + static_cast<std::uint64_t>(header->entryCount) * sizeof(Entry) <= size;
+
+  if (!valid) {
+    LOG_ERROR(CONTENT, "Archive %s is not a valid resource pack", path.c_str());
+    Unmount();
+    return false;
+  }
+
+  entries = reinterpret_cast<const Entry*>(data + sizeof(Header));
+  entryCount = header->entryCount;
+  modified = FileUtil::GetModifiedTime(path);
+
+  LOG_INFO(CONTENT, "Mounted archive %s with %i files", path.c_str(), (int)entryCount);
+
+  return true;
+}
+
+void Archive::Unmount() {
+  {
+    std::lock_guard<std::mutex> lock(decompressMutex);
+    decompressed.clear();
+  }
+
+#if defined(_WIN32)
+  if (data) UnmapViewOfFile(data);
+  if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+  if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+  fileHandle = mappingHandle = nullptr;
+#elif defined(__ANDROID__)
+  buffer.clear();
+  buffer.shrink_to_fit();
+#else
+  if (data) munmap(const_cast<char*>(data), size);
+#endif
+
+  data = nullptr;
+  size = 0;
+  entries = nullptr;
+  entryCount = 0;
+  modified = 0;
+}
+
+const bool Archive::IsMounted() const {
+  return data != nullptr;
+}
+
+std::uint64_t Archive::Hash(const std::string& path) {
+  std::uint64_t hash = 14695981039346656037ull;
+
+  for (char c : path) {
+    // Windows paths hash the same as the packed paths
+    unsigned char byte = static_cast<unsigned char>(c == '\\' ? '/' : c);
+    hash ^= byte;
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+const Archive::Entry* Archive::FindEntry(const std::string& path) const {
+  if (!entries) return nullptr;
+
+  std::uint64_t hash = Hash(path);
+
+  const Entry* end = entries + entryCount;
+  const Entry* iter = std::lower_bound(entries, end, hash, [](const Entry& entry, std::uint64_t value) {
+    return entry.hash < value;
+  });
+
+  // Compare the path too in case two paths share a hash
+  for (; iter != end && iter->hash == hash; ++iter) {
+    if (static_cast<std::uint64_t>(iter->pathOffset) + iter->pathLength > size) return nullptr;
+
+    const char* packedPath = data + iter->pathOffset;
+
+    if (iter->pathLength != path.size()) continue;
+
+    bool same = true;
+    for (std::size_t i = 0; i < path.size() && same; i++) {
+      char c = path[i] == '\\' ? '/' : path[i];
+      same = packedPath[i] == c;
+    }
+
+    if (same) return iter;
+  }
+
+  return nullptr;
+}
+
+bool Archive::Find(const std::string& path, ArchiveView& view) {
+  const Entry* entry = FindEntry(path);
+
+  // Written this way so a huge offset or size cannot wrap around
+  if (!entry || entry->offset > size || entry->packedSize > size - entry->offset) return false;
+
+  if ((entry->flags & Flags::lz4) == 0) {
+    // Stored files are read straight from the mapping. Only the packed bytes were bounds checked.
+    if (entry->size != entry->packedSize) return false;
+
+    view.data = data + entry->offset;
+    view.size = static_cast<std::size_t>(entry->size);
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock(decompressMutex);
+
+  auto iter = decompressed.find(entry);
+
+  if (iter == decompressed.end()) {
+    std::vector<char> bytes(static_cast<std::size_t>(entry->size));
+
+    if (!DecompressLZ4(data + entry->offset, static_cast<std::size_t>(entry->packedSize), bytes.data(), bytes.size())) {
+      LOG_ERROR(CONTENT, "Corrupt packed file %s", path.c_str());
+      return false;
+    }
+
+    iter = decompressed.insert(std::make_pair(entry, std::move(bytes))).first;
+  }
+
+  view.data = iter->second.data();
+  view.size = iter->second.size();
+
+  return true;
+}
+
+std::uint64_t Archive::GetSize(const std::string& path) {
+  const Entry* entry = FindEntry(path);
+  return entry ? entry->size : 0;
+}
+
+const long long Archive::GetModifiedTime() const {
+  return modified;
+}
+
+bool Archive::DecompressLZ4(const char* src, std::size_t srcSize, char* dst, std::size_t dstSize) {
+  const unsigned char* ip = reinterpret_cast<const unsigned char*>(src);
+  const unsigned char* iend = ip + srcSize;
+  unsigned char* op = reinterpret_cast<unsigned char*>(dst);
+  unsigned char* const ostart = op;
+  unsigned char* const oend = op + dstSize;
+
+  // Lengths of 15 are continued by bytes until one is not 255
+  auto readLength = [&ip, iend](std::size_t& length) {
+    unsigned char byte = 255;
+    while (byte == 255) {
+      if (ip >= iend) return false;
+      byte = *ip++;
+      length += byte;
+    }
+    return true;
+  };
+
+  while (ip < iend) {
+    unsigned token = *ip++;
+
+    std::size_t literals = token >> 4;
+    if (literals == 15 && !readLength(literals)) return false;
+
+    if (literals > static_cast<std::size_t>(iend - ip) || literals > static_cast<std::size_t>(oend - op)) return false;
+
+    std::memcpy(op, ip, literals);
+    op += literals;
+    ip += literals;
+
+    // The last sequence is only literals
+    if (ip >= iend) break;
+
+    if (iend - ip < 2) return false;
+
+    std::size_t offset = static_cast<std::size_t>(ip[0]) | (static_cast<std::size_t>(ip[1]) << 8);
+    ip += 2;
+
+    if (offset == 0 || offset > static_cast<std::size_t>(op - ostart)) return false;
+
+    std::size_t match = token & 15;
+    if (match == 15 && !readLength(match)) return false;
+    match += 4;
+
+    if (match > static_cast<std::size_t>(oend - op)) return false;
+
+    // Matches can overlap the output so copy forward one byte at a time
+    const unsigned char* from = op - offset;
+    while (match--) {
+      *op++ = *from++;
+    }
+  }
+
+  return op == oend;
+}
@@ -0,0 +1,169 @@
+/*! \file bnArchive.h */
+
+/*! \brief Read-only pack of the resources/ directory mapped into memory
+ *
+ * Opening hundreds of loose files is slow on spinning disks and SD cards.
+ * The archive packs them into one file that is memory mapped at startup.
+ * Files are looked up by a hash of their path and read through views that
+ * point straight into the mapping.
+ *
+ * Loose files always win over packed ones so mods and work in progress
+ * assets can be dropped into resources/ without repacking.
+ *
+ * Archive layout (little endian):
+ *
+ * | Header | Entry[entryCount] sorted by hash | path strings | 16 byte aligned blobs |
+ *
+ * Entries flagged as LZ4 hold a raw LZ4 block and are decompressed once on
+ * first use. The packer only compresses files that get smaller, which in
+ * practice means the text files (animations, shaders, configs).
+ *
+ * Build an archive with tools/Pack/pack.py
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <cstdint>
+
+/**
+ * @struct ArchiveView
+ * @brief Read-only bytes of a packed file. Valid for as long as the archive is mounted.
+ */
+struct ArchiveView {
+  const char* data;
+  std::size_t size;
+
+  ArchiveView() : data(nullptr), size(0) { }
+};
+
+class Archive {
+public:
+  /**
+   * @struct Header
+   * @brief First bytes of the archive file
+   */
+  struct Header {
+    char magic[4]; /*!< "OBNP" */
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t reserved;
+  };
+
+  /**
+   * @struct Entry
+   * @brief Index entry for one packed file
+   */
+  struct Entry {
+    std::uint64_t hash; /*!< FNV-1a hash of the path */
+    std::uint64_t offset; /*!< Start of the blob from the beginning of the archive */
+    std::uint64_t size; /*!< Size of the file */
+    std::uint64_t packedSize; /*!< Size of the blob. Same as size if not compressed. */
+    std::uint32_t pathOffset; /*!< Start of the path string from the beginning of the archive */
+    std::uint32_t pathLength; /*!< Length of the path string */
+    std::uint32_t flags; /*!< @see Flags */
+    std::uint32_t reserved;
+  };
+
+  enum Flags : std::uint32_t {
+    lz4 = 1 << 0
+  };
+
+  static const std::uint32_t VERSION = 1;
+
+  /**
+   * @brief If this is the first call, initializes the archive.
+   * @return Returns reference to the archive.
+   */
+  static Archive& GetInstance();
+
+  /**
+   * @brief Maps an archive file into memory
+   * @param path path to the archive
+   * @return true if the archive was mounted
+   */
+  bool Mount(const std::string& path);
+
+  /**
+   * @brief Unmaps the archive. All views become invalid.
+   */
+  void Unmount();
+
+  /**
+   * @brief Query if an archive is mounted
+   * @return true if mounted
+   */
+  const bool IsMounted() const;
+
+  /**
+   * @brief Find a packed file
+   * @param path path relative to the application e.g. resources/ui/alert.png
+   * @param view set to the file's bytes if found
+   * @return true if the file is packed
+   *
+   * Does not check for loose files. @see FileUtil
+   */
+  bool Find(const std::string& path, ArchiveView& view);
+
+  /**
+   * @brief Query the size of a packed file without decompressing it
+   * @param path
+   * @return size or 0 if the file is not packed
+   */
+  std::uint64_t GetSize(const std::string& path);
+
+  /**
+   * @brief Query the modified time of the archive file
+   * @return timestamp in the same units as FileUtil::GetModifiedTime()
+   */
+  const long long GetModifiedTime() const;
+
+  /**
+   * @brief Hash used for the index
+   * @param path
+   * @return 64-bit FNV-1a hash
+   */
+  static std::uint64_t Hash(const std::string& path);
+
+  /**
+   * @brief Decompress a raw LZ4 block
+   * @param src compressed bytes
+   * @param srcSize
+   * @param dst output buffer
+   * @param dstSize exact size of the decompressed data
+   * @return true if the block decoded to exactly dstSize bytes
+   */
+  static bool DecompressLZ4(const char* src, std::size_t srcSize, char* dst, std::size_t dstSize);
+
+private:
+  Archive();
+  ~Archive();
+
+  /**
+   * @brief Binary search the index
+   * @param path
+   * @return entry or nullptr if the file is not packed
+   */
+  const Entry* FindEntry(const std::string& path) const;
+
+  const char* data; /*!< Start of the mapping */
+  std::size_t size; /*!< Size of the mapping */
+  const Entry* entries; /*!< Index inside the mapping */
+  std::uint32_t entryCount;
+  long long modified; /*!< Modified time of the archive file */
+
+#if defined(_WIN32)
+  void* fileHandle;
+  void* mappingHandle;
+#elif defined(__ANDROID__)
+  std::vector<char> buffer; /*!< Assets live in the APK. The archive is read into memory. */
+#endif
+
+  std::mutex decompressMutex; /*!< Guards decompressed */
+  std::map<const Entry*, std::vector<char>> decompressed; /*!< Compressed files are kept after their first use */
+};
+
+/*! \brief Shorthand to get instance of the archive */
+#define ARCHIVE Archive::GetInstance()
@@ -0,0 +1,195 @@
+#include "bnAssetLoader.h"
+#include "bnLogger.h"
+
+#include <memory>
+#include <algorithm>
+
+AssetLoader& AssetLoader::GetInstance() {
+  static AssetLoader instance;
+  return instance;
+}
+
+AssetLoader::AssetLoader() : activeJobs(0), isRunning(false) {
+}
+
+AssetLoader::~AssetLoader() {
+  Stop();
+}
+
+void AssetLoader::Start(unsigned workers) {
+  if (isRunning) return;
+
+  if (workers == 0) {
+    unsigned cores = std::thread::hardware_concurrency();
+
+    // Leave a core for the main thread
+    workers = std::max(1u, cores > 1u ? cores - 1u : 1u);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(decodeMutex);
+    isRunning = true;
+  }
+
+  for (unsigned i = 0; i < workers; i++) {
+    this->workers.emplace_back(&AssetLoader::Work, this);
+  }
+
+  LOG_INFO(CORE, "Asset loader started with %i worker threads", (int)workers);
+}
+
+void AssetLoader::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(decodeMutex);
+    if (!isRunning) return;
+    isRunning = false;
+  }
+
+  decodeReady.notify_all();
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  workers.clear();
+
+  // Anything left over runs here
+  while (RunNextDecode());
+}
+
+void AssetLoader::Work() {
+  while (true) {
+    Job job;
+
+    {
+      std::unique_lock<std::mutex> lock(decodeMutex);
+      decodeReady.wait(lock, [this] { return !decodeJobs.empty() || !isRunning; });
+
+      if (decodeJobs.empty()) return; // Stopping
+
+      job = std::move(decodeJobs.front());
+      decodeJobs.pop_front();
+      activeJobs++;
+    }
+
+    job();
+
+    {
+      std::lock_guard<std::mutex> lock(decodeMutex);
+      activeJobs--;
+    }
+
+    decodeDone.notify_all();
+  }
+}
+
+bool AssetLoader::RunNextDecode() {
+  Job job;
+
+  {
+    std::lock_guard<std::mutex> lock(decodeMutex);
+
+    if (decodeJobs.empty()) return false;
+
+    job = std::move(decodeJobs.front());
+    decodeJobs.pop_front();
+    activeJobs++;
+  }
+
+  job();
+
+  {
+    std::lock_guard<std::mutex> lock(decodeMutex);
+    activeJobs--;
+  }
+
+  decodeDone.notify_all();
+
+  return true;
+}
+
+void AssetLoader::Decode(const Job& job) {
+  bool queued = false;
+
+  {
+    std::lock_guard<std::mutex> lock(decodeMutex);
+
+    if (isRunning) {
+      decodeJobs.push_back(job);
+      queued = true;
+    }
+  }
+
+  if (!queued) {
+    job();
+    return;
+  }
+
+  decodeReady.notify_one();
+}
+
+void AssetLoader::Upload(const Job& job) {
+  std::lock_guard<std::mutex> lock(uploadMutex);
+  uploadJobs.push_back(job);
+}
+
+void AssetLoader::ParallelFor(std::size_t count, const std::function<void(std::size_t)>& job) {
+  if (count == 0) return;
+
+  auto remaining = std::make_shared<std::atomic<std::size_t>>(count);
+
+  for (std::size_t i = 0; i < count; i++) {
+    Decode([job, i, remaining]() {
+      job(i);
+      (*remaining)--;
+    });
+  }
+
+  // Help out instead of sleeping. When the queue is empty, wait for the workers to finish our jobs.
+  while (*remaining > 0) {
+    if (RunNextDecode()) continue;
+
+    std::unique_lock<std::mutex> lock(decodeMutex);
+    decodeDone.wait(lock, [&remaining] { return *remaining == 0; });
+  }
+}
+
+void AssetLoader::Wait() {
+  while (RunNextDecode());
+
+  std::unique_lock<std::mutex> lock(decodeMutex);
+  decodeDone.wait(lock, [this] { return decodeJobs.empty() && activeJobs == 0; });
+}
+
+const unsigned AssetLoader::DrainUploads(sf::Time budget) {
+  sf::Clock clock;
+  unsigned count = 0;
+
+  do {
+    Job job;
+
+    {
+      std::lock_guard<std::mutex> lock(uploadMutex);
+
+      if (uploadJobs.empty()) break;
+
+      job = std::move(uploadJobs.front());
+      uploadJobs.pop_front();
+    }
+
+    job();
+    count++;
+  } while (clock.getElapsedTime() < budget);
+
+  return count;
+}
+
+const bool AssetLoader::IsBusy() {
+  {
+    std::lock_guard<std::mutex> lock(decodeMutex);
+    if (!decodeJobs.empty() || activeJobs > 0) return true;
+  }
+
+  std::lock_guard<std::mutex> lock(uploadMutex);
+  return !uploadJobs.empty();
+}
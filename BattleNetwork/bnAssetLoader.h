@@ -0,0 +1,113 @@
+/*! \file bnAssetLoader.h */
+
+/*! \brief Singleton thread pool for decoding assets in parallel
+ *
+ * Decoding files (PNG, OGG, atlas pages) does not need the GL context and
+ * is spread across worker threads with Decode().
+ *
+ * Anything that touches the GL context (creating textures, compiling shaders)
+ * is queued with Upload() and run on the main thread by DrainUploads(),
+ * which should be called once per frame while assets are loading.
+ */
+
+#pragma once
+#include <SFML/System.hpp>
+#include <functional>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+class AssetLoader {
+public:
+  typedef std::function<void()> Job;
+
+  /**
+   * @brief If this is the first call, initializes the loader.
+   * @return Returns reference to the asset loader.
+   */
+  static AssetLoader& GetInstance();
+
+  /**
+   * @brief Starts the worker threads
+   * @param workers number of threads. 0 uses one less than the number of cores.
+   */
+  void Start(unsigned workers = 0);
+
+  /**
+   * @brief Finishes queued decode jobs and joins the worker threads
+   */
+  void Stop();
+
+  /**
+   * @brief Queue a job to run on a worker thread
+   * @param job must not use the GL context
+   *
+   * If the loader has not been started the job runs immediately on the calling thread
+   */
+  void Decode(const Job& job);
+
+  /**
+   * @brief Queue a job to run on the main thread in DrainUploads()
+   * @param job
+   */
+  void Upload(const Job& job);
+
+  /**
+   * @brief Runs job(0) through job(count - 1) on the workers and blocks until they have all finished
+   * @param count number of jobs
+   * @param job must not use the GL context
+   *
+   * The calling thread runs queued decode jobs while it waits so this is safe to call from inside a job
+   */
+  void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& job);
+
+  /**
+   * @brief Blocks until every queued decode job has finished
+   * @warning Do not call from inside a decode job. Use ParallelFor() instead.
+   */
+  void Wait();
+
+  /**
+   * @brief Runs queued upload jobs on the calling thread
+   * @param budget stop after this much time has passed. At least one job always runs.
+   * @return number of jobs that ran
+   */
+  const unsigned DrainUploads(sf::Time budget);
+
+  /**
+   * @brief Query if any decode or upload jobs are queued or running
+   * @return true if busy
+   */
+  const bool IsBusy();
+
+private:
+  AssetLoader();
+  ~AssetLoader();
+
+  /**
+   * @brief Worker thread loop
+   */
+  void Work();
+
+  /**
+   * @brief Pops and runs one decode job if there is one
+   * @return true if a job ran
+   */
+  bool RunNextDecode();
+
+  std::vector<std::thread> workers; /*!< Decoding threads */
+  std::deque<Job> decodeJobs; /*!< Jobs for the workers */
+  std::deque<Job> uploadJobs; /*!< Jobs for the main thread */
+  std::mutex decodeMutex; /*!< Guards decodeJobs */
+  std::mutex uploadMutex; /*!< Guards uploadJobs */
+  std::condition_variable decodeReady; /*!< Wakes workers when there is a job or we are stopping */
+  std::condition_variable decodeDone; /*!< Wakes Wait() when a job finishes */
+  std::atomic<int> activeJobs; /*!< Decode jobs currently running */
+  bool isRunning; /*!< False when the workers should exit */
+};
+
+/*! \brief Shorthand to get instance of the loader */
+#define LOADER AssetLoader::GetInstance()
@@ -0,0 +1,35 @@
+#include "bnAssetPrefetch.h"
+#include "bnAssetLoader.h"
+
+void AssetPrefetch::Request(const std::vector<TextureType>& textures, const std::vector<std::string>& animations)
+{
+  auto result = std::make_shared<Result>();
+  current = result;
+
+  LOADER.Decode([result, textures, animations]() {
+    // Only this job holds the result. A newer request replaced it before it started.
+    if (result.use_count() == 1) return;
+
+    for (auto& path : animations) {
+      result->animations.push_back(ANIMATIONS.Load(path));
+    }
+
+    auto decoded = std::make_shared<std::vector<TextureResourceManager::DecodedTexture>>(TEXTURES.Decode(textures));
+
+    // Textures can only be created on the main thread
+    LOADER.Upload([result, decoded]() {
+      result->textures = TEXTURES.Upload(*decoded);
+      result->ready = true;
+    });
+  });
+}
+
+void AssetPrefetch::Clear()
+{
+  current.reset();
+}
+
+const bool AssetPrefetch::IsReady() const
+{
+  return !current || current->ready;
+}
@@ -0,0 +1,56 @@
+/*! \file bnAssetPrefetch.h */
+
+/*! \brief Loads the assets of whatever the player is looking at in the background
+ *
+ * Select screens call Request() when the highlight moves. The textures and
+ * animation files are decoded on the asset loader, the textures are created
+ * by the main thread in an upload job, and everything is kept until the next
+ * Request(), so confirming the selection finds everything already cached.
+ *
+ * A newer request replaces the old one. If the old one has not started yet
+ * it is skipped, so scrolling through a long list does not queue every entry.
+ */
+#pragma once
+#include "bnTextureResourceManager.h"
+#include "bnAnimationCache.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+
+class AssetPrefetch {
+public:
+  AssetPrefetch() = default;
+
+  /**
+   * @brief Load assets in the background and keep them until the next request
+   * @param textures texture types to load
+   * @param animations animation file paths to load
+   */
+  void Request(const std::vector<TextureType>& textures, const std::vector<std::string>& animations);
+
+  /**
+   * @brief Drop the assets kept by the last request
+   */
+  void Clear();
+
+  /**
+   * @brief Query if the last request has finished loading
+   * @return true if loaded or nothing was requested
+   */
+  const bool IsReady() const;
+
+private:
+  /**
+   * @struct Result
+   * @brief Handles that keep one request's assets loaded
+   */
+  struct Result {
+    std::vector<TextureHandle> textures;
+    std::vector<SharedFrameLists> animations;
+    std::atomic<bool> ready{ false };
+  };
+
+  std::shared_ptr<Result> current; /*!< Last request. Only the main thread touches this pointer. */
+};
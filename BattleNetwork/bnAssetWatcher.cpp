@@ -0,0 +1,176 @@
+#include "bnAssetWatcher.h"
+#include "bnLogger.h"
+
+#include <filesystem>
+
+#ifdef BN_ASSET_WATCHER_INOTIFY
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+AssetWatcher& AssetWatcher::GetInstance() {
+  static AssetWatcher instance;
+  return instance;
+}
+
+AssetWatcher::AssetWatcher() : isRunning(false) {
+#ifdef BN_ASSET_WATCHER_INOTIFY
+  fd = -1;
+#endif
+}
+
+AssetWatcher::~AssetWatcher() {
+  Stop();
+}
+
+bool AssetWatcher::Start(const std::string& root) {
+  if (isRunning) return true;
+
+#ifdef BN_ASSET_WATCHER_INOTIFY
+  std::error_code ec;
+
+  if (!std::filesystem::is_directory(root, ec)) {
+    LOG_WARN(CONTENT, "Hot reload: %s is not a folder", root.c_str());
+    return false;
+  }
+
+  fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+  if (fd < 0) {
+    LOG_WARN(CONTENT, "Hot reload: inotify_init1 failed (errno %i)", errno);
+    return false;
+  }
+
+  AddDirectory(root);
+
+  isRunning = true;
+  thread = std::thread(&AssetWatcher::Run, this);
+
+  LOG_INFO(CONTENT, "Hot reload: watching %i folders under %s", (int)directories.size(), root.c_str());
+  return true;
+#else
+  LOG_WARN(CONTENT, "Hot reload is not supported on this platform");
+  return false;
+#endif
+}
+
+void AssetWatcher::Stop() {
+  if (!isRunning) return;
+
+  isRunning = false;
+
+  if (thread.joinable()) {
+    thread.join();
+  }
+
+#ifdef BN_ASSET_WATCHER_INOTIFY
+  close(fd);
+  fd = -1;
+  directories.clear();
+#endif
+}
+
+void AssetWatcher::Watch(const std::string& match, const Handler& handler) {
+  handlers.push_back(std::make_pair(match, handler));
+}
+
+const unsigned AssetWatcher::Poll() {
+  std::set<std::string> files;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (changed.empty()) return 0;
+    files.swap(changed);
+  }
+
+  unsigned count = 0;
+
+  for (auto& path : files) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    bool handled = false;
+
+    for (auto& handler : handlers) {
+      if (handler.first == path || handler.first == extension) {
+        handler.second(path);
+        handled = true;
+      }
+    }
+
+    if (handled) {
+      LOG_INFO(CONTENT, "Hot reload: %s", path.c_str());
+      count++;
+    }
+  }
+
+  return count;
+}
+
+const bool AssetWatcher::IsRunning() const {
+  return isRunning;
+}
+
+void AssetWatcher::AddDirectory(const std::string& path) {
+#ifdef BN_ASSET_WATCHER_INOTIFY
+  // Editors often save by writing a temp file and renaming it over the original
+  const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+  int wd = inotify_add_watch(fd, path.c_str(), mask);
+
+  if (wd >= 0) {
+    directories[wd] = path;
+  }
+
+  std::error_code ec;
+
+  for (auto& entry : std::filesystem::directory_iterator(path, ec)) {
+    if (entry.is_directory(ec)) {
+      AddDirectory(entry.path().generic_string());
+    }
+  }
+#endif
+}
+
+void AssetWatcher::Run() {
+#ifdef BN_ASSET_WATCHER_INOTIFY
+  // Large enough for many events. Each event is followed by its file name.
+  alignas(inotify_event) char buffer[16 * 1024];
+
+  pollfd pfd;
+  pfd.fd = fd;
+  pfd.events = POLLIN;
+
+  while (isRunning) {
+    // Wake up regularly to see if we should stop
+    if (poll(&pfd, 1, 100) <= 0) continue;
+
+    ssize_t length = read(fd, buffer, sizeof(buffer));
+
+    for (ssize_t i = 0; i < length;) {
+      const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + i);
+      i += sizeof(inotify_event) + event->len;
+
+      auto dir = directories.find(event->wd);
+      if (dir == directories.end() || event->len == 0) continue;
+
+      std::string path = dir->second + "/" + event->name;
+
+      if (event->mask & IN_ISDIR) {
+        // New folders are watched too
+        if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+          AddDirectory(path);
+        }
+
+        continue;
+      }
+
+      // IN_CREATE is only for folders. The file is reloaded when it is closed.
+      if (!(event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))) continue;
+
+      std::lock_guard<std::mutex> lock(mutex);
+      changed.insert(path);
+    }
+  }
+#endif
+}
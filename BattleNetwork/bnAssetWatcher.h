@@ -0,0 +1,102 @@
+/*! \file bnAssetWatcher.h */
+
+/*! \brief Singleton that watches the resources folder and reloads assets when they change
+ *
+ * Content is iterated on without restarting the game. A background thread waits
+ * on the OS for files under the watched folder to be written. Changed paths are
+ * queued and Poll() hands them to the registered handlers on the main thread,
+ * where the resource managers can re-parse or re-upload just that one asset.
+ *
+ * Only Linux (inotify) is supported. On other platforms Start() returns false
+ * and the watcher does nothing.
+ *
+ * Paths are reported relative to the application like the rest of the resource
+ * managers e.g. "resources/ui/mouse.animation"
+ */
+#pragma once
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#define BN_ASSET_WATCHER_INOTIFY
+#endif
+
+class AssetWatcher {
+public:
+  typedef std::function<void(const std::string&)> Handler;
+
+  /**
+   * @brief If this is the first call, initializes the watcher.
+   * @return Returns reference to the watcher.
+   */
+  static AssetWatcher& GetInstance();
+
+  /**
+   * @brief Watch a folder and every folder under it
+   * @param root relative path to the folder e.g. "resources"
+   * @return false if file watching is not supported or the folder could not be watched
+   */
+  bool Start(const std::string& root);
+
+  /**
+   * @brief Stops and joins the watcher thread
+   */
+  void Stop();
+
+  /**
+   * @brief Call a handler when a matching file changes
+   * @param match file extension including the dot e.g. ".png", or an exact path
+   * @param handler called on the thread that calls Poll() with the changed path
+   */
+  void Watch(const std::string& match, const Handler& handler);
+
+  /**
+   * @brief Runs the handlers for every file that changed since the last call
+   * @return number of files reloaded
+   *
+   * Call once per frame from the main thread. Files saved several times in a
+   * row are only reloaded once.
+   */
+  const unsigned Poll();
+
+  /**
+   * @brief Query if the watcher thread is running
+   * @return true if running
+   */
+  const bool IsRunning() const;
+
+private:
+  AssetWatcher();
+  ~AssetWatcher();
+
+  /**
+   * @brief Watcher thread loop. Queues changed paths until Stop() is called.
+   */
+  void Run();
+
+  /**
+   * @brief Watch a folder and the folders under it
+   * @param path relative path to the folder
+   */
+  void AddDirectory(const std::string& path);
+
+  std::thread thread; /*!< Waits for file events */
+  std::atomic<bool> isRunning; /*!< False when the thread should exit */
+  std::mutex mutex; /*!< Guards changed */
+  std::set<std::string> changed; /*!< Files written since the last Poll() */
+  std::vector<std::pair<std::string, Handler>> handlers; /*!< Match and handler pairs in the order they were added */
+
+#ifdef BN_ASSET_WATCHER_INOTIFY
+  int fd; /*!< inotify instance */
+  std::map<int, std::string> directories; /*!< Watch descriptor to folder path */
+#endif
+};
+
+/*! \brief Shorthand to get instance of the watcher */
+#define WATCHER AssetWatcher::GetInstance()
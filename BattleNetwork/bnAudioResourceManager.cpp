@@ -1,5 +1,10 @@
 #include "bnAudioResourceManager.h"
 #include "bnLogger.h"
+#include "bnAssetLoader.h"
+#include "bnFileUtil.h"
+
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <algorithm>
 
 AudioResourceManager& AudioResourceManager::GetInstance() {
   static AudioResourceManager instance;
@@ -13,14 +18,47 @@ AudioResourceManager::AudioResourceManager() {
 
   for (int i = 0; i < NUM_OF_CHANNELS; i++) {
     channels[i].buffer = sf::Sound();
+    channels[i].priority = AudioPriority::LOWEST;
+    channels[i].type = -1;
+    channels[i].prev = channels[i].next = -1;
+  }
+
+  // Pop from the back so channel 0 is used first
+  for (int i = NUM_OF_CHANNELS - 1; i >= 0; i--) {
+    freeChannels.push_back(i);
+  }
+
+  for (int i = 0; i < PRIORITY_COUNT; i++) {
+    busyHead[i] = busyTail[i] = -1;
+  }
+
+  lastPlayed.resize(AudioType::AUDIO_TYPE_SIZE, -1);
+  voiceCount.resize(AudioType::AUDIO_TYPE_SIZE, 0);
+  queued.resize(AudioType::AUDIO_TYPE_SIZE, -1);
+  requests.reserve(AudioType::AUDIO_TYPE_SIZE);
+  voicesPerFrame = AUDIO_NEW_VOICES_PER_FRAME;
+
+  streamChannels = new AudioResourceManager::StreamChannel[NUM_OF_STREAM_CHANNELS];
+
+  for (int i = 0; i < NUM_OF_STREAM_CHANNELS; i++) {
+    streamChannels[i].priority = AudioPriority::LOWEST;
+    streamChannels[i].type = -1;
   }
 
-  sources = new sf::SoundBuffer[AudioType::AUDIO_TYPE_SIZE];
+  sources.resize(AudioType::AUDIO_TYPE_SIZE);
 
-  for (int i = 0; i < AUDIO_TYPE_SIZE; i++) {
-    sources[i] = sf::SoundBuffer();
+  for (auto& source : sources) {
+    source.bytes = 0;
+    source.lastUsed = 0;
+    source.probed = false;
+    source.streamed = false;
   }
 
+  useCounter = 0;
+  residentBytes = 0;
+  budget = AUDIO_SAMPLE_BUDGET_BYTES;
+  decodeCount = evictCount = 0;
+
   channelVolume = streamVolume = 100; //SFML default
 }
 
@@ -33,9 +71,13 @@ AudioResourceManager::~AudioResourceManager() {
     channels[i].buffer.stop();
   }
 
-  // Free memory
+  for (int i = 0; i < NUM_OF_STREAM_CHANNELS; i++) {
+    streamChannels[i].music.stop();
+  }
+
+  // Free memory. Channels go first so no sound is left pointing at a sample.
   delete[] channels;
-  delete[] sources;
+  delete[] streamChannels;
 }
 
 void AudioResourceManager::EnableAudio(bool status) {
@@ -55,66 +97,257 @@ void AudioResourceManager::EnableAudio(bool status) {
 }
 
 void AudioResourceManager::LoadAllSources(std::atomic<int> &status) {
-  LoadSource(AudioType::APPEAR, "resources/sfx/appear.ogg"); status++;
-  LoadSource(AudioType::AREA_GRAB, "resources/sfx/area_grab.ogg"); status++;
-  LoadSource(AudioType::AREA_GRAB_TOUCHDOWN, "resources/sfx/area_grab_touchdown.ogg"); status++;
-  LoadSource(AudioType::BUSTER_PEA, "resources/sfx/pew.ogg"); status++;
-  LoadSource(AudioType::BUSTER_CHARGED, "resources/sfx/buster_charged.ogg"); status++;
-  LoadSource(AudioType::BUSTER_CHARGING, "resources/sfx/buster_charging.ogg"); status++;
-  LoadSource(AudioType::BUBBLE_POP, "resources/sfx/bubble_pop.ogg"); status++;
-  LoadSource(AudioType::BUBBLE_SPAWN, "resources/sfx/bubble_spawn.ogg"); status++;
-  LoadSource(AudioType::GUARD_HIT, "resources/sfx/guard_hit.ogg"); status++;
-  LoadSource(AudioType::CANNON, "resources/sfx/cannon.ogg"); status++;
-  LoadSource(AudioType::COUNTER, "resources/sfx/counter.ogg"); status++;
-  LoadSource(AudioType::WIND, "resources/sfx/wind.ogg"); status++;
-  LoadSource(AudioType::CHIP_CANCEL, "resources/sfx/chip_cancel.ogg"); status++;
-  LoadSource(AudioType::CHIP_CHOOSE, "resources/sfx/chip_choose.ogg"); status++;
-  LoadSource(AudioType::CHIP_CONFIRM, "resources/sfx/chip_confirm.ogg"); status++;
-  LoadSource(AudioType::CHIP_DESC, "resources/sfx/chip_desc.ogg"); status++;
-  LoadSource(AudioType::CHIP_DESC_CLOSE, "resources/sfx/chip_desc_close.ogg"); status++;
-  LoadSource(AudioType::CHIP_SELECT, "resources/sfx/chip_select.ogg"); status++;
-  LoadSource(AudioType::CHIP_ERROR, "resources/sfx/chip_error.ogg"); status++;
-  LoadSource(AudioType::CUSTOM_BAR_FULL, "resources/sfx/custom_bar_full.ogg"); status++;
-  LoadSource(AudioType::CUSTOM_SCREEN_OPEN, "resources/sfx/chip_screen_open.ogg"); status++;
-  LoadSource(AudioType::ITEM_GET, "resources/sfx/item_get.ogg"); status++;
-  LoadSource(AudioType::DELETED, "resources/sfx/deleted.ogg"); status++;
-  LoadSource(AudioType::EXPLODE, "resources/sfx/explode_once.ogg"); status++;
-  LoadSource(AudioType::GUN, "resources/sfx/gun.ogg"); status++;
-  LoadSource(AudioType::HURT, "resources/sfx/hurt.ogg"); status++;
-  LoadSource(AudioType::PANEL_CRACK, "resources/sfx/panel_crack.ogg"); status++;
-  LoadSource(AudioType::PANEL_RETURN, "resources/sfx/panel_return.ogg"); status++;
-  LoadSource(AudioType::PAUSE, "resources/sfx/pause.ogg"); status++;
-  LoadSource(AudioType::PRE_BATTLE, "resources/sfx/pre_battle.ogg"); status++;
-  LoadSource(AudioType::RECOVER, "resources/sfx/recover.ogg"); status++;
-  LoadSource(AudioType::SPREADER, "resources/sfx/spreader.ogg"); status++;
-  LoadSource(AudioType::SWORD_SWING, "resources/sfx/sword_swing.ogg"); status++;
-  LoadSource(AudioType::TOSS_ITEM, "resources/sfx/toss_item.ogg"); status++;
-  LoadSource(AudioType::TOSS_ITEM_LITE, "resources/sfx/toss_item_lite.ogg"); status++;
-  LoadSource(AudioType::WAVE, "resources/sfx/wave.ogg"); status++;
-  LoadSource(AudioType::THUNDER, "resources/sfx/thunder.ogg"); status++;
-  LoadSource(AudioType::ELECPULSE, "resources/sfx/elecpulse.ogg"); status++;
-  LoadSource(AudioType::INVISIBLE, "resources/sfx/invisible.ogg"); status++;
-  LoadSource(AudioType::PA_ADVANCE, "resources/sfx/pa_advance.ogg"); status++;
-  LoadSource(AudioType::LOW_HP, "resources/sfx/low_hp.ogg"); status++;
-  LoadSource(AudioType::POINT, "resources/sfx/point.ogg"); status++;
-  LoadSource(AudioType::NEW_GAME, "resources/sfx/new_game.ogg"); status++;
-  LoadSource(AudioType::TEXT, "resources/sfx/text.ogg"); status++;
-  LoadSource(AudioType::SHINE, "resources/sfx/shine.ogg"); status++;
+  sf::Clock clock;
+
+  LoadSource(AudioType::APPEAR, "resources/sfx/appear.ogg", status);
+  LoadSource(AudioType::AREA_GRAB, "resources/sfx/area_grab.ogg", status);
+  LoadSource(AudioType::AREA_GRAB_TOUCHDOWN, "resources/sfx/area_grab_touchdown.ogg", status);
+  LoadSource(AudioType::BUSTER_PEA, "resources/sfx/pew.ogg", status);
+  LoadSource(AudioType::BUSTER_CHARGED, "resources/sfx/buster_charged.ogg", status);
+  LoadSource(AudioType::BUSTER_CHARGING, "resources/sfx/buster_charging.ogg", status);
+  LoadSource(AudioType::BUBBLE_POP, "resources/sfx/bubble_pop.ogg", status);
+  LoadSource(AudioType::BUBBLE_SPAWN, "resources/sfx/bubble_spawn.ogg", status);
+  LoadSource(AudioType::GUARD_HIT, "resources/sfx/guard_hit.ogg", status);
+  LoadSource(AudioType::CANNON, "resources/sfx/cannon.ogg", status);
+  LoadSource(AudioType::COUNTER, "resources/sfx/counter.ogg", status);
+  LoadSource(AudioType::WIND, "resources/sfx/wind.ogg", status);
+  LoadSource(AudioType::CHIP_CANCEL, "resources/sfx/chip_cancel.ogg", status);
+  LoadSource(AudioType::CHIP_CHOOSE, "resources/sfx/chip_choose.ogg", status);
+  LoadSource(AudioType::CHIP_CONFIRM, "resources/sfx/chip_confirm.ogg", status);
+  LoadSource(AudioType::CHIP_DESC, "resources/sfx/chip_desc.ogg", status);
+  LoadSource(AudioType::CHIP_DESC_CLOSE, "resources/sfx/chip_desc_close.ogg", status);
+  LoadSource(AudioType::CHIP_SELECT, "resources/sfx/chip_select.ogg", status);
+  LoadSource(AudioType::CHIP_ERROR, "resources/sfx/chip_error.ogg", status);
+  LoadSource(AudioType::CUSTOM_BAR_FULL, "resources/sfx/custom_bar_full.ogg", status);
+  LoadSource(AudioType::CUSTOM_SCREEN_OPEN, "resources/sfx/chip_screen_open.ogg", status);
+  LoadSource(AudioType::ITEM_GET, "resources/sfx/item_get.ogg", status);
+  LoadSource(AudioType::DELETED, "resources/sfx/deleted.ogg", status);
+  LoadSource(AudioType::EXPLODE, "resources/sfx/explode_once.ogg", status);
+  LoadSource(AudioType::GUN, "resources/sfx/gun.ogg", status);
+  LoadSource(AudioType::HURT, "resources/sfx/hurt.ogg", status);
+  LoadSource(AudioType::PANEL_CRACK, "resources/sfx/panel_crack.ogg", status);
+  LoadSource(AudioType::PANEL_RETURN, "resources/sfx/panel_return.ogg", status);
+  LoadSource(AudioType::PAUSE, "resources/sfx/pause.ogg", status);
+  LoadSource(AudioType::PRE_BATTLE, "resources/sfx/pre_battle.ogg", status);
+  LoadSource(AudioType::RECOVER, "resources/sfx/recover.ogg", status);
+  LoadSource(AudioType::SPREADER, "resources/sfx/spreader.ogg", status);
+  LoadSource(AudioType::SWORD_SWING, "resources/sfx/sword_swing.ogg", status);
+  LoadSource(AudioType::TOSS_ITEM, "resources/sfx/toss_item.ogg", status);
+  LoadSource(AudioType::TOSS_ITEM_LITE, "resources/sfx/toss_item_lite.ogg", status);
+  LoadSource(AudioType::WAVE, "resources/sfx/wave.ogg", status);
+  LoadSource(AudioType::THUNDER, "resources/sfx/thunder.ogg", status);
+  LoadSource(AudioType::ELECPULSE, "resources/sfx/elecpulse.ogg", status);
+  LoadSource(AudioType::INVISIBLE, "resources/sfx/invisible.ogg", status);
+  LoadSource(AudioType::PA_ADVANCE, "resources/sfx/pa_advance.ogg", status);
+  LoadSource(AudioType::LOW_HP, "resources/sfx/low_hp.ogg", status);
+  LoadSource(AudioType::POINT, "resources/sfx/point.ogg", status);
+  LoadSource(AudioType::NEW_GAME, "resources/sfx/new_game.ogg", status);
+  LoadSource(AudioType::TEXT, "resources/sfx/text.ogg", status);
+  LoadSource(AudioType::SHINE, "resources/sfx/shine.ogg", status);
+
+  registerTime = clock.getElapsedTime();
+}
+
+void AudioResourceManager::LoadSource(AudioType type, const std::string& path, std::atomic<int>& status) {
+  LoadSource(type, path);
+  status++;
 }
 
 void AudioResourceManager::LoadSource(AudioType type, const std::string& path) {
-  if (!sources[type].loadFromFile(path)) {
+  std::lock_guard<std::mutex> lock(audioMutex);
 
-    Logger::GetMutex()->lock();
-    Logger::Logf("Failed loading audio: %s\n", path.c_str());
-    Logger::GetMutex()->unlock();
+  Source& source = sources[type];
 
-  } else {
+  // Registering a new path drops the old sample once nothing is playing it
+  if (source.buffer) {
+    residentBytes -= source.bytes;
+  }
+
+  source.path = path;
+  source.buffer = nullptr;
+  source.bytes = 0;
+  source.probed = false;
+  source.streamed = false;
+}
+
+AudioHandle AudioResourceManager::Decode(const std::string& path) {
+  AudioHandle buffer = std::make_shared<sf::SoundBuffer>();
+
+  if (!FileUtil::LoadResource(*buffer, path)) {
+
+    LOG_ERROR(SOUND, "Failed loading audio: %s", path.c_str());
+
+    return nullptr;
+  }
+
+  LOG_DEBUG(SOUND, "Loaded audio: %s", path.c_str());
 
-    Logger::GetMutex()->lock();
-    Logger::Logf("Loaded audio: %s", path.c_str());
-    Logger::GetMutex()->unlock();
+  return buffer;
+}
+
+void AudioResourceManager::Probe(Source& source) {
+  if (source.probed) return;
+
+  source.probed = true;
+
+  // Only the header is read. This is much cheaper than decoding.
+  sf::InputSoundFile file;
+  ArchiveView packed;
+
+  bool opened = FileUtil::IsPacked(source.path, packed) ? file.openFromMemory(packed.data, packed.size) : file.openFromFile(source.path);
+
+  if (opened && file.getDuration().asSeconds() > AUDIO_STREAM_SAMPLES_LONGER_THAN_SECONDS) {
+    source.streamed = true;
+
+    LOG_DEBUG(SOUND, "Streaming audio: %s (%f secs)", source.path.c_str(), file.getDuration().asSeconds());
+  }
+}
+
+void AudioResourceManager::Install(Source& source, const AudioHandle& buffer, sf::Time elapsed) {
+  decodeTime += elapsed;
+
+  if (!buffer) return;
+
+  decodeCount++;
+
+  source.buffer = buffer;
+  source.bytes = static_cast<std::size_t>(buffer->getSampleCount()) * sizeof(sf::Int16);
+  residentBytes += source.bytes;
+}
+
+AudioHandle AudioResourceManager::Acquire(AudioType type) {
+  Source& source = sources[type];
+
+  Probe(source);
+
+  if (source.streamed) return nullptr;
+
+  if (!source.buffer) {
+    sf::Clock clock;
+    AudioHandle buffer = Decode(source.path);
+    Install(source, buffer, clock.getElapsedTime());
   }
+
+  source.lastUsed = ++useCounter;
+
+  // The sample we just asked for is the most recent and is never evicted here
+  Evict();
+
+  return source.buffer;
+}
+
+void AudioResourceManager::Evict() {
+  // Channels let go of their samples when Update() sees them finish
+  while (residentBytes > budget) {
+    Source* oldest = nullptr;
+
+    for (auto& source : sources) {
+      // Only the manager holds a reference. Nothing is playing it.
+      bool unused = source.buffer && source.buffer.use_count() == 1 && source.lastUsed != useCounter;
+
+      if (unused && (!oldest || source.lastUsed < oldest->lastUsed)) {
+        oldest = &source;
+      }
+    }
+
+    // Everything left is in use
+    if (!oldest) return;
+
+    LOG_DEBUG(SOUND, "Evicted audio: %s", oldest->path.c_str());
+
+    residentBytes -= oldest->bytes;
+    oldest->buffer = nullptr;
+    oldest->bytes = 0;
+    evictCount++;
+  }
+}
+
+AudioHandle AudioResourceManager::LoadSample(AudioType type) {
+  if (type < AudioType(0) || type >= AudioType::AUDIO_TYPE_SIZE) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(audioMutex);
+  return Acquire(type);
+}
+
+std::vector<AudioHandle> AudioResourceManager::Prefetch(const std::vector<AudioType>& types) {
+  std::vector<AudioType> missing;
+  std::vector<std::string> paths;
+
+  {
+    std::lock_guard<std::mutex> lock(audioMutex);
+
+    for (auto type : types) {
+      Source& source = sources[type];
+      Probe(source);
+
+      if (!source.streamed && !source.buffer && std::find(missing.begin(), missing.end(), type) == missing.end()) {
+        missing.push_back(type);
+        paths.push_back(source.path);
+      }
+    }
+  }
+
+  // Decode everything that is missing at once
+  std::vector<AudioHandle> decoded(missing.size());
+  std::vector<sf::Time> elapsed(missing.size());
+
+  LOADER.ParallelFor(missing.size(), [&decoded, &elapsed, &paths](std::size_t i) {
+    sf::Clock clock;
+    decoded[i] = Decode(paths[i]);
+    elapsed[i] = clock.getElapsedTime();
+  });
+
+  std::vector<AudioHandle> handles;
+  handles.reserve(types.size());
+
+  std::lock_guard<std::mutex> lock(audioMutex);
+
+  for (std::size_t i = 0; i < missing.size(); i++) {
+    Source& source = sources[missing[i]];
+
+    // Another caller may have loaded it while we decoded
+    if (!source.buffer) {
+      Install(source, decoded[i], elapsed[i]);
+    }
+  }
+
+  for (auto type : types) {
+    AudioHandle handle = Acquire(type);
+
+    if (handle) {
+      handles.push_back(handle);
+    }
+  }
+
+  return handles;
+}
+
+void AudioResourceManager::SetBudget(std::size_t bytes) {
+  std::lock_guard<std::mutex> lock(audioMutex);
+  budget = bytes;
+  Evict();
+}
+
+const std::size_t AudioResourceManager::GetResidentSize() {
+  std::lock_guard<std::mutex> lock(audioMutex);
+  return residentBytes;
+}
+
+void AudioResourceManager::LogReport() {
+  std::lock_guard<std::mutex> lock(audioMutex);
+
+  unsigned resident = 0, streamed = 0;
+
+  for (auto& source : sources) {
+    if (source.buffer) resident++;
+    if (source.streamed) streamed++;
+  }
+
+  LOG_INFO(SOUND, "Audio: %i samples registered in %f secs. %i decoded in %f secs. %i resident using %f of %f MB. %i streamed. %i evicted.",
+    (int)sources.size(), registerTime.asSeconds(), (int)decodeCount, decodeTime.asSeconds(), (int)resident,
+    residentBytes / (1024.f * 1024.f), budget / (1024.f * 1024.f), (int)streamed, (int)evictCount);
 }
 
 int AudioResourceManager::Play(AudioType type, AudioPriority priority) {
@@ -124,80 +357,244 @@ int AudioResourceManager::Play(AudioType type, AudioPriority priority) {
     return -1;
   }
 
+  // Already waiting for this frame's Update(). Play it once with the most important priority asked for.
+  if (queued[type] != -1) {
+    Request& request = requests[queued[type]];
+
+    if (priority > request.priority) {
+      request.priority = priority;
+      return 0;
+    }
+
+    return -1;
+  }
+
   // Annoying sound check. Make sure duplicate sounds are played only by a given amount of offset from the last time it was played.
   // This prevents amplitude stacking when duplicate sounds are played on the same frame...
-  // NOTE: an audio queue would be a better place for this check. Then play() those sounds that pass the queue filter.
+  sf::Int64 now = mixerClock.getElapsedTime().asMicroseconds();
+
   if (priority != AudioPriority::HIGH) {
-    for (int i = 0; i < NUM_OF_CHANNELS; i++) {
-      if (channels[i].buffer.getBuffer() == &sources[type] && channels[i].buffer.getStatus() == sf::SoundSource::Status::Playing) {
-        auto howLongPlayed = channels[i].buffer.getPlayingOffset().asMilliseconds();
-        if (howLongPlayed <= AUDIO_DUPLICATES_ALLOWED_IN_X_MILLISECONDS) {
-          return -1;
-        }
+    if (lastPlayed[type] >= 0 && now - lastPlayed[type] <= AUDIO_DUPLICATES_ALLOWED_IN_X_MILLISECONDS * 1000) {
+      return -1;
+    }
+  }
+
+  queued[type] = static_cast<int>(requests.size());
+  requests.push_back(Request{ type, priority });
+
+  return 0;
+}
+
+void AudioResourceManager::Update() {
+  // Free the channels that finished since the last frame
+  for (int p = 0; p < PRIORITY_COUNT; p++) {
+    for (int i = busyHead[p]; i != -1;) {
+      int next = channels[i].next;
+
+      if (channels[i].buffer.getStatus() != sf::SoundSource::Status::Playing) {
+        Unlink(i);
+        channels[i].buffer.resetBuffer();
+        channels[i].source = nullptr;
+        freeChannels.push_back(i);
       }
+
+      i = next;
+    }
+  }
+
+  if (requests.empty()) return;
+
+  // If there are more requests than the frame allows, the most important ones win
+  std::stable_sort(requests.begin(), requests.end(), [](const Request& a, const Request& b) {
+    return a.priority > b.priority;
+  });
+
+  unsigned started = 0;
+
+  for (auto& request : requests) {
+    queued[request.type] = -1;
+
+    if (started >= voicesPerFrame) continue;
+
+    if (Start(request.type, request.priority) == 0) {
+      started++;
+
+      // Requests that were dropped do not hold back the next one
+      lastPlayed[request.type] = mixerClock.getElapsedTime().asMicroseconds();
     }
   }
 
+  requests.clear();
+}
+
+void AudioResourceManager::SetVoicesPerFrame(unsigned count) {
+  voicesPerFrame = std::max(1u, count);
+}
+
+void AudioResourceManager::Unlink(int index) {
+  Channel& channel = channels[index];
+  int p = static_cast<int>(channel.priority);
+
+  if (channel.prev != -1) channels[channel.prev].next = channel.next;
+  else busyHead[p] = channel.next;
+
+  if (channel.next != -1) channels[channel.next].prev = channel.prev;
+  else busyTail[p] = channel.prev;
+
+  channel.prev = channel.next = -1;
+
+  if (channel.type != -1) {
+    voiceCount[channel.type]--;
+    channel.type = -1;
+  }
+}
+
+int AudioResourceManager::FindStealable(AudioPriority below, int type) {
+  for (int p = 0; p < static_cast<int>(below); p++) {
+    for (int i = busyHead[p]; i != -1; i = channels[i].next) {
+      if (channels[i].type != type) return i;
+    }
+  }
+
+  return -1;
+}
+
+int AudioResourceManager::Start(AudioType type, AudioPriority priority) {
+  std::string streamPath;
+
+  {
+    std::lock_guard<std::mutex> lock(audioMutex);
+
+    Probe(sources[type]);
+
+    if (sources[type].streamed) {
+      streamPath = sources[type].path;
+    }
+  }
+
+  if (!streamPath.empty()) {
+    return PlayStreamed(type, streamPath, priority);
+  }
+
   // Priorities are LOWEST  (one at a time, if channel available),
   //                LOW     (any free channels),
   //                HIGH    (force a channel to play sound, but one at a time, and don't interrupt other high priorities),
   //                HIGHEST (force a channel to play sound always)
 
+  // Lowest priority or high priority sounds only play once
+  if ((priority == AudioPriority::LOWEST || priority == AudioPriority::HIGH) && voiceCount[type] > 0) {
+    return -1;
+  }
 
-  // Highest priority plays over anything that isn't like it
-  if (priority == AudioPriority::HIGHEST) {
-    for (int i = 0; i < NUM_OF_CHANNELS; i++) {
-      if ((sf::SoundBuffer*)channels[i].buffer.getBuffer() == &sources[type]) {
+  int index = -1;
 
-      }
-      if (channels[i].buffer.getStatus() != sf::SoundSource::Status::Playing || channels[i].buffer.getBuffer() != &sources[type]) {
-        channels[i].buffer.stop();
-        channels[i].buffer.setBuffer(sources[type]);
-        channels[i].buffer.play();
-        channels[i].priority = priority;
-        return 0;
-      }
-    }
+  if (!freeChannels.empty()) {
+    index = freeChannels.back();
+  }
+  else if (priority == AudioPriority::HIGH) {
+    // HIGH PRIORITY will not overwrite other HIGH priorities unless they have ended
+    index = FindStealable(AudioPriority::HIGH, -1);
   }
+  else if (priority == AudioPriority::HIGHEST) {
+    // Highest priority plays over anything that isn't like it
+    index = FindStealable(AudioPriority::HIGHEST, type);
 
-  // For lowest priority or high priority sounds, scan and see if this sound is already playing...
-  // This step is also used as a pre-check for low priority sounds
-  if (priority == AudioPriority::LOWEST || priority == AudioPriority::HIGH) {
-    for (int i = 0; i < NUM_OF_CHANNELS; i++) {
-      if (channels[i].buffer.getStatus() == sf::SoundSource::Status::Playing) {
-        if ((sf::SoundBuffer*)channels[i].buffer.getBuffer() == &sources[type]) {
-          // Lowest priority or high priority sounds only play once 
-          return -1;
-        }
-      }
+    if (index == -1) {
+      index = FindStealable(static_cast<AudioPriority>(PRIORITY_COUNT), type);
     }
   }
 
-  // Play sound based on priortiy rules
-  for (int i = 0; i < NUM_OF_CHANNELS; i++) {
-    if (priority != AudioPriority::HIGH) {
-      if (channels[i].buffer.getStatus() != sf::SoundSource::Status::Playing) {
-        channels[i].buffer.setBuffer(sources[type]);
-        channels[i].buffer.play();
-        channels[i].priority = priority;
-        return 0;
+  // No free channel? Skip playing this sound.
+  if (index == -1) return -1;
+
+  // Only decode once we know the sound will play
+  AudioHandle sample;
+
+  {
+    std::lock_guard<std::mutex> lock(audioMutex);
+    sample = Acquire(type);
+  }
+
+  if (!sample) return -1;
+
+  Channel& channel = channels[index];
+
+  if (channel.type != -1) {
+    Unlink(index);
+  }
+  else {
+    freeChannels.pop_back();
+  }
+
+  channel.buffer.stop();
+  channel.buffer.setBuffer(*sample);
+  channel.buffer.play();
+  channel.source = sample;
+  channel.priority = priority;
+  channel.type = type;
+  voiceCount[type]++;
+
+  // Newest goes to the back so the oldest sound is stolen first
+  int p = static_cast<int>(priority);
+  channel.prev = busyTail[p];
+  channel.next = -1;
+
+  if (busyTail[p] != -1) channels[busyTail[p]].next = index;
+  else busyHead[p] = index;
+
+  busyTail[p] = index;
+
+  return 0;
+}
+
+int AudioResourceManager::PlayStreamed(AudioType type, const std::string& path, AudioPriority priority) {
+  StreamChannel* free = nullptr;
+  StreamChannel* steal = nullptr;
+
+  for (int i = 0; i < NUM_OF_STREAM_CHANNELS; i++) {
+    StreamChannel& channel = streamChannels[i];
+    bool playing = channel.music.getStatus() == sf::SoundSource::Status::Playing;
+
+    if (playing && channel.type == type) {
+      // Same duplicate rules as decoded samples
+      if (priority != AudioPriority::HIGH && channel.music.getPlayingOffset().asMilliseconds() <= AUDIO_DUPLICATES_ALLOWED_IN_X_MILLISECONDS) {
+        return -1;
       }
-    }
-    else { // HIGH PRIORITY will not overwrite other HIGH priorities unless they have ended
-      bool canOverwrite = channels[i].priority < AudioPriority::HIGH 
-        ||(channels[i].priority == AudioPriority::HIGH && channels[i].buffer.getStatus() != sf::SoundSource::Status::Playing);
-      if (canOverwrite) {
-        channels[i].buffer.stop();
-        channels[i].buffer.setBuffer(sources[type]);
-        channels[i].buffer.play();
-        channels[i].priority = priority;
-        return 0;
+
+      if (priority == AudioPriority::LOWEST || priority == AudioPriority::HIGH) {
+        return -1;
       }
     }
+
+    if (!playing) {
+      if (!free) free = &channel;
+    }
+    else if (channel.priority < priority && (!steal || channel.priority < steal->priority)) {
+      steal = &channel;
+    }
   }
 
-  // No free channel? Skip playing this sound.
-  return -1;
+  // Only high priorities may interrupt a long sample
+  StreamChannel* channel = free ? free : (priority >= AudioPriority::HIGH ? steal : nullptr);
+
+  if (!channel) return -1;
+
+  channel->music.stop();
+
+  ArchiveView packed;
+  bool opened = FileUtil::IsPacked(path, packed) ? channel->music.openFromMemory(packed.data, packed.size) : channel->music.openFromFile(path);
+
+  if (!opened) {
+    channel->type = -1;
+    return -1;
+  }
+
+  channel->music.setVolume(channelVolume);
+  channel->music.play();
+  channel->priority = priority;
+  channel->type = type;
+
+  return 0;
 }
 
 int AudioResourceManager::Stream(std::string path, bool loop, sf::Music::TimeSpan span) {
@@ -206,7 +603,11 @@ int AudioResourceManager::Stream(std::string path, bool loop, sf::Music::TimeSpa
   // stop previous stream if any 
   stream.stop();
 
-  if (!stream.openFromFile(path))
+  // Music streams from the archive's memory while it plays
+  ArchiveView packed;
+  bool opened = FileUtil::IsPacked(path, packed) ? stream.openFromMemory(packed.data, packed.size) : stream.openFromFile(path);
+
+  if (!opened)
     return -1; // error
 
   stream.play();
@@ -233,5 +634,9 @@ void AudioResourceManager::SetChannelVolume(float volume) {
     channels[i].buffer.setVolume(volume);
   }
 
+  for (int i = 0; i < NUM_OF_STREAM_CHANNELS; i++) {
+    streamChannels[i].music.setVolume(volume);
+  }
+
   channelVolume = volume;
 }
@@ -5,14 +5,28 @@
 #include <SFML/Audio/Music.hpp>
 #include "bnAudioType.h"
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <string>
 
 // For more retro experience, decrease available channels.
 #define NUM_OF_CHANNELS 10
 
+// Long samples play through their own streams instead of being decoded into memory
+#define NUM_OF_STREAM_CHANNELS 2
+#define AUDIO_STREAM_SAMPLES_LONGER_THAN_SECONDS 3.0f
+
+// Decoded samples nobody is using are evicted to stay under this many bytes
+#define AUDIO_SAMPLE_BUDGET_BYTES (4u * 1024u * 1024u)
+
 // Prevent duplicate sounds from stacking on same frame
 // Allows duplicate audio samples to play in X ms apart from eachother
 #define AUDIO_DUPLICATES_ALLOWED_IN_X_MILLISECONDS 58 // 58ms = ~3.5 frames
 
+// How many new sounds may start on the same frame. Extra requests are dropped lowest priority first.
+#define AUDIO_NEW_VOICES_PER_FRAME 4
+
 /**
   * @class AudioPriority
   * @brief Each priority describes how or if a playing sample should be interrupted
@@ -29,11 +43,19 @@ enum class AudioPriority : int {
   HIGHEST
 };
 
+/*! \brief Reference counted sample. The sample can be evicted once no handles are left and it is not playing. */
+typedef std::shared_ptr<sf::SoundBuffer> AudioHandle;
+
 /**
  * @class AudioResourceManager
  * @author mav
  * @date 06/05/19
  * @brief Singleton loads audio samples
+ *
+ * Samples are registered at startup and decoded the first time they are played.
+ * Scenes prefetch the samples they use so nothing decodes mid-battle.
+ * Samples longer than AUDIO_STREAM_SAMPLES_LONGER_THAN_SECONDS are never decoded
+ * into memory and play through one of the stream channels instead.
  */
 class AudioResourceManager {
 public:
@@ -50,25 +72,84 @@ public:
   void EnableAudio(bool status);
   
   /**
-   * @brief Loads all queued resources. Increases status value.
-   * @param status thread-safe counter will reach total count of all samples to load when finished.
+   * @brief Registers all hard-coded samples. Increases status value.
+   * @param status thread-safe counter will reach total count of all samples when finished.
+   *
+   * Nothing is decoded here. Samples load the first time they are used.
+   * @see Prefetch()
    */
   void LoadAllSources(std::atomic<int> &status);
   
   /**
-   * @brief Loads an audio source at path and map it to enum type
+   * @brief Registers an audio source and increases status
+   * @param type audio enum to map to
+   * @param path path to audio sample
+   * @param status increased when the sample is registered
+   */
+  void LoadSource(AudioType type, const std::string& path, std::atomic<int>& status);
+
+  /**
+   * @brief Maps an audio source at path to enum type. The sample is decoded when it is first used.
    * @param type audio enum to map to
    * @param path path to audio sample
    */
   void LoadSource(AudioType type, const std::string& path);
+
+  /**
+   * @brief Returns a handle to the decoded sample. Decodes it if this is the first use.
+   * @param type audio to load
+   * @return AudioHandle. nullptr if the sample failed to load or is streamed.
+   */
+  AudioHandle LoadSample(AudioType type);
+
+  /**
+   * @brief Decodes a list of samples ahead of time on the asset loader's workers
+   * @param types samples a scene will play
+   * @return Handles that keep the samples loaded. Hold on to them for the lifetime of the scene.
+   */
+  std::vector<AudioHandle> Prefetch(const std::vector<AudioType>& types);
+
+  /**
+   * @brief Set how many bytes of decoded samples may stay resident before unused samples are evicted
+   * @param bytes
+   */
+  void SetBudget(std::size_t bytes);
+
+  /**
+   * @brief Query how many bytes of decoded samples are resident
+   * @return bytes
+   */
+  const std::size_t GetResidentSize();
+
+  /**
+   * @brief Logs how long audio took to register and decode and how much memory it is using
+   */
+  void LogReport();
   
   /**
-   * @brief Play a sound with an audio priority
+   * @brief Queue a sound with an audio priority. It starts on the next Update().
    * @param type audio to play
    * @param priority describes if and how to interrupt other playing samples
-   * @return -1 if could not play, otherwise 0
+   * @return -1 if the sound was dropped right away as a duplicate, otherwise 0
+   *
+   * Constant time so gameplay can call it as often as it likes.
+   * A type that is already waiting is queued once and keeps the highest priority asked for.
    */
   int Play(AudioType type, AudioPriority priority = AudioPriority::LOW);
+
+  /**
+   * @brief Starts the sounds queued since the last call. Call once per frame.
+   *
+   * Requests are handled highest priority first and at most the per-frame voice limit start.
+   */
+  void Update();
+
+  /**
+   * @brief Set how many new sounds may start on the same frame
+   * @param count
+   */
+  void SetVoicesPerFrame(unsigned count);
+
   int Stream(std::string path, bool loop = false, sf::Music::TimeSpan span = sf::Music::TimeSpan());
   void StopStream();
   void SetStreamVolume(float volume);
@@ -81,10 +162,124 @@ private:
   struct Channel {
     sf::Sound buffer;
     AudioPriority priority;
+    AudioHandle source; /*!< Keeps the sample loaded while it is assigned to this channel */
+    int type; /*!< AudioType being played or -1 if the channel is free */
+    int prev, next; /*!< Neighbours in the busy list for this priority */
+  };
+
+  /**
+   * @struct Request
+   * @brief A sound waiting for the next Update()
+   */
+  struct Request {
+    AudioType type;
+    AudioPriority priority;
+  };
+
+  /**
+   * @struct StreamChannel
+   * @brief Plays one long sample straight from the file
+   */
+  struct StreamChannel {
+    sf::Music music;
+    AudioPriority priority;
+    int type; /*!< AudioType being played or -1 */
+  };
+
+  /**
+   * @struct Source
+   * @brief A registered sample and its bookkeeping
+   */
+  struct Source {
+    std::string path;
+    AudioHandle buffer; /*!< nullptr until decoded */
+    std::size_t bytes; /*!< Decoded size: sample count * 2 */
+    unsigned long long lastUsed; /*!< Value of useCounter when last requested */
+    bool probed; /*!< Duration has been read from the file header */
+    bool streamed; /*!< Too long to keep decoded. Played with a stream channel */
   };
 
+  /**
+   * @brief Read the duration from the file header to decide if the sample is streamed. audioMutex must be locked.
+   * @param source
+   */
+  void Probe(Source& source);
+
+  /**
+   * @brief Decode a sample file. Safe to call from any thread.
+   * @param path
+   * @return decoded sample or nullptr if it failed to load
+   */
+  static AudioHandle Decode(const std::string& path);
+
+  /**
+   * @brief Store a decoded sample and count it in the report. audioMutex must be locked.
+   * @param source
+   * @param buffer decoded sample. May be nullptr if decoding failed.
+   * @param elapsed time spent decoding
+   */
+  void Install(Source& source, const AudioHandle& buffer, sf::Time elapsed);
+
+  /**
+   * @brief Decode a sample if it is not loaded and mark it as used. audioMutex must be locked.
+   * @param type
+   * @return handle to the decoded sample or nullptr
+   */
+  AudioHandle Acquire(AudioType type);
+
+  /**
+   * @brief Drop the least recently used samples nobody holds until under budget. audioMutex must be locked.
+   */
+  void Evict();
+
+  /**
+   * @brief Play a long sample on a stream channel following the same priority rules as Play()
+   * @return -1 if could not play, otherwise 0
+   */
+  int PlayStreamed(AudioType type, const std::string& path, AudioPriority priority);
+
+  /**
+   * @brief Assign a sample to a channel following the priority rules
+   * @return -1 if could not play, otherwise 0
+   */
+  int Start(AudioType type, AudioPriority priority);
+
+  /**
+   * @brief Remove a channel from its busy list and stop counting it for its type
+   * @param index channel
+   */
+  void Unlink(int index);
+
+  /**
+   * @brief Find the oldest busy channel below a priority that is not playing a type
+   * @param below only channels with a lower priority are considered
+   * @param type channels playing this type are skipped
+   * @return channel index or -1
+   */
+  int FindStealable(AudioPriority below, int type);
+
+  static const int PRIORITY_COUNT = static_cast<int>(AudioPriority::HIGHEST) + 1;
+
   Channel* channels;
-  sf::SoundBuffer* sources;
+  StreamChannel* streamChannels;
+  std::vector<int> freeChannels; /*!< Channels that are not playing */
+  int busyHead[PRIORITY_COUNT]; /*!< Oldest playing channel for each priority */
+  int busyTail[PRIORITY_COUNT]; /*!< Newest playing channel for each priority */
+  std::vector<Request> requests; /*!< Sounds waiting for Update(). At most one per AudioType. */
+  std::vector<int> queued; /*!< Index into requests for each AudioType or -1 if it is not waiting */
+  std::vector<sf::Int64> lastPlayed; /*!< Microseconds when each AudioType last started playing */
+  std::vector<int> voiceCount; /*!< Channels playing each AudioType */
+  sf::Clock mixerClock; /*!< Time for lastPlayed */
+  unsigned voicesPerFrame; /*!< Most sounds that may start on one frame */
+  std::vector<Source> sources; /*!< Registered samples by AudioType */
+  std::mutex audioMutex; /*!< Guards sources. Samples can be prefetched from the loader's workers. */
+  unsigned long long useCounter; /*!< Increments on every request. Orders samples by last use. */
+  std::size_t residentBytes; /*!< Sum of all decoded sample sizes */
+  std::size_t budget; /*!< Evict unused samples when residentBytes goes over this */
+  sf::Time registerTime; /*!< Time spent in LoadAllSources() */
+  sf::Time decodeTime; /*!< Time spent decoding samples */
+  unsigned decodeCount; /*!< Samples decoded so far. Includes samples decoded again after eviction. */
+  unsigned evictCount; /*!< Samples evicted so far */
   sf::Music stream;
   float channelVolume;
   float streamVolume;
@@ -15,7 +15,8 @@ Aura::Aura(Aura::Type type, Character* owner) : type(type), SceneNode(), Compone
 {
   this->timer = 50; // seconds
   
-  auraSprite.setTexture(*TEXTURES.GetTexture(TextureType::SPELL_AURA));
+  auraTexture = TEXTURES.LoadTexture(TextureType::SPELL_AURA);
+  auraSprite.setTexture(*auraTexture);
   aura = new SpriteSceneNode(auraSprite);
 
   // owner draws -> aura component draws -> aura sprite anim draws
@@ -28,7 +29,8 @@ Aura::Aura(Aura::Type type, Character* owner) : type(type), SceneNode(), Compone
 
   persist = false;
 
-  font.setTexture(LOAD_TEXTURE(AURA_NUMSET));
+  fontTexture = TEXTURES.LoadTexture(TextureType::AURA_NUMSET);
+  font.setTexture(*fontTexture);
   font.setScale(1.f, 1.f);
   //Components setup and load
   animation = Animation(RESOURCE_PATH);
@@ -158,7 +160,7 @@ const int Aura::GetHealth() const {
 
 void Aura::TakeDamage(int damage)
 {
-  Logger::Log("Aura taking damage: " + std::to_string(damage) + " and has aura type: " + std::to_string((int)type));
+  LOG_TRACE(BATTLE, "Aura taking damage: %i and has aura type: %i", damage, (int)type);
 
   if (type >= Aura::Type::BARRIER_100) {
     health = health - damage;
@@ -2,6 +2,7 @@
 #include "bnSceneNode.h"
 #include "bnComponent.h"
 #include "bnField.h"
+#include "bnTextureResourceManager.h"
 
 class DefenseAura;
 
@@ -36,6 +37,7 @@ private:
   Animation animation; /*!< Animation object */
   SpriteSceneNode* aura; /*!< The scene node to attach to the entity's scene node */
   sf::Sprite auraSprite; /*!< the sprite drawn by SpriteSceneNode* aura */
+  TextureHandle auraTexture; /*!< Keeps the aura texture loaded */
   Type type; /*!< Type of aura */
   DefenseAura* defense; /*!< Defense rule */
   double timer; /*!< Some aura types delete over time in seconds */
@@ -46,6 +48,7 @@ private:
   int currHP; /*!< HP this frame */
   int startHP; /*!< HP at creation */
   mutable Sprite font; /*!< Aura HP glyphs */
+  TextureHandle fontTexture; /*!< Keeps the glyph texture loaded */
   Character* privOwner; /*!< We wish to track the original owner */
   BattleScene* bs; /*!< pointer to the battle scene*/
 public:
@@ -10,7 +10,8 @@ using std::to_string;
 AuraHealthUI::AuraHealthUI(Character* owner) : UIComponent(owner) {
    currHP = owner->GetHealth();
    this->owner = owner;
-   font.setTexture(LOAD_TEXTURE(AURA_NUMSET));
+   fontTexture = TEXTURES.LoadTexture(TextureType::AURA_NUMSET);
+   font.setTexture(*fontTexture);
    font.setScale(2.f, 2.f);
 }
 
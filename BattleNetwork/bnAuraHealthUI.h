@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "bnUIComponent.h"
+#include "bnTextureResourceManager.h"
 
 class Entity;
 class Player;
@@ -31,5 +32,6 @@ private:
   int currHP;
   int startHP;
   mutable Sprite font;
+  TextureHandle fontTexture;
   Character* owner;
 };
\ No newline at end of file
@@ -92,17 +92,16 @@ protected:
 public:
   /**
    * @brief Constructs background with screen width and height. Fills the screen.
-   * @param ref texture to fill
+   * @param ref texture to fill. The background keeps it loaded.
    * @param width of screen
    * @param height of screen
    */
-  Background(sf::Texture& ref, int width, int height) : offset(0,0), textureRect(0, 0, width, height), width(width), height(height), texture(ref) {
-      texture = ref;
-      texture.setRepeated(true);
+  Background(const TextureHandle& ref, int width, int height) : offset(0,0), textureRect(0, 0, width, height), width(width), height(height), texture(ref) {
+      texture->setRepeated(true);
 
       vertices.setPrimitiveType(sf::Triangles);
 
-      sf::Vector2u textureSize = ref.getSize();
+      sf::Vector2u textureSize = ref->getSize();
 
       FillScreen(textureSize);
 
@@ -128,9 +127,9 @@ public:
     states.transform *= getTransform();
 
     // apply the tileset texture
-    states.texture = &texture;
+    states.texture = texture.get();
 
-    sf::Vector2u size = texture.getSize();
+    sf::Vector2u size = texture->getSize();
 
     textureWrap->setUniform("x", (float)textureRect.left / (float)size.x);
     textureWrap->setUniform("y", (float)textureRect.top / (float)size.y);
@@ -138,6 +137,7 @@ public:
     textureWrap->setUniform("h", (float)textureRect.height / (float)size.y);
     textureWrap->setUniform("offsetx", (float)(offset.x));
     textureWrap->setUniform("offsety", (float)(offset.y));
+    SmartShader::Invalidate(textureWrap);
 
     states.shader = textureWrap;
 
@@ -158,7 +158,7 @@ public:
 
 protected:
   sf::VertexArray vertices; /*!< Geometry */
-  sf::Texture& texture; /*!< Texture aka spritesheet if animated */
+  TextureHandle texture; /*!< Texture aka spritesheet if animated */
   sf::IntRect textureRect; /*!< Frame of the animation if applicable */
   sf::Vector2f offset; /*!< Offset of the frame in pixels */
   int width, height; /*!< Dimensions of screen in pixels */
@@ -103,15 +103,15 @@ BattleResults::BattleResults(sf::Time battleLength, int moveCount, int hitCount,
  
   isRevealed = false;
 
-  resultsSprite = sf::Sprite(*TEXTURES.GetTexture(TextureType::BATTLE_RESULTS_FRAME));
+  resultsSprite = sf::Sprite(HOLD_TEXTURE(textures, BATTLE_RESULTS_FRAME));
   resultsSprite.setScale(2.f, 2.f);
   resultsSprite.setPosition(-resultsSprite.getTextureRect().width*2.f, 20.f);
 
-  pressA = sf::Sprite(LOAD_TEXTURE(BATTLE_RESULTS_PRESS_A));
+  pressA = sf::Sprite(HOLD_TEXTURE(textures, BATTLE_RESULTS_PRESS_A));
   pressA.setScale(2.f, 2.f);
   pressA.setPosition(2.f*42.f, 249.f);
 
-  star = sf::Sprite(LOAD_TEXTURE(BATTLE_RESULTS_STAR));
+  star = sf::Sprite(HOLD_TEXTURE(textures, BATTLE_RESULTS_STAR));
   star.setScale(2.f, 2.f);
   
   sf::Font *font = TEXTURES.LoadFontFromFile("resources/fonts/mmbnthick_regular.ttf");
@@ -119,7 +119,7 @@ BattleResults::BattleResults(sf::Time battleLength, int moveCount, int hitCount,
   if (item) {
     sf::IntRect rect = TEXTURES.GetCardRectFromID(item->GetID());
 
-    rewardCard = sf::Sprite(*TEXTURES.GetTexture(TextureType::CHIP_CARDS));
+    rewardCard = sf::Sprite(HOLD_TEXTURE(textures, CHIP_CARDS));
     rewardCard.setTextureRect(rect);
 
     if (item->IsChip()) {
@@ -131,7 +131,7 @@ BattleResults::BattleResults(sf::Time battleLength, int moveCount, int hitCount,
     }
   }
   else {
-    rewardCard = sf::Sprite(*TEXTURES.GetTexture(TextureType::BATTLE_RESULTS_NODATA));
+    rewardCard = sf::Sprite(HOLD_TEXTURE(textures, BATTLE_RESULTS_NODATA));
   }
 
   rewardCard.setScale(2.f, 2.f);
@@ -3,6 +3,9 @@
 #include <SFML/System.hpp>
 #include <SFML/Graphics.hpp>
 #include <array> 
+#include <vector>
+
+#include "bnTextureResourceManager.h"
 
 class Mob;
 class BattleItem;
@@ -25,6 +28,7 @@ private:
   sf::Sprite rewardCard; /*!< Reward card graphics */
   sf::Sprite pressA; /*!< Press A sprite */
   sf::Sprite star; /*!< Counter stars */
+  std::vector<TextureHandle> textures; /*!< Keeps the modal's textures loaded */
 
   bool isHidden; /*!< Flag if modal is hidden */
   bool isRevealed; /*!< Flag if modal is revealed */
@@ -11,6 +11,7 @@
 #include "bnJudgeTreeBackground.h"
 #include "bnPlayerHealthUI.h"
 #include "bnPaletteSwap.h"
+#include "bnAnimationCache.h"
 
 // Android only headers
 #include "Android/bnTouchArea.h"
@@ -44,7 +45,7 @@ BattleScene::BattleScene(swoosh::ActivityController& controller, Player* player,
         customBarShader(*SHADERS.GetShader(ShaderType::CUSTOM_BAR)),
         heatShader(*SHADERS.GetShader(ShaderType::SPOT_DISTORTION)),
         iceShader(*SHADERS.GetShader(ShaderType::SPOT_REFLECTION)),
-        distortionMap(*TEXTURES.GetTexture(TextureType::HEAT_TEXTURE)),
+        distortionMap(TEXTURES.LoadTexture(TextureType::HEAT_TEXTURE)),
         summons(player),
         chipListener(player),
         // cap of 8 chips, 8 chips drawn per turn
@@ -55,9 +56,37 @@ BattleScene::BattleScene(swoosh::ActivityController& controller, Player* player,
         persistentFolder(folder) {
 
   if (mob->GetMobCount() == 0) {
-    Logger::Log(std::string("Warning: Mob was empty when battle started. Mob Type: ") + typeid(mob).name());
+    LOG_WARN(BATTLE, "Mob was empty when battle started. Mob Type: %s", typeid(mob).name());
   }
 
+  // Spells are loaded when first cast. Load them now so the first cast does not stall the battle.
+  std::vector<TextureType> battleTextures = { TextureType::MOB_MOVE, TextureType::MOB_EXPLOSION };
+
+  for (int type = TextureType::MISC_MYSTERY_DATA; type <= TextureType::SPELL_IMPACT_FX; type++) {
+    battleTextures.push_back(static_cast<TextureType>(type));
+  }
+
+  prefetchedTextures = TEXTURES.Prefetch(battleTextures);
+
+  SHADERS.Prefetch({
+    ShaderType::BLACK_FADE, ShaderType::WHITE_FADE, ShaderType::YELLOW, ShaderType::CUSTOM_BAR,
+    ShaderType::SPOT_DISTORTION, ShaderType::SPOT_REFLECTION, ShaderType::GREYSCALE, ShaderType::COLORIZE,
+    ShaderType::WHITE, ShaderType::TEXEL_PIXEL_BLUR, ShaderType::PALETTE_SWAP, ShaderType::BADGE_WIRE
+  });
+
+  // Same for sound effects. Menu and title samples are left to load when they are played.
+  prefetchedAudio = AUDIO.Prefetch({
+    AudioType::APPEAR, AudioType::AREA_GRAB, AudioType::AREA_GRAB_TOUCHDOWN, AudioType::BUSTER_PEA,
+    AudioType::BUSTER_CHARGED, AudioType::BUSTER_CHARGING, AudioType::BUBBLE_POP, AudioType::BUBBLE_SPAWN,
+    AudioType::GUARD_HIT, AudioType::CANNON, AudioType::COUNTER, AudioType::WIND, AudioType::CHIP_CANCEL,
+    AudioType::CHIP_CHOOSE, AudioType::CHIP_CONFIRM, AudioType::CHIP_DESC, AudioType::CHIP_DESC_CLOSE,
+    AudioType::CHIP_SELECT, AudioType::CHIP_ERROR, AudioType::CUSTOM_BAR_FULL, AudioType::CUSTOM_SCREEN_OPEN,
+    AudioType::DELETED, AudioType::EXPLODE, AudioType::GUN, AudioType::HURT, AudioType::PANEL_CRACK,
+    AudioType::PANEL_RETURN, AudioType::PAUSE, AudioType::PRE_BATTLE, AudioType::RECOVER, AudioType::SPREADER,
+    AudioType::SWORD_SWING, AudioType::TOSS_ITEM, AudioType::TOSS_ITEM_LITE, AudioType::WAVE, AudioType::THUNDER,
+    AudioType::ELECPULSE, AudioType::INVISIBLE, AudioType::PA_ADVANCE, AudioType::LOW_HP
+  });
+
   /*
   Set Scene*/
   field = mob->GetField();
@@ -132,7 +161,7 @@ BattleScene::BattleScene(swoosh::ActivityController& controller, Player* player,
   listStepCooldown = 0.2f;
   listStepCounter = listStepCooldown;
 
-  programAdvanceSprite = sf::Sprite(LOAD_TEXTURE(PROGRAM_ADVANCE));
+  programAdvanceSprite = sf::Sprite(HOLD_TEXTURE(textures, PROGRAM_ADVANCE));
   programAdvanceSprite.setScale(2.f, 2.f);
   programAdvanceSprite.setOrigin(0, programAdvanceSprite.getLocalBounds().height/2.0f);
   programAdvanceSprite.setPosition(40.0f, 58.f);
@@ -144,26 +173,26 @@ BattleScene::BattleScene(swoosh::ActivityController& controller, Player* player,
   Other battle labels
   */
 
-  battleStart = sf::Sprite(LOAD_TEXTURE(BATTLE_START));
+  battleStart = sf::Sprite(HOLD_TEXTURE(textures, BATTLE_START));
   battleStart.setOrigin(battleStart.getLocalBounds().width / 2.0f, battleStart.getLocalBounds().height / 2.0f);
   battleStartPos = sf::Vector2f(240.f, 140.f);
   battleStart.setPosition(battleStartPos);
   battleStart.setScale(2.f, 2.f);
 
   battleEnd = battleStart;
-  battleEnd.setTexture(LOAD_TEXTURE(ENEMY_DELETED));
+  battleEnd.setTexture(HOLD_TEXTURE(textures, ENEMY_DELETED));
 
-  doubleDelete = sf::Sprite(LOAD_TEXTURE(DOUBLE_DELETE));
+  doubleDelete = sf::Sprite(HOLD_TEXTURE(textures, DOUBLE_DELETE));
   doubleDelete.setOrigin(doubleDelete.getLocalBounds().width / 2.0f, doubleDelete.getLocalBounds().height / 2.0f);
   comboInfoPos = sf::Vector2f(240.0f, 50.f);
   doubleDelete.setPosition(comboInfoPos);
   doubleDelete.setScale(2.f, 2.f);
 
   tripleDelete = doubleDelete;
-  tripleDelete.setTexture(LOAD_TEXTURE(TRIPLE_DELETE));
+  tripleDelete.setTexture(HOLD_TEXTURE(textures, TRIPLE_DELETE));
 
   counterHit = doubleDelete;
-  counterHit.setTexture(LOAD_TEXTURE(COUNTER_HIT));
+  counterHit.setTexture(HOLD_TEXTURE(textures, COUNTER_HIT));
   /*
   Chips + Chip select setup*/
   chips = nullptr;
@@ -180,7 +209,7 @@ BattleScene::BattleScene(swoosh::ActivityController& controller, Player* player,
   pauseLabel->setPosition(sf::Vector2f(240.f, 160.f));
 
   // CHIP CUST GRAPHICS
-  customBarTexture = TEXTURES.LoadTextureFromFile("resources/ui/custom.png");
+  customBarTexture = TEXTURES.LoadTexture("resources/ui/custom.png");
   customBarSprite.setTexture(*customBarTexture);
   customBarSprite.setOrigin(customBarSprite.getLocalBounds().width / 2, 0);
   customBarPos = sf::Vector2f(240.f, 0.f);
@@ -240,13 +269,13 @@ BattleScene::BattleScene(swoosh::ActivityController& controller, Player* player,
   customBarSprite.SetShader(&customBarShader);
 
   // Heat distortion effect
-  distortionMap.setRepeated(true);
-  distortionMap.setSmooth(true);
+  distortionMap->setRepeated(true);
+  distortionMap->setSmooth(true);
 
   textureSize = getController().getVirtualWindowSize();
 
   heatShader.setUniform("texture", sf::Shader::CurrentTexture);
-  heatShader.setUniform("distortionMapTexture", distortionMap);
+  heatShader.setUniform("distortionMapTexture", *distortionMap);
   heatShader.setUniform("textureSizeIn", sf::Glsl::Vec2((float)textureSize.x, (float)textureSize.y));
 
   iceShader.setUniform("texture", sf::Shader::CurrentTexture);
@@ -254,7 +283,14 @@ BattleScene::BattleScene(swoosh::ActivityController& controller, Player* player,
   iceShader.setUniform("textureSizeIn", sf::Glsl::Vec2((float)textureSize.x, (float)textureSize.y));
   iceShader.setUniform("shine", 0.2f);
 
-  shine = sf::Sprite(LOAD_TEXTURE(MOB_BOSS_SHINE));
+  // These were written directly. Smart draws must not trust what they last uploaded.
+  SmartShader::Invalidate(&pauseShader);
+  SmartShader::Invalidate(&whiteShader);
+  SmartShader::Invalidate(&customBarShader);
+  SmartShader::Invalidate(&heatShader);
+  SmartShader::Invalidate(&iceShader);
+
+  shine = sf::Sprite(HOLD_TEXTURE(textures, MOB_BOSS_SHINE));
   shine.setScale(2.f, 2.f);
 
   shineAnimation = Animation("resources/mobs/boss_shine.animation");
@@ -267,12 +303,17 @@ BattleScene::~BattleScene()
 {
   components.clear();
   scenenodes.clear();
+
+  // Free the animation files only this battle was using
+  ANIMATIONS.Prune();
+
+  AUDIO.LogReport();
 }
 
 // What to do if we inject a chip publisher, subscribe it to the main listener
 void BattleScene::Inject(ChipUsePublisher& pub)
 {
-  std::cout << "a chip use listener added" << std::endl;
+  LOG_TRACE(BATTLE, "A chip use listener was added");
   this->enemyChipListener.Subscribe(pub);
   this->summons.Subscribe(pub);
 
@@ -421,7 +462,7 @@ void BattleScene::OnDeleteEvent(Character & pending)
     return false;
   });
 
-  Logger::Logf("Deleting %s from battle", pending.GetName().c_str());
+  LOG_DEBUG(BATTLE, "Deleting %s from battle", pending.GetName().c_str());
   mob->Forget(pending);
 }
 
@@ -525,7 +566,7 @@ void BattleScene::onUpdate(double elapsed) {
               unsigned thisIDX = idx;
               bool enabled =(*states)[idx++];
               //child->EnableParentShader(enabled);
-              Logger::Logf("Enabling state for child #%i: %s", thisIDX, enabled ? "true" : "false");
+              LOG_TRACE(BATTLE, "Enabling state for child #%i: %s", thisIDX, enabled ? "true" : "false");
             }
           };
 
@@ -650,7 +691,7 @@ void BattleScene::onUpdate(double elapsed) {
       if (battleTimer.isPaused()) {
         battleTimer.start();
         comboDeleteCounter = 0; // reset the combo
-        Logger::Log("comboDeleteCounter reset");
+        LOG_TRACE(BATTLE, "comboDeleteCounter reset");
       }
     }
 
@@ -706,6 +747,16 @@ void BattleScene::onDraw(sf::RenderTexture& surface) {
   auto allTiles = field->FindTiles([](Battle::Tile* tile) { return true; });
   auto tilesIter = allTiles.begin();
 
+  // Tiles never overlap so they can be grouped by atlas and shader
+  tileBatch.Begin(SpriteBatch::Order::grouped);
+
+  bool isBackdropActive = summons.IsSummonActive() || showSummonBackdrop || isChangingForm;
+
+  if (isBackdropActive) {
+    pauseShader.setUniform("opacity", (float)backdropOpacity*float(std::max(0.0, (showSummonBackdropTimer / showSummonBackdropLength))));
+    SmartShader::Invalidate(&pauseShader);
+  }
+
   while (tilesIter != allTiles.end()) {
     tile = (*tilesIter);
 
@@ -717,56 +768,34 @@ void BattleScene::onDraw(sf::RenderTexture& surface) {
 
     tile->move(ENGINE.GetViewOffset());
 
-    if (summons.IsSummonActive() || showSummonBackdrop || isChangingForm) {
-      SpriteSceneNode* coloredTile = new SpriteSceneNode(*(sf::Sprite*)tile);
-      coloredTile->SetShader(&pauseShader);
-      pauseShader.setUniform("opacity", (float)backdropOpacity*float(std::max(0.0, (showSummonBackdropTimer / showSummonBackdropLength))));
-      ENGINE.Draw(coloredTile);
-      delete coloredTile;
+    if (isBackdropActive) {
+      tileBatch.Submit(*tile, sf::RenderStates(&pauseShader));
+    }
+    else if (tile->IsHighlighted()) {
+      tileBatch.Submit(*tile, sf::RenderStates(&yellowShader));
     }
     else {
-      if (tile->IsHighlighted()) {
-        SpriteSceneNode* coloredTile = new SpriteSceneNode(*(sf::Sprite*)tile);
-        coloredTile->SetShader(&yellowShader);
-        ENGINE.Draw(coloredTile);
-        delete coloredTile;
-      }
-      else {
-        ENGINE.Draw(tile);
-      }
+      tileBatch.Submit(*tile, sf::RenderStates(ENGINE.GetShader()));
     }
 
     tile->move(-ENGINE.GetViewOffset());
     tilesIter++;
   }
 
+  ENGINE.Draw(tileBatch);
+
   // Second tile pass: draw the entities and shaders per row and per layer
   tile = nullptr;
   tilesIter = allTiles.begin();
 
-  std::vector<Entity*> entitiesOnRow;
-  int lastRow = 0;
-
-  while (tilesIter != allTiles.end()) {
-    if (lastRow != (*tilesIter)->GetY()) {
-      lastRow = (*tilesIter)->GetY();
-
-      // Ensure all entities are sorted by layer
-      std::sort(entitiesOnRow.begin(), entitiesOnRow.end(), [](Entity* a, Entity*b) -> bool { return a->GetLayer() > b->GetLayer(); });
-
-      // draw this row
-      for (auto entity : entitiesOnRow) {
-        entity->move(ENGINE.GetViewOffset());
-
-        ENGINE.Draw(entity);
+  // Entities are keyed by row and layer and sorted once for the whole frame
+  renderQueue.Clear();
 
-        entity->move(-ENGINE.GetViewOffset());
-      }
-
-      // prepare for bext row
-      entitiesOnRow.clear();
-    }
+  // Draw relative to the camera without moving the entities
+  sf::RenderStates entityStates(ENGINE.GetShader());
+  entityStates.transform.translate(ENGINE.GetViewOffset());
 
+  while (tilesIter != allTiles.end()) {
       tile = (*tilesIter);
       static float totalTime = 0;
       totalTime += (float)elapsed;
@@ -797,7 +826,7 @@ void BattleScene::onDraw(sf::RenderTexture& surface) {
             ui.insert(ui.begin(), uic.begin(), uic.end());
           }
 
-          entitiesOnRow.push_back(*entitiesIter);
+          renderQueue.Submit(tile->GetY(), *entity, entityStates);
 
         }
 
@@ -847,21 +876,11 @@ void BattleScene::onDraw(sf::RenderTexture& surface) {
         tilesIter++;
   }
 
-  // Last row needs to be drawn now that the loop is over
-  // Ensure all entities are sorted by layer
-  std::sort(entitiesOnRow.begin(), entitiesOnRow.end(), [](Entity* a, Entity*b) -> bool { return a->GetLayer() > b->GetLayer(); });
-
-  // draw this row
-  for (auto entity : entitiesOnRow) {
-    entity->move(ENGINE.GetViewOffset());
-
-    ENGINE.Draw(entity);
-
-    entity->move(-ENGINE.GetViewOffset());
-  }
+  // Entities overlap so draw order must be kept
+  entityBatch.Begin(SpriteBatch::Order::sequential);
+  renderQueue.Flush(entityBatch);
 
-  // prepare for bext row
-  entitiesOnRow.clear();
+  ENGINE.Draw(entityBatch);
 
   // Draw scene nodes
   for (auto node : scenenodes) {
@@ -887,6 +906,7 @@ void BattleScene::onDraw(sf::RenderTexture& surface) {
     // apply shader on draw calls below
     ENGINE.SetShader(&pauseShader);
     pauseShader.setUniform("opacity", 0.25f);
+    SmartShader::Invalidate(&pauseShader);
   }
 
   // TODO: hack to swap out
@@ -1019,7 +1039,7 @@ void BattleScene::onDraw(sf::RenderTexture& surface) {
         summonTimer = 0;
         showSummonBackdrop = true;
         showSummonBackdropTimer = 0;
-        std::cout << "prevSummonState flagged" << std::endl;
+        LOG_TRACE(BATTLE, "prevSummonState flagged");
       }
     }
   }
@@ -1458,6 +1478,7 @@ void BattleScene::onDraw(sf::RenderTexture& surface) {
   }
 
   customBarShader.setUniform("factor", (float)(customProgress / customDuration));
+  SmartShader::Invalidate(&customBarShader);
 }
 
 void BattleScene::onStart() {
@@ -1555,7 +1576,7 @@ void BattleScene::SetupTouchControls() {
   TouchArea& dpad = TouchArea::create(sf::IntRect(0, 0, 240, 320));
   dpad.enableExtendedRelease(true);
   dpad.onDrag([](sf::Vector2i delta) {
-      Logger::Log("dpad delta: " + std::to_string(delta.x) + ", " + std::to_string(delta.y));
+      LOG_TRACE(MENUS, "dpad delta: %i, %i", delta.x, delta.y);
 
       if(delta.x > 30) {
         INPUT.VirtualKeyEvent(InputEvent::PRESSED_RIGHT);
@@ -15,9 +15,12 @@
 #include "bnChipSelectionCust.h"
 #include "bnChipFolder.h"
 #include "bnShaderResourceManager.h"
+#include "bnTextureResourceManager.h"
+#include "bnAudioResourceManager.h"
 #include "bnPA.h"
 #include "bnEngine.h"
 #include "bnSceneNode.h"
+#include "bnRenderQueue.h"
 #include "bnBattleResults.h"
 #include "bnBattleScene.h"
 #include "bnMob.h"
@@ -158,7 +161,7 @@ private:
   sf::Text* pauseLabel; /*!< "PAUSE" test */
 
   // CHIP CUST GRAPHICS
-  sf::Texture* customBarTexture; /*!< Cust gauge image */
+  TextureHandle customBarTexture; /*!< Cust gauge image */
   SpriteSceneNode customBarSprite; /*!< Cust gauge sprite */
   sf::Vector2f customBarPos; /*!< Cust gauge position */
 
@@ -224,11 +227,17 @@ private:
   sf::Shader& iceShader; /*!< Reflection in the ice */
 
   // Heat distortion effect
-  sf::Texture& distortionMap; /*!< Distortion effect pixel sample source */
+  TextureHandle distortionMap; /*!< Distortion effect pixel sample source */
   sf::Vector2u textureSize; /*!< Size of distorton effect */
 
   //graphics that appear onscreen
   std::vector<SceneNode*> scenenodes; /*!< Scene node system */
+  SpriteBatch tileBatch; /*!< Tiles are grouped by atlas and shader into a few draw calls */
+  SpriteBatch entityBatch; /*!< Entities are batched in draw order */
+  RenderQueue renderQueue; /*!< Sorts entities by row, layer, shader, and texture */
+  std::vector<TextureHandle> prefetchedTextures; /*!< Battle textures kept loaded for the whole battle */
+  std::vector<TextureHandle> textures; /*!< Keeps the scene's sprite textures loaded */
+  std::vector<AudioHandle> prefetchedAudio; /*!< Battle samples kept decoded for the whole battle */
 
   // for time-based graphics effects
   double elapsed; /*!< total time elapsed in battle */
@@ -10,8 +10,8 @@
 Bees::Bees(Field* _field, Team _team, int damage) : Spell(_field, _team), damage(damage) {
   SetLayer(0);
 
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_BEES);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_BEES);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   HighlightTile(Battle::Tile::Highlight::solid);
@@ -33,7 +33,7 @@ Bees::Bees(Field* _field, Team _team, int damage) : Spell(_field, _team), damage
   animation.Update(0, *this);
 
   shadow = new SpriteSceneNode();
-  shadow->setTexture(LOAD_TEXTURE(MISC_SHADOW));
+  shadow->setTexture(TEXTURES.LoadTexture(TextureType::MISC_SHADOW));
   shadow->SetLayer(1);
   shadow->setPosition(-8.0f, 20.0f);
 
@@ -64,8 +64,8 @@ Bees::Bees(Bees & leader) : Spell(leader.GetField(), leader.GetTeam()), damage(l
 {
   SetLayer(0);
 
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_BEES);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_BEES);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   HighlightTile(Battle::Tile::Highlight::solid);
@@ -87,7 +87,7 @@ Bees::Bees(Bees & leader) : Spell(leader.GetField(), leader.GetTeam()), damage(l
   animation.Update(0, *this);
 
   shadow = new SpriteSceneNode();
-  shadow->setTexture(LOAD_TEXTURE(MISC_SHADOW));
+  shadow->setTexture(TEXTURES.LoadTexture(TextureType::MISC_SHADOW));
   shadow->SetLayer(1);
   shadow->setPosition(-12.0f, 18.0f);
 
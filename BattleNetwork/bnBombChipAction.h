@@ -2,12 +2,14 @@
 #include "bnChipAction.h"
 #include "bnAnimation.h"
 #include <SFML/Graphics.hpp>
+#include "bnTextureResourceManager.h"
 
 class SpriteSceneNode;
 class Character;
 class BombChipAction : public ChipAction {
 private:
   sf::Sprite overlay;
+  TextureHandle overlayTexture;
   SpriteSceneNode* attachment;
   Animation attachmentAnim;
   int damage;
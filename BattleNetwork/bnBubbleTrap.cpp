@@ -25,7 +25,7 @@ BubbleTrap::BubbleTrap(Character* owner) : Artifact(nullptr), Component(owner)
   }
 
   SetLayer(1);
-  this->setTexture(*TEXTURES.GetTexture(TextureType::SPELL_BUBBLE_TRAP));
+  this->setTexture(TEXTURES.LoadTexture(TextureType::SPELL_BUBBLE_TRAP));
   this->setScale(2.f, 2.f);
   bubble = (sf::Sprite)*this;
 
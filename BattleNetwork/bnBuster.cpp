@@ -34,12 +34,12 @@ Buster::Buster(Field* _field, Team _team, bool _charged, int damage) : isCharged
   this->RegisterComponent(animationComponent);
 
   if (_charged) {
-    texture = TEXTURES.GetTexture(TextureType::SPELL_CHARGED_BULLET_HIT);
+    texture = TEXTURES.LoadTexture(TextureType::SPELL_CHARGED_BULLET_HIT);
     animationComponent->Setup("resources/spells/spell_charged_bullet_hit.animation");
     animationComponent->Reload();
     animationComponent->SetAnimation("HIT");
   } else {
-    texture = TEXTURES.GetTexture(TextureType::SPELL_BULLET_HIT);
+    texture = TEXTURES.LoadTexture(TextureType::SPELL_BULLET_HIT);
     animationComponent->Setup("resources/spells/spell_bullet_hit.animation");
     animationComponent->Reload();
     animationComponent->SetAnimation("HIT");
@@ -67,7 +67,7 @@ void Buster::OnUpdate(float _elapsed) {
       setPosition(tile->getPosition().x + random, tile->getPosition().y - hitHeight);
     }
     progress += 5 * _elapsed;
-    this->setTexture(*texture);
+    this->setTexture(texture);
     if (progress >= 1.f) {
       this->Delete();
     }
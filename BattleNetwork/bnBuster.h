@@ -36,7 +36,7 @@ private:
   float cooldown;
   float random; // offset
   float hitHeight;
-  sf::Texture* texture;
+  TextureHandle texture;
   float progress;
   AnimationComponent* animationComponent;
 };
\ No newline at end of file
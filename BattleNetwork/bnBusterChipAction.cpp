@@ -22,7 +22,8 @@ attachmentAnim(owner->GetFirstComponent<AnimationComponent>()->GetFilePath()) {
   attachmentAnim2.SetAnimation("BUSTER");
 
   this->attachment = new SpriteSceneNode();
-  this->attachment->setTexture(*TextureResourceManager::GetInstance().LoadTextureFromFile(NODE_PATH));
+  attachmentTexture = TEXTURES.LoadTexture(NODE_PATH);
+  this->attachment->setTexture(*attachmentTexture);
   this->attachment->SetLayer(-1);
 
   attachmentAnim = Animation(NODE_ANIM);
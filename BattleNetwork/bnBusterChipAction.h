@@ -3,12 +3,14 @@
 #include "bnChipAction.h"
 #include "bnAnimation.h"
 #include <SFML/Graphics.hpp>
+#include "bnTextureResourceManager.h"
 
 class SpriteSceneNode;
 class Character;
 class BusterChipAction : public ChipAction {
 private:
   SpriteSceneNode *attachment, *attachment2;
+  TextureHandle attachmentTexture;
   Animation attachmentAnim, attachmentAnim2;
   bool charged;
   int damage;
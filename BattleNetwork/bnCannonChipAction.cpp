@@ -18,7 +18,8 @@
 CannonChipAction::CannonChipAction(Character * owner, int damage) : ChipAction(owner, "PLAYER_SHOOTING", &attachment, "Buster"), attachmentAnim(CANNON_ANIM) {
   this->damage = damage;
 
-  cannon.setTexture(*TextureResourceManager::GetInstance().LoadTextureFromFile(CANNON_PATH));
+  cannonTexture = TEXTURES.LoadTexture(CANNON_PATH);
+  cannon.setTexture(*cannonTexture);
   this->attachment = new SpriteSceneNode(cannon);
   this->attachment->SetLayer(-1);
 
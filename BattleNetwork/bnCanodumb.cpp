@@ -17,7 +17,7 @@ Canodumb::Canodumb(Rank _rank)
   :  AI<Canodumb>(this), AnimatedCharacter(_rank) {
   Entity::team = Team::BLUE;
 
-  setTexture(*TEXTURES.GetTexture(TextureType::MOB_CANODUMB_ATLAS));
+  setTexture(TEXTURES.LoadTexture(TextureType::MOB_CANODUMB_ATLAS));
   setScale(2.f, 2.f);
 
   this->SetHealth(health);
@@ -15,7 +15,7 @@ CanonSmoke::CanonSmoke(Field* _field) : Artifact(_field)
   animationComponent = new AnimationComponent(this);
   this->RegisterComponent(animationComponent);
 
-  setTexture(*TEXTURES.GetTexture(TextureType::MOB_CANODUMB_ATLAS));
+  setTexture(TEXTURES.LoadTexture(TextureType::MOB_CANODUMB_ATLAS));
   setScale(2.f, 2.f);
 
   //Components setup and load
@@ -202,7 +202,7 @@ const bool Character::Hit(Hit::Properties props) {
   // Add to status queue for state resolution
   this->statusQueue.push(props);
 
-  Logger::Log("pushing states");
+  LOG_TRACE(BATTLE, "pushing states");
 
   return true;
 }
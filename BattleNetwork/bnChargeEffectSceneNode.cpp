@@ -8,7 +8,7 @@ ChargeEffectSceneNode::ChargeEffectSceneNode(Entity* _entity) {
   entity = _entity;
   charging = false;
   chargeCounter = 0.0f;
-  this->setTexture(LOAD_TEXTURE(SPELL_BUSTER_CHARGE));
+  this->setTexture(TEXTURES.LoadTexture(TextureType::SPELL_BUSTER_CHARGE));
 
   animation = Animation("resources/spells/spell_buster_charge.animation");
 
@@ -13,7 +13,7 @@ ChargedBusterHit::ChargedBusterHit(Field* _field) : Artifact(_field)
   field = _field;
   team = Team::UNKNOWN;
 
-  setTexture(*TEXTURES.GetTexture(TextureType::SPELL_CHARGED_BULLET_HIT));
+  setTexture(TEXTURES.LoadTexture(TextureType::SPELL_CHARGED_BULLET_HIT));
   setScale(2.f, 2.f);
 
   //Components setup and load
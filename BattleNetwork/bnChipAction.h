@@ -52,7 +52,7 @@ public:
         // use the current animation's arrangement, do not overload
         this->prevState = anim->GetAnimationString();;
         this->anim->SetAnimation(animation, [this]() {
-          Logger::Log("normal callback fired");
+          LOG_TRACE(BATTLE, "normal callback fired");
           this->RecallPreviousState();
           this->EndAction();
         });
@@ -70,7 +70,7 @@ public:
       prepareActionDelegate = [this, frameData]() {
         anim->OverrideAnimationFrames(this->animation, frameData, this->uuid);
         anim->SetAnimation(this->uuid, [this]() {
-          Logger::Log("custom callback fired");
+          LOG_TRACE(BATTLE, "custom callback fired");
 
           anim->SetPlaybackMode(Animator::Mode::Loop);
           this->RecallPreviousState();
@@ -4,7 +4,7 @@
 ChipDescriptionTextbox::ChipDescriptionTextbox(sf::Vector2f pos) :
    AnimatedTextBox(pos)
 {
-
+  navigatorMug = TEXTURES.LoadTexture(TextureType::MUG_NAVIGATOR);
 }
 
 void ChipDescriptionTextbox::DescribeChip(Chip* chip)
@@ -15,7 +15,7 @@ void ChipDescriptionTextbox::DescribeChip(Chip* chip)
     this->DequeMessage();
   }
 
-  this->EnqueMessage(sf::Sprite(LOAD_TEXTURE(MUG_NAVIGATOR)), "resources/ui/navigator.animation", new Message(chip->GetDescription()));
+  this->EnqueMessage(sf::Sprite(*navigatorMug), "resources/ui/navigator.animation", new Message(chip->GetDescription()));
 
 
   // FOR FUN TESTING:
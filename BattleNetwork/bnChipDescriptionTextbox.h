@@ -25,4 +25,7 @@ public:
    * before adding new information
    */
   void DescribeChip(Chip* chip);
+
+private:
+  TextureHandle navigatorMug; /*!< Keeps the navigator mugshot loaded */
 };
\ No newline at end of file
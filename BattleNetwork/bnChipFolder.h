@@ -94,17 +94,32 @@ public:
     ChipFolder folder;
     folder.folderSize = folder.initialSize = ChipLibrary::GetInstance().GetSize();
 
+    ChipLibrary& library = ChipLibrary::GetInstance();
+
     for (int i = 0; i < folder.folderSize; i++) {
-      int random = rand() % ChipLibrary::GetInstance().GetSize();
+      unsigned random = rand() % library.GetSize();
 
-      // the folder contains random parts from the entire library
-      ChipLibrary::Iter iter = ChipLibrary::GetInstance().Begin();
+      // the folder contains random parts from the entire library. Skip whole codes until the copy is found.
+      for (std::size_t r = 0; r < library.GetRecordCount(); r++) {
+        const ChipRecord& record = library.GetRecord(r);
+        char picked = '\0';
 
-      while (random-- > 0) {
-        iter++;
-      }
+        for (char code : library.GetCodes()) {
+          unsigned copies = record.CountOf(code);
+
+          if (random < copies) {
+            picked = code;
+            break;
+          }
 
-      folder.folderList.push_back(new Chip(*(iter)));
+          random -= copies;
+        }
+
+        if (picked != '\0') {
+          folder.folderList.push_back(new Chip(record.MakeChip(picked)));
+          break;
+        }
+      }
     }
 
     return folder;
@@ -4,6 +4,9 @@
 #include <vector>
 #include "bnChipFolder.h"
 #include "bnFileUtil.h"
+#include "bnKeyValueReader.h"
+#include "bnSaveService.h"
+#include <sstream>
 #include <iostream>
 #include "bnLogger.h"
 
@@ -163,57 +166,48 @@ public:
    */
   static ChipFolderCollection ReadFromFile(const std::string& path) {
     string data = FileUtil::Read(path);
-
-    int endline = 0;
+    KeyValueReader reader(data, path);
 
     ChipFolderCollection collection;
     ChipFolder* currFolder = nullptr;
 
-    do {
-      endline = (int)data.find("\n");
-      string line = data.substr(0, endline);
-
-      while (line.compare(0, 1, " ") == 0)
-        line.erase(line.begin()); // remove leading whitespaces
-      while (line.size() > 0 && line.compare(line.size() - 1, 1, " ") == 0)
-        line.erase(line.end() - 1); // remove trailing whitespaces
+    while (reader.Next()) {
+      std::string_view tag = reader.GetTag();
 
-      if (line.find("Folder") != string::npos) {
-        string title = FileUtil::ValueOf("title", line);
-        std::cout << "Looking for folder " << title << std::endl;
+      if (tag == "Folder") {
+        string title = KeyValueReader::ToString(reader.Require("title"));
+        LOG_DEBUG(CHIPS, "Looking for folder %s", title.c_str());
 
         if (collection.HasFolder(title)) {
           if (!collection.GetFolder(title, currFolder)) {
-            Logger::Log("Failed to get folder " + title);
+            LOG_ERROR(CHIPS, "Failed to get folder %s", title.c_str());
           }
         }
         else {
           // 10 chars fit on the box 
           title = title.substr(0, 10);
 
-          std::cout << "making folder " << title << std::endl;
-          std::cout << "folder status: " << (int)(collection.MakeFolder(title)) << std::endl;;
-          std::cout << "retrieved folder: " << (int)collection.GetFolder(title, currFolder) << std::endl;
-        }
+          bool made = collection.MakeFolder(title);
+          bool found = collection.GetFolder(title, currFolder);
 
-        std::cout << "folder addr " << currFolder << std::endl;
+          LOG_DEBUG(CHIPS, "Making folder %s. made: %i, retrieved: %i", title.c_str(), (int)made, (int)found);
+        }
       }
+      else if (tag == "Chip") {
+        string name = KeyValueReader::ToString(reader.Require("name"));
+        std::string_view code = reader.Require("code");
 
-      if (line.find("Chip") != string::npos) {
-        string name = FileUtil::ValueOf("name", line);
-        string code = FileUtil::ValueOf("code", line);
+        if (code.empty()) continue;
 
         if(currFolder != nullptr) {
           // Query the library for this chip data and push into the folder.
           currFolder->AddChip(CHIPLIB.GetChipEntry(name, code[0]));
         }
         else {
-          Logger::Log("Failed to add chip (" + name + ", " + code[0] + "), no folder in build scope!");
+          reader.Error("Failed to add chip (" + name + ", " + code[0] + "), no folder in build scope!");
         }
       }
-
-      data = data.substr(endline + 1);
-    } while (endline > -1);
+    }
 
     return collection;
   }
@@ -221,26 +215,30 @@ public:
     /**
    * @brief Writes all in-game folders to a file and overwrites if a file with the same path exists
    * @param path to folder
-   * @return true if written successfully, false otherwise
+   * @return true if the save was queued, false otherwise
+   *
+   * The folders are copied to text right away. The file is written in the background by SaveService.
    */
     bool WriteToFile(const std::string& path) {
       try {
-        FileUtil::WriteStream ws(path);
+        std::ostringstream ws;
 
         for (int i = 0; i < order.size(); i++) {
           auto curr = collection[order[i]];
-          ws << "Folder title=\"" << order[i] << "\"" << ws.endl();
+          ws << "Folder title=\"" << order[i] << "\"" << '\n';
 
           auto writableFolder = curr;
           for (auto iter = writableFolder->Begin(); iter != writableFolder->End(); iter++) {
             ws << "   Chip name=\"" << (*iter)->GetShortName() << "\" code=\"" << (*iter)->GetCode() << "\""
-               << ws.endl();
+               << '\n';
           }
 
-          ws << ws.endl(); // space between folders
+          ws << '\n'; // space between folders
         }
+
+        SAVES.Save(path, ws.str());
       }catch(std::exception& e) {
-        Logger::Log(std::string("Writing chip folder collection failed: ") + e.what());
+        LOG_ERROR(CHIPS, "Writing chip folder collection failed: %s", e.what());
         return false;
       }
 
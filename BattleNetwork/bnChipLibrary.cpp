@@ -1,13 +1,29 @@
 #include "bnChipLibrary.h"
 #include "bnFileUtil.h"
+#include "bnKeyValueReader.h"
 #include "bnTextureResourceManager.h"
+#include "bnSaveService.h"
 #include <assert.h>
 #include <sstream>
 #include <algorithm>
 #include <ctime>
 #include <iomanip>
 
-ChipLibrary::ChipLibrary() {
+const bool ChipRecord::HasCode(char code) const {
+  int bit = ChipLibrary::CodeBit(code);
+  return bit >= 0 && (codes & (1u << bit)) != 0;
+}
+
+const unsigned ChipRecord::CountOf(char code) const {
+  int bit = ChipLibrary::CodeBit(code);
+  return bit >= 0 ? copies[bit] : 0u;
+}
+
+Chip ChipRecord::MakeChip(char code) const {
+  return Chip(id, icon, code, damage, element, string(name), string(description), string(verboseDescription), rarity);
+}
+
+ChipLibrary::ChipLibrary() : size(0), revision(0) {
   LoadLibrary("resources/database/library.txt");
 }
 
@@ -20,19 +36,14 @@ ChipLibrary& ChipLibrary::GetInstance() {
   return instance;
 }
 
-ChipLibrary::Iter ChipLibrary::Begin()
-{
-  return library.begin();
-}
-
-ChipLibrary::Iter ChipLibrary::End()
+const unsigned ChipLibrary::GetSize() const
 {
-  return library.end();
+  return (unsigned)size;
 }
 
-const unsigned ChipLibrary::GetSize() const
+const unsigned ChipLibrary::GetRevision() const
 {
-  return (unsigned)library.size();
+  return revision;
 }
 
 const Element ChipLibrary::GetElementFromStr(std::string type)
@@ -125,30 +136,119 @@ const std::string ChipLibrary::GetStrFromElement(const Element type) {
   return res;
 }
 
-void ChipLibrary::AddChip(Chip chip)
+const int ChipLibrary::CodeBit(char code)
 {
-  library.insert(chip);
+  if (code >= 'A' && code <= 'Z') return code - 'A';
+  if (code == '*') return 26;
+
+  return -1;
 }
 
-bool ChipLibrary::IsChipValid(Chip& chip)
+const std::string_view ChipLibrary::GetCodes()
 {
-  for (auto i = Begin(); i != End(); i++) {
-    if (i->GetShortName() == chip.GetShortName() && i->GetCode() == chip.GetCode()) {
-      return true;
-    }
+  return "*ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+}
+
+const ChipRecord* ChipLibrary::FindRecord(std::string_view name) const
+{
+  auto iter = byName.find(name);
+  return iter == byName.end() ? nullptr : iter->second;
+}
+
+const std::vector<const ChipRecord*>& ChipLibrary::GetRecordsWithElement(Element element) const
+{
+  static const std::vector<const ChipRecord*> none;
+
+  int index = static_cast<int>(element);
+  if (index < 0 || index >= static_cast<int>(Element::SIZE)) return none;
+
+  return byElement[index];
+}
+
+const std::size_t ChipLibrary::GetRecordCount() const
+{
+  return records.size();
+}
+
+const ChipRecord& ChipLibrary::GetRecord(std::size_t index) const
+{
+  return records[index];
+}
+
+std::string_view ChipLibrary::Intern(const std::string& text)
+{
+  return *strings.insert(text).first;
+}
+
+bool ChipLibrary::Index(const Chip& chip)
+{
+  int bit = CodeBit(chip.GetCode());
+
+  auto iter = byName.find(chip.GetShortName());
+
+  if (iter != byName.end()) {
+    if (bit < 0) return false;
+
+    ChipRecord* record = const_cast<ChipRecord*>(iter->second);
+    record->codes |= (1u << bit);
+    record->copies[bit]++;
+
+    return true;
   }
 
-  return false;
+  ChipRecord record = {};
+  record.id = chip.GetID();
+  record.icon = chip.GetIconID();
+  record.damage = chip.GetDamage();
+  record.rarity = chip.GetRarity();
+  record.element = chip.GetElement();
+  record.name = Intern(chip.GetShortName());
+  record.description = Intern(chip.GetDescription());
+  record.verboseDescription = Intern(chip.GetVerboseDescription());
+  record.codes = bit >= 0 ? (1u << bit) : 0u;
+
+  if (bit >= 0) {
+    record.copies[bit] = 1;
+  }
+
+  records.push_back(record);
+
+  const ChipRecord* stored = &records.back();
+  byName.insert(std::make_pair(stored->name, stored));
+
+  int element = static_cast<int>(record.element);
+
+  if (element >= 0 && element < static_cast<int>(Element::SIZE)) {
+    byElement[element].push_back(stored);
+  }
+
+  return bit >= 0;
+}
+
+void ChipLibrary::AddChip(Chip chip)
+{
+  if (Index(chip)) {
+    size++;
+  }
+
+  revision++;
+}
+
+bool ChipLibrary::IsChipValid(Chip& chip)
+{
+  const ChipRecord* record = FindRecord(chip.GetShortName());
+  return record && record->HasCode(chip.GetCode());
 }
 
 std::list<char> ChipLibrary::GetChipCodes(const Chip& chip)
 {
   std::list<char> codes;
 
-  for (auto i = Begin(); i != End(); i++) {
-    if (i->GetShortName() == chip.GetShortName()) {
-      codes.insert(codes.begin(), i->GetCode());
-    }
+  const ChipRecord* record = FindRecord(chip.GetShortName());
+  if (!record) return codes;
+
+  for (char code : GetCodes()) {
+    if (record->HasCode(code)) codes.push_back(code);
   }
 
   return codes;
@@ -156,99 +256,84 @@ std::list<char> ChipLibrary::GetChipCodes(const Chip& chip)
 
 const int ChipLibrary::GetCountOf(const Chip & chip)
 {
-  return int(library.count(chip));
+  const ChipRecord* record = FindRecord(chip.GetShortName());
+  return record ? int(record->CountOf(chip.GetCode())) : 0;
 }
 
 Chip ChipLibrary::GetChipEntry(const std::string name, const char code)
 {
-  for (auto i = Begin(); i != End(); i++) {
-    if (i->GetShortName() == name && i->GetCode() == code) {
-      return (*i);
-    }
+  const ChipRecord* record = FindRecord(name);
+
+  if (record && record->HasCode(code)) {
+    return record->MakeChip(code);
   }
 
   return Chip(0, 0, code, 0, Element::NONE, name, "missing data", "This chip data could not be interpreted. It may come from another library and has not been configured properly to be used.", 1);
 }
 
-void ChipLibrary::LoadLibrary(const std::string& path) {
-  string data = FileUtil::Read(path);
-
-  int endline = 0;
-
-  do {
-    endline = (int)data.find("\n");
-    string line = data.substr(0, endline);
+void ChipLibrary::Reload(const std::string& path) {
+  size = 0;
+  revision++;
+  byName.clear();
+  records.clear();
+  strings.clear();
 
-    while (line.compare(0, 1, " ") == 0)
-      line.erase(line.begin()); // remove leading whitespaces
-    while (line.size() > 0 && line.compare(line.size() - 1, 1, " ") == 0)
-      line.erase(line.end() - 1); // remove trailing whitespaces
+  for (auto& list : byElement) {
+    list.clear();
+  }
 
-    if (line[0] == '#') {
-      // Skip comments
-      data = data.substr(endline + 1);
-      continue;
-    }
+  LoadLibrary(path);
+}
 
-    if (line.find("Chip") != string::npos) {
-      string cardID = FileUtil::ValueOf("cardIndex", line);
-      string iconID = FileUtil::ValueOf("iconIndex", line);
-      string name   = FileUtil::ValueOf("name", line);
-      string damage = FileUtil::ValueOf("damage", line);
-      string type = FileUtil::ValueOf("type", line);
-      string codes = FileUtil::ValueOf("codes", line);
-      string description = FileUtil::ValueOf("desc", line);
-      string rarity = FileUtil::ValueOf("rarity", line);
+void ChipLibrary::LoadLibrary(const std::string& path) {
+  string data = FileUtil::Read(path);
+  KeyValueReader reader(data, path);
 
-      string longDescription;
+  while (reader.Next()) {
+    if (reader.GetTag() != "Chip") continue;
 
-      try {
-        longDescription = FileUtil::ValueOf("verbose", line);
-      }
-      catch (...) {
-        longDescription = "This chip does not have extra information.";
-      }
+    unsigned errors = reader.GetErrorCount();
 
-      // Trime white space
-      codes.erase(remove_if(codes.begin(), codes.end(), isspace), codes.end());
+    int cardID = KeyValueReader::ToInt(reader.Require("cardIndex"));
+    int iconID = KeyValueReader::ToInt(reader.Require("iconIndex"));
+    string name = KeyValueReader::ToString(reader.Require("name"));
+    int damage = KeyValueReader::ToInt(reader.Require("damage"));
+    string type = KeyValueReader::ToString(reader.Require("type"));
+    std::string_view codes = reader.Require("codes");
+    string description = KeyValueReader::ToString(reader.Require("desc"));
+    int rarity = KeyValueReader::ToInt(reader.Require("rarity"));
+    string longDescription = KeyValueReader::ToString(reader.Get("verbose", "This chip does not have extra information."));
 
-      // Tokenize the string with delimeter as ','
-      std::istringstream codeStream(codes);
-      string code;
+    // Missing fields were logged with the line number. Skip the chip.
+    if (reader.GetErrorCount() != errors) continue;
 
-      while (std::getline(codeStream, code, ',')) {
-        // For every code, push this into our database
-        if (code.empty())
-          continue;
+    Element elemType = GetElementFromStr(type);
 
-        Element elemType = GetElementFromStr(type);
+    // codes is a comma separated list. The first non-space character of each entry is the code.
+    std::size_t start = 0;
 
-        Chip chip = Chip(atoi(cardID.c_str()), atoi(iconID.c_str()), code[0], atoi(damage.c_str()), elemType, name, description, longDescription, atoi(rarity.c_str()));
-        std::list<char> codes = this->GetChipCodes(chip);
+    while (start <= codes.size()) {
+      std::size_t end = codes.find(',', start);
+      if (end == std::string_view::npos) end = codes.size();
 
-        /* Avoid code duplicates
-        if (codes.size() > 0) {
-          bool found = (std::find(codes.begin(), codes.end(), chip.GetCode()) != codes.end());
+      for (std::size_t i = start; i < end; i++) {
+        if (isspace(static_cast<unsigned char>(codes[i]))) continue;
 
-          // Not a duplicate code, make sure information is correct
-          if (!found) {
-            // Simply update an existing chip entry by changing the code 
-            Chip first = GetChipEntry(chip.GetShortName(), *codes.begin());
-            chip = Chip(first.GetID(), first.GetIconID(), chip.GetCode(), first.GetDamage(), first.GetElement(), first.GetShortName(), first.GetDescription(), first.GetVerboseDescription(), first.GetRarity());
-            library.insert(chip);
-          }
+        // For every code, push this into our database
+        if (CodeBit(codes[i]) < 0) {
+          reader.Error(std::string("Unsupported chip code '") + codes[i] + "'");
+          break;
         }
-        else { // first entry
-           library.insert(chip);
-        }*/
-        library.insert(chip);
+
+        AddChip(Chip(cardID, iconID, codes[i], damage, elemType, name, description, longDescription, rarity));
+        break;
       }
-    }
 
-    data = data.substr(endline + 1);
-  } while (endline > -1);
+      start = end + 1;
+    }
+  }
 
-  Logger::Log(std::string("library size: ") + std::to_string(this->GetSize()));
+  LOG_INFO(CHIPS, "library size: %u (%i chips)", GetSize(), (int)records.size());
 }
 
 const bool ChipLibrary::SaveLibrary(const std::string& path) {
@@ -259,7 +344,7 @@ const bool ChipLibrary::SaveLibrary(const std::string& path) {
    */
 
   try {
-    FileUtil::WriteStream ws(path);
+    std::ostringstream ws;
     auto time = std::time(nullptr);
     auto timestamp = std::put_time(std::localtime(&time), "%y-%m-%d %OH:%OM:%OS");
 
@@ -267,43 +352,46 @@ const bool ChipLibrary::SaveLibrary(const std::string& path) {
     ss << timestamp;
     std::string timestampStr = ss.str();
 
-    ws << "# Saved on " << timestampStr << ws.endl();
+    ws << "# Saved on " << timestampStr << '\n';
 
-    for (auto& chip : library) {
-      ws << "Chip name=\"" << chip.GetShortName() << "\" cardIndex=\""
-         << std::to_string(chip.GetID()) << "\" ";
-      ws << "iconIndex=\"" << std::to_string(chip.GetIconID()) << "\" damage=\""
-         << std::to_string(chip.GetDamage()) << "\" ";
-      ws << "type=\"" << ChipLibrary::GetStrFromElement(chip.GetElement()) << "\" ";
+    // Write one line per chip. Codes repeat once for every copy in the pool.
+    for (const ChipRecord& record : records) {
+      // Chips added with only unsupported codes have nothing to save
+      if (record.codes == 0) continue;
 
-      auto codes = ChipLibrary::GetChipCodes(chip);
+      ws << "Chip name=\"" << record.name << "\" cardIndex=\""
+         << std::to_string(record.id) << "\" ";
+      ws << "iconIndex=\"" << std::to_string(record.icon) << "\" damage=\""
+         << std::to_string(record.damage) << "\" ";
+      ws << "type=\"" << ChipLibrary::GetStrFromElement(record.element) << "\" ";
 
       ws << "codes=\"";
 
-      ws << chip.GetCode();
-
-      /*unsigned i = 0;
-      for (auto code : codes) {
-        ws << code;
-        i++;
+      bool first = true;
 
-        if (i != codes.size() - 1) ws << ",";
-      }*/
+      for (char code : GetCodes()) {
+        for (unsigned i = record.CountOf(code); i > 0; i--) {
+          if (!first) ws << ",";
+          ws << code;
+          first = false;
+        }
+      }
 
       ws << "\" ";
 
-      ws << "desc=\"" << chip.GetDescription() << "\" ";
-      ws << "verbose=\""<< chip.GetVerboseDescription() << "\" ";
-      ws << "rarity=\"" << std::to_string(chip.GetRarity()) << "\" ";
+      ws << "desc=\"" << record.description << "\" ";
+      ws << "verbose=\""<< record.verboseDescription << "\" ";
+      ws << "rarity=\"" << std::to_string(record.rarity) << "\" ";
 
-      ws << ws.endl();
+      ws << '\n';
     }
 
-    Logger::Log(std::string("library saved successfully. Number of chips saved: ") +
-                std::to_string(this->GetSize()));
+    SAVES.Save(path, ws.str());
+
+    LOG_INFO(CHIPS, "library queued for saving. Number of chips saved: %u", GetSize());
     return true;
   } catch(std::exception& e) {
-    Logger::Log(std::string("library save failed. Reason: ") + e.what());
+    LOG_ERROR(CHIPS, "library save failed. Reason: %s", e.what());
   }
 
   return false;
@@ -1,9 +1,53 @@
 #pragma once
 #include "bnChip.h"
-#include <set>
 #include <list>
+#include <deque>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
 
-using std::multiset;
+/**
+ * @struct ChipRecord
+ * @brief One chip in the library and every code it comes in
+ *
+ * Strings point into the library's string pool and live as long as the library
+ */
+struct ChipRecord {
+  unsigned id;
+  unsigned icon;
+  unsigned damage;
+  unsigned rarity;
+  Element element;
+  std::string_view name;
+  std::string_view description;
+  std::string_view verboseDescription;
+  std::uint32_t codes; /*!< One bit per code. @see ChipLibrary::CodeBit() */
+  std::uint16_t copies[27]; /*!< Copies in the pool for each code bit */
+
+  /**
+   * @brief Query if the chip comes in a code
+   * @param code
+   * @return true if the code bit is set
+   */
+  const bool HasCode(char code) const;
+
+  /**
+   * @brief Query how many copies of a code are in the pool
+   * @param code
+   * @return copies or zero if the chip does not come in the code
+   */
+  const unsigned CountOf(char code) const;
+
+  /**
+   * @brief Make a chip for one of the codes
+   * @param code
+   * @return Chip
+   */
+  Chip MakeChip(char code) const;
+};
 
 /**
  * @class ChipLibrary
@@ -17,11 +61,14 @@ using std::multiset;
  * in-battle. 
  * 
  * Acts as the player's chip-pool
+ *
+ * Each chip name is stored once as a ChipRecord with a bitmask of its codes
+ * and how many copies of each code the pool holds.
+ * Lookups by name, by name and code, and by element are hashed so they do not
+ * depend on how many chips the library holds.
  */
 class ChipLibrary {
 public:
-  typedef multiset<Chip, Chip::Compare>::iterator Iter;
-
   /**
    * @brief Invokes LoadLibrary()
    */
@@ -35,23 +82,19 @@ public:
   static ChipLibrary & GetInstance();
 
   /**
-   * @brief list.begin()
-   * @return list<Chip>::iterator
-   */
-  Iter Begin();
-  
-  /**
-   * @brief list.end()
-   * @return list<Chip>::iterator
-   */
-  Iter End();
-  
-  /**
-   * @brief Count of number of loaded chips
+   * @brief Count of number of loaded chips. Every copy of every code counts.
    * @return const unsigned
    */
   const unsigned GetSize() const;
 
+  /**
+   * @brief Query how many times the library has changed
+   * @return number that goes up whenever chips are added or the library is reloaded
+   *
+   * Views over the library compare this to know when to rebuild
+   */
+  const unsigned GetRevision() const;
+
   /**
    * @brief Given input string, returns Element enum equivalent
    * @return Element::NONE if non matching, otherwise returns enum of same name
@@ -64,9 +107,51 @@ public:
    */
   static const std::string GetStrFromElement(const Element);
 
+  /**
+   * @brief Bit used for a code in ChipRecord::codes
+   * @param code 'A' through 'Z' or '*'
+   * @return bit index or -1 if the code is not supported
+   */
+  static const int CodeBit(char code);
+
+  /**
+   * @brief Every supported code in the order the library lists them
+   * @return "*ABC...Z"
+   */
+  static const std::string_view GetCodes();
+
+  /**
+   * @brief Find the record for a chip name
+   * @param name exact chip name
+   * @return record or nullptr if there is no such chip
+   */
+  const ChipRecord* FindRecord(std::string_view name) const;
+
+  /**
+   * @brief Find every chip of an element
+   * @param element
+   * @return records in the order they were loaded
+   */
+  const std::vector<const ChipRecord*>& GetRecordsWithElement(Element element) const;
+
+  /**
+   * @brief Query the number of distinct chips
+   * @return record count
+   */
+  const std::size_t GetRecordCount() const;
+
+  /**
+   * @brief Get a record by index
+   * @param index less than GetRecordCount()
+   * @return ChipRecord
+   */
+  const ChipRecord& GetRecord(std::size_t index) const;
+
   /**
    * @brief Adds a chip directly into the library
    * @param chip entry to add to list
+   *
+   * Copies with an unsupported code are not counted
    */
   void AddChip(Chip chip);
   
@@ -102,12 +187,21 @@ public:
   * @brief Writes library to disc
   * @param path path to output file.
   * @warning will overwrite if path is already existing!
-  * @return true if successful, false otherwise
+  * @return true if the save was queued, false otherwise
   *
-  * Writes the library as-is at the time of writing
+  * Copies the library to text as-is at the time of the call.
+  * The file is written in the background by SaveService.
   */
   const bool SaveLibrary(const std::string& path);
 
+  /**
+  * @brief Throws away every chip and reads the library file again
+  * @param path to library database
+  *
+  * Chips already copied into folders and hands are not changed
+  */
+  void Reload(const std::string& path);
+
 protected:
  /**
   * @brief Reads in libary file and parses chip data
@@ -123,7 +217,26 @@ protected:
   void LoadLibrary(const std::string& path);
 
 private:
-  mutable multiset<Chip, Chip::Compare> library; /*!< the chip pool used by all chip resources */
+  /**
+   * @brief Add a copy of the chip's code to its record, making the record if this is a new chip
+   * @param chip
+   * @return true if the copy was counted
+   */
+  bool Index(const Chip& chip);
+
+  /**
+   * @brief Store a string once
+   * @param text
+   * @return view of the pooled copy
+   */
+  std::string_view Intern(const std::string& text);
+
+  std::size_t size; /*!< Copies of every chip in the pool */
+  unsigned revision; /*!< Incremented on every change */
+  std::deque<ChipRecord> records; /*!< One per chip name. A deque so pointers stay valid as chips are added. */
+  std::unordered_set<std::string> strings; /*!< Interned names and descriptions */
+  std::unordered_map<std::string_view, const ChipRecord*> byName; /*!< Chip name to record */
+  std::vector<const ChipRecord*> byElement[static_cast<int>(Element::SIZE)]; /*!< Element to records */
 };
 
 #define CHIPLIB ChipLibrary::GetInstance()
@@ -0,0 +1,229 @@
+#include "bnChipQuery.h"
+
+#include <algorithm>
+#include <numeric>
+#include <cassert>
+
+ChipQuery::ChipQuery(Group group) : group(group), sort(Sort::ID), revision(0), element(Element::SIZE), code('\0')
+{
+  Build();
+}
+
+void ChipQuery::Build()
+{
+  rows.clear();
+  byName.clear();
+
+  std::vector<const ChipRecord*> records;
+  records.reserve(CHIPLIB.GetRecordCount());
+
+  for (std::size_t i = 0; i < CHIPLIB.GetRecordCount(); i++) {
+    records.push_back(&CHIPLIB.GetRecord(i));
+  }
+
+  std::sort(records.begin(), records.end(), [](const ChipRecord* a, const ChipRecord* b) { return a->name < b->name; });
+
+  // Rows of a chip are next to each other in code order
+  for (const ChipRecord* record : records) {
+    for (char code : ChipLibrary::GetCodes()) {
+      unsigned count = record->CountOf(code);
+
+      if (count == 0) continue;
+
+      if (group == Group::CHIP && !rows.empty() && rows.back().record == record) {
+        rows.back().count += count;
+        continue;
+      }
+
+      if (byName.find(record->name) == byName.end()) {
+        byName.insert(std::make_pair(record->name, (unsigned)rows.size()));
+      }
+
+      rows.push_back(Row({ record, code, count }));
+    }
+  }
+
+  // Rows start in alphabetical order. Ties in every other key keep that order.
+  for (int key = 0; key < static_cast<int>(Sort::SIZE); key++) {
+    std::vector<unsigned>& index = order[key];
+
+    index.resize(rows.size());
+    std::iota(index.begin(), index.end(), 0u);
+
+    auto by = [this](auto value) {
+      return [this, value](unsigned a, unsigned b) { return value(rows[a]) < value(rows[b]); };
+    };
+
+    switch (static_cast<Sort>(key)) {
+    case Sort::ID:
+      std::stable_sort(index.begin(), index.end(), by([](const Row& row) { return row.record->id; }));
+      break;
+    case Sort::DAMAGE:
+      std::stable_sort(index.begin(), index.end(), by([](const Row& row) { return -(long long)row.record->damage; }));
+      break;
+    case Sort::ELEMENT:
+      std::stable_sort(index.begin(), index.end(), by([](const Row& row) { return static_cast<int>(row.record->element); }));
+      break;
+    case Sort::CODE:
+      std::stable_sort(index.begin(), index.end(), by([](const Row& row) { return ChipLibrary::CodeBit(row.code); }));
+      break;
+    case Sort::COUNT:
+      std::stable_sort(index.begin(), index.end(), by([](const Row& row) { return -(long long)row.count; }));
+      break;
+    default:
+      break;
+    }
+  }
+
+  revision = CHIPLIB.GetRevision();
+
+  Refilter(false);
+}
+
+bool ChipQuery::Refresh()
+{
+  if (revision == CHIPLIB.GetRevision()) return false;
+
+  Build();
+  return true;
+}
+
+void ChipQuery::SortBy(Sort key)
+{
+  if (key == Sort::SIZE || key == sort) return;
+
+  sort = key;
+  Refilter(false);
+}
+
+const ChipQuery::Sort ChipQuery::GetSort() const
+{
+  return sort;
+}
+
+const std::string ChipQuery::GetSortName(Sort key)
+{
+  switch (key) {
+  case Sort::ID:           return "ID";
+  case Sort::ALPHABETICAL: return "ABCDE";
+  case Sort::DAMAGE:       return "ATTACK";
+  case Sort::ELEMENT:      return "ELEMENT";
+  case Sort::CODE:         return "CODE";
+  case Sort::COUNT:        return "NO.";
+  default:                 return "";
+  }
+}
+
+void ChipQuery::FilterByElement(Element element)
+{
+  if (this->element == element) return;
+
+  bool narrow = this->element == Element::SIZE;
+  this->element = element;
+  Refilter(narrow);
+}
+
+void ChipQuery::FilterByCode(char code)
+{
+  if (this->code == code) return;
+
+  bool narrow = this->code == '\0';
+  this->code = code;
+  Refilter(narrow);
+}
+
+void ChipQuery::FilterByName(std::string_view text)
+{
+  if (name == text) return;
+
+  // Every name that contains the new text also contained the old text
+  bool narrow = text.find(name) != std::string_view::npos;
+  name = std::string(text);
+  Refilter(narrow);
+}
+
+void ChipQuery::ClearFilters()
+{
+  element = Element::SIZE;
+  code = '\0';
+  name.clear();
+  Refilter(false);
+}
+
+const std::size_t ChipQuery::GetSize() const
+{
+  return results.size();
+}
+
+const ChipQuery::Row& ChipQuery::At(std::size_t index) const
+{
+  assert(index < results.size());
+  return rows[results[index]];
+}
+
+Chip ChipQuery::MakeChip(std::size_t index) const
+{
+  const Row& row = At(index);
+  return row.record->MakeChip(row.code);
+}
+
+const int ChipQuery::IndexOf(std::string_view name, char code) const
+{
+  auto iter = byName.find(name);
+
+  if (iter == byName.end()) return -1;
+
+  unsigned row = iter->second;
+
+  if (group == Group::CODE) {
+    // A chip has at most one row per code and they are next to each other
+    while (row < rows.size() && rows[row].record == rows[iter->second].record && rows[row].code != code) {
+      row++;
+    }
+
+    if (row >= rows.size() || rows[row].record != rows[iter->second].record) return -1;
+  }
+
+  return position[row];
+}
+
+const bool ChipQuery::Passes(unsigned row) const
+{
+  const Row& data = rows[row];
+
+  if (element != Element::SIZE && data.record->element != element) return false;
+
+  if (code != '\0') {
+    if (group == Group::CODE ? data.code != code : !data.record->HasCode(code)) return false;
+  }
+
+  if (!name.empty() && data.record->name.find(name) == std::string_view::npos) return false;
+
+  return true;
+}
+
+void ChipQuery::Refilter(bool narrow)
+{
+  if (narrow) {
+    auto end = std::remove_if(results.begin(), results.end(), [this](unsigned row) {
+      if (Passes(row)) return false;
+
+      position[row] = -1;
+      return true;
+    });
+
+    results.erase(end, results.end());
+  }
+  else {
+    results.clear();
+    position.assign(rows.size(), -1);
+
+    for (unsigned row : order[static_cast<int>(sort)]) {
+      if (Passes(row)) results.push_back(row);
+    }
+  }
+
+  for (std::size_t i = 0; i < results.size(); i++) {
+    position[results[i]] = (int)i;
+  }
+}
@@ -0,0 +1,173 @@
+/*! \file bnChipQuery.h */
+
+/*! \brief Sorted and filtered view over the chip library for menus
+ *
+ * The library and folder edit screens list the player's chips and let them
+ * change the order. A query takes one snapshot of the library into rows and
+ * sorts the rows once for every key. Changing the sort key walks the presorted
+ * index for that key instead of sorting again.
+ *
+ * Filters hide rows without changing the indexes. A filter that only narrows
+ * the current results (e.g. typing more letters of a name) only looks at the
+ * rows that are already listed.
+ *
+ * Rows point into the chip library. Call Refresh() once a frame and the query
+ * rebuilds itself if the library changed.
+ */
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+#include "bnChipLibrary.h"
+
+class ChipQuery {
+public:
+  /**
+   * @brief Keys the results can be sorted by
+   */
+  enum class Sort : int {
+    ID = 0,
+    ALPHABETICAL,
+    DAMAGE,  /*!< Strongest first */
+    ELEMENT,
+    CODE,
+    COUNT, /*!< Most owned first */
+    SIZE
+  };
+
+  /**
+   * @brief What one row stands for
+   */
+  enum class Group : char {
+    CHIP, /*!< One row per chip name. Count is every copy in every code. */
+    CODE  /*!< One row per chip name and code */
+  };
+
+  /**
+   * @struct Row
+   * @brief One listed chip
+   */
+  struct Row {
+    const ChipRecord* record;
+    char code;      /*!< Code of the row. For Group::CHIP the first code owned. */
+    unsigned count; /*!< Copies in the library */
+  };
+
+  /**
+   * @brief Build the rows from the chip library sorted by ID
+   * @param group one row per chip or one row per code
+   */
+  ChipQuery(Group group);
+
+  /**
+   * @brief Take a new snapshot of the chip library. Keeps the sort and filters.
+   */
+  void Build();
+
+  /**
+   * @brief Rebuild if the chip library changed since the last build
+   * @return true if rebuilt
+   */
+  bool Refresh();
+
+  /**
+   * @brief Order the results by a key
+   * @param key
+   */
+  void SortBy(Sort key);
+
+  /**
+   * @brief Get the key the results are sorted by
+   * @return Sort
+   */
+  const Sort GetSort() const;
+
+  /**
+   * @brief Get the name of a key to show the player
+   * @param key
+   * @return e.g. "ABCDE" for Sort::ALPHABETICAL
+   */
+  static const std::string GetSortName(Sort key);
+
+  /**
+   * @brief Only list chips of one element
+   * @param element Element::SIZE lists every element
+   */
+  void FilterByElement(Element element);
+
+  /**
+   * @brief Only list chips that come in a code
+   * @param code '\0' lists every code
+   */
+  void FilterByCode(char code);
+
+  /**
+   * @brief Only list chips with names that contain some text. Case sensitive.
+   * @param text empty lists every name
+   */
+  void FilterByName(std::string_view text);
+
+  /**
+   * @brief List every row again
+   */
+  void ClearFilters();
+
+  /**
+   * @brief Query the number of rows that pass the filters
+   * @return result count
+   */
+  const std::size_t GetSize() const;
+
+  /**
+   * @brief Get a result by position
+   * @param index less than GetSize()
+   * @return Row
+   */
+  const Row& At(std::size_t index) const;
+
+  /**
+   * @brief Make a chip for a result
+   * @param index less than GetSize()
+   * @return Chip
+   */
+  Chip MakeChip(std::size_t index) const;
+
+  /**
+   * @brief Find where a chip is listed
+   * @param name chip name
+   * @param code ignored for Group::CHIP
+   * @return position in the results or -1 if it is not listed
+   */
+  const int IndexOf(std::string_view name, char code) const;
+
+private:
+  /**
+   * @brief Query if a row passes every filter
+   * @param row index into rows
+   * @return true if it should be listed
+   */
+  const bool Passes(unsigned row) const;
+
+  /**
+   * @brief Fill results from the rows
+   * @param narrow if true only the current results are checked
+   */
+  void Refilter(bool narrow);
+
+  Group group;
+  Sort sort;
+  unsigned revision; /*!< ChipLibrary revision the rows were built from */
+
+  std::vector<Row> rows;
+  std::vector<unsigned> order[static_cast<int>(Sort::SIZE)]; /*!< Row indexes sorted by each key */
+  std::unordered_map<std::string_view, unsigned> byName; /*!< Chip name to its first row */
+
+  std::vector<unsigned> results; /*!< Rows that pass the filters in sort order */
+  std::vector<int> position; /*!< Row to its place in results or -1 */
+
+  Element element; /*!< Element::SIZE if not filtered */
+  char code; /*!< '\0' if not filtered */
+  std::string name; /*!< Empty if not filtered */
+};
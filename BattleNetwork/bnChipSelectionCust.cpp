@@ -30,44 +30,40 @@ ChipSelectionCust::ChipSelectionCust(ChipFolder* _folder, int cap, int perTurn)
   emblem.setScale(2.f, 2.f);
   emblem.setPosition(194.0f, 14.0f);
 
-  custSprite = sf::Sprite(*TEXTURES.GetTexture(TextureType::CHIP_SELECT_MENU));
+  custSprite = sf::Sprite(HOLD_TEXTURE(textures, CHIP_SELECT_MENU));
   custSprite.setScale(2.f, 2.f);
   custSprite.setPosition(-custSprite.getTextureRect().width*2.f, 0);
 
   //this->AddSprite(custSprite);
 
-  icon.setTexture(*TEXTURES.GetTexture(CHIP_ICONS));
+  icon.setTexture(TEXTURES.LoadTexture(TextureType::CHIP_ICONS));
   icon.setScale(sf::Vector2f(2.f, 2.f));
 
-  sf::Texture* elementTexture = TEXTURES.GetTexture(TextureType::ELEMENT_ICON);
-  element.setTexture(*elementTexture);
+  element.setTexture(TEXTURES.LoadTexture(TextureType::ELEMENT_ICON));
   element.setScale(2.f, 2.f);
   element.setPosition(2.f*25.f, 146.f);
 
-  cursorSmall = sf::Sprite(*TEXTURES.GetTexture(TextureType::CHIP_CURSOR_SMALL));
+  cursorSmall = sf::Sprite(HOLD_TEXTURE(textures, CHIP_CURSOR_SMALL));
   cursorSmall.setScale(sf::Vector2f(2.f, 2.f));
 
-  cursorBig = sf::Sprite(*TEXTURES.GetTexture(TextureType::CHIP_CURSOR_BIG));
+  cursorBig = sf::Sprite(HOLD_TEXTURE(textures, CHIP_CURSOR_BIG));
   cursorBig.setScale(sf::Vector2f(2.f, 2.f));
 
   // never moves
   cursorBig.setPosition(sf::Vector2f(2.f*104.f, 2.f*122.f));
 
-  chipLock = sf::Sprite(LOAD_TEXTURE(CHIP_LOCK));
+  chipLock = sf::Sprite(HOLD_TEXTURE(textures, CHIP_LOCK));
   chipLock.setScale(sf::Vector2f(2.f, 2.f));
   
-  sf::Texture* card = TEXTURES.GetTexture(TextureType::CHIP_CARDS);
-  chipCard.setTexture(*card);
+  chipCard.setTexture(TEXTURES.LoadTexture(TextureType::CHIP_CARDS));
   chipCard.setScale(2.f, 2.f);
   chipCard.setPosition(2.f*16.f, 48.f);
 
-  sf::Texture* nodata = TEXTURES.GetTexture(TextureType::CHIP_NODATA);
-  chipNoData.setTexture(*nodata);
+  chipNoData.setTexture(TEXTURES.LoadTexture(TextureType::CHIP_NODATA));
   chipNoData.setScale(2.f, 2.f);
   chipNoData.setPosition(2.f*16.f, 48.f);
 
-  sf::Texture* senddata = TEXTURES.GetTexture(TextureType::CHIP_SENDDATA);
-  chipSendData.setTexture(*senddata);
+  chipSendData.setTexture(TEXTURES.LoadTexture(TextureType::CHIP_SENDDATA));
   chipSendData.setScale(2.f, 2.f);
   chipSendData.setPosition(2.f*16.f, 48.f);
 
@@ -101,11 +97,11 @@ ChipSelectionCust::ChipSelectionCust(ChipFolder* _folder, int cap, int perTurn)
   formSelectQuitTimer = 0.f; // used to time out the activation
   thisFrameSelectedForm = selectedForm = -1;
 
-  formItemBG.setTexture(LOAD_TEXTURE(CUST_FORM_ITEM_BG));
+  formItemBG.setTexture(HOLD_TEXTURE(textures, CUST_FORM_ITEM_BG));
   formItemBG.setScale(2.f, 2.f);
 
-  formSelect.setTexture(LOAD_TEXTURE(CUST_FORM_SELECT));
-  formCursor.setTexture(LOAD_TEXTURE(CUST_FORM_CURSOR));
+  formSelect.setTexture(TEXTURES.LoadTexture(TextureType::CUST_FORM_SELECT));
+  formCursor.setTexture(TEXTURES.LoadTexture(TextureType::CUST_FORM_CURSOR));
 
   formSelect.setScale(2.f, 2.f);
   formCursor.setScale(2.f, 2.f);
@@ -462,8 +458,11 @@ void ChipSelectionCust::SetPlayerFormOptions(const std::vector<PlayerFormMeta*>
 {
   for (auto f : forms) {
     this->forms.push_back(f);
+    TextureHandle texture = TEXTURES.LoadTexture(f->GetUIPath());
+    formUITextures.push_back(texture);
+
     sf::Sprite ui;
-    ui.setTexture(*TEXTURES.LoadTextureFromFile(f->GetUIPath()));
+    ui.setTexture(*texture);
     ui.setScale(2.f, 2.f);
     formUI.push_back(ui);
   }
@@ -62,6 +62,8 @@ private:
   int formCursorRow;
   int selectedForm, thisFrameSelectedForm;
   std::vector<sf::Sprite> formUI;
+  std::vector<TextureHandle> formUITextures; /*!< Keeps the formUI textures loaded */
+  std::vector<TextureHandle> textures; /*!< Keeps the sprite textures loaded */
   float formSelectQuitTimer;
   bool playFormSound;
 
@@ -171,7 +171,7 @@ public:
 
     Character* summonedBy = queue.GetCaller();
 
-    std::cout << "[" << summonedBy->GetName() << ", " << queue.GetChip().GetShortName() << ", " << queue.GetDuration() << "sec]" << std::endl;
+    LOG_DEBUG(BATTLE, "Summon %s by %s for %f secs", queue.GetChip().GetShortName().c_str(), summonedBy->GetName().c_str(), queue.GetDuration());
 
     std::string name = queue.GetChip().GetShortName();
 
@@ -315,7 +315,7 @@ public:
   void OnLeave() { 
     queue.Pop();
 
-    std::cout << "Summon onLeave [queue size is " << queue.Size() << "]" << std::endl;
+    LOG_DEBUG(BATTLE, "Summon left. %i summons queued", (int)queue.Size());
 
     for (auto items : summonedItems) {
       if (!items.persist) {
@@ -333,7 +333,7 @@ public:
   }
 
   void OnChipUse(Chip& chip, Character& character) {
-    std::cout << "on chips use " << chip.GetShortName() << " by " << character.GetName() << std::endl;
+    LOG_TRACE(BATTLE, "Chip %s used by %s", chip.GetShortName().c_str(), character.GetName().c_str());
     std::string name = chip.GetShortName();
 
     bool add = true;
@@ -378,7 +378,7 @@ public:
     summon.clear();
 
     if (add) {
-      std::cout << "[Summon queued]" << std::endl;
+      LOG_DEBUG(BATTLE, "Summon %s queued", chip.GetShortName().c_str());
       queue.Add(chip, character, duration);
     }
   }
@@ -0,0 +1,242 @@
+#include "bnCompiledAnimation.h"
+#include "bnAnimation.h"
+#include "bnFileUtil.h"
+#include "bnSaveService.h"
+#include "bnLogger.h"
+
+#include <cstring>
+#include <cstdint>
+#include <vector>
+
+namespace {
+  std::uint64_t HashText(const std::string& text) {
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for (char c : text) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ull;
+    }
+
+    return hash;
+  }
+
+  /**
+   * @brief Copies a table out of the file and moves the read position past it
+   * @return false if the table runs past the end of the file
+   */
+  template<typename T>
+  bool ReadTable(const std::string& bytes, std::size_t& offset, std::size_t count, std::vector<T>& table) {
+    // Checked this way so a corrupt count cannot wrap around
+    if (offset > bytes.size() || count > (bytes.size() - offset) / sizeof(T)) return false;
+
+    std::size_t length = count * sizeof(T);
+
+    table.resize(count);
+    if (length) std::memcpy(table.data(), bytes.data() + offset, length);
+    offset += length;
+
+    return true;
+  }
+
+  template<typename T>
+  void WriteTable(std::string& bytes, const std::vector<T>& table) {
+    if (table.empty()) return;
+    bytes.append(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(T));
+  }
+}
+
+std::string CompiledAnimation::CachePath(const std::string& path) {
+  std::string cache = path;
+  std::size_t ext = cache.rfind(ANIMATION_EXTENSION);
+
+  if (ext != std::string::npos && ext + std::strlen(ANIMATION_EXTENSION) == cache.size()) {
+    cache.erase(ext);
+  }
+
+  return cache + COMPILED_ANIMATION_EXTENSION;
+}
+
+bool CompiledAnimation::Load(const std::string& path, std::map<std::string, FrameList>& animations, std::string& text) {
+  std::string bytes = FileUtil::Read(CachePath(path));
+
+  if (bytes.size() < sizeof(Header)) return false;
+
+  Header header;
+  std::memcpy(&header, bytes.data(), sizeof(Header));
+
+  if (std::memcmp(header.magic, "OBNA", 4) != 0 || header.version != VERSION) return false;
+
+  long long modified = FileUtil::GetModifiedTime(path);
+  std::uint64_t size = static_cast<std::uint64_t>(FileUtil::GetSize(path));
+
+  if (header.sourceModified != modified || header.sourceSize != size) {
+    // Touched but maybe not changed. e.g. a fresh checkout
+    text = FileUtil::Read(path);
+
+    if (header.sourceHash != HashText(text)) return false;
+
+    header.sourceModified = modified;
+    header.sourceSize = size;
+    std::memcpy(&bytes[0], &header, sizeof(Header));
+
+    // Other loader workers may be reading the same cache file
+    if (FileUtil::Exists(path)) {
+      SaveService::WriteAtomic(CachePath(path), bytes);
+    }
+  }
+
+  if (!Decode(bytes, animations)) {
+    animations.clear();
+    return false;
+  }
+
+  return true;
+}
+
+bool CompiledAnimation::Decode(const std::string& bytes, std::map<std::string, FrameList>& animations) {
+  Header header;
+  std::memcpy(&header, bytes.data(), sizeof(Header));
+
+  std::size_t offset = sizeof(Header);
+
+  std::vector<std::uint32_t> stringOffsets;
+  std::vector<State> states;
+  std::vector<FrameData> frames;
+  std::vector<PointData> points;
+
+  // One more offset than strings marks where the last string ends. The count must not wrap on 32 bit builds.
+  if (header.stringCount == UINT32_MAX) return false;
+  if (!ReadTable(bytes, offset, static_cast<std::size_t>(header.stringCount) + 1, stringOffsets)) return false;
+
+  const char* stringData = bytes.data() + offset;
+  if (header.stringBytes > bytes.size() - offset) return false;
+  offset += header.stringBytes;
+
+  if (!ReadTable(bytes, offset, header.stateCount, states)) return false;
+  if (!ReadTable(bytes, offset, header.frameCount, frames)) return false;
+  if (!ReadTable(bytes, offset, header.pointCount, points)) return false;
+
+  std::vector<std::string> strings;
+  strings.reserve(header.stringCount);
+
+  for (std::uint32_t i = 0; i < header.stringCount; i++) {
+    std::uint32_t start = stringOffsets[i], end = stringOffsets[i + 1];
+    if (start > end || end > header.stringBytes) return false;
+    strings.emplace_back(stringData + start, end - start);
+  }
+
+  for (auto& state : states) {
+    if (state.name >= strings.size() || static_cast<std::size_t>(state.firstFrame) + state.frameCount > frames.size()) return false;
+
+    FrameList list;
+
+    for (std::uint32_t f = state.firstFrame; f < state.firstFrame + state.frameCount; f++) {
+      const FrameData& frame = frames[f];
+      sf::IntRect rect(frame.x, frame.y, frame.w, frame.h);
+
+      if (frame.applyOrigin) {
+        list.Add(frame.duration, rect, sf::Vector2f(frame.originX, frame.originY));
+      }
+      else {
+        list.Add(frame.duration, rect);
+      }
+
+      if (static_cast<std::size_t>(frame.firstPoint) + frame.pointCount > points.size()) return false;
+
+      for (std::uint32_t p = frame.firstPoint; p < frame.firstPoint + frame.pointCount; p++) {
+        if (points[p].name >= strings.size()) return false;
+        list.SetPoint(strings[points[p].name], points[p].x, points[p].y);
+      }
+    }
+
+    animations.insert(std::make_pair(strings[state.name], std::move(list)));
+  }
+
+  return true;
+}
+
+bool CompiledAnimation::Save(const std::string& path, const std::string& text, const std::map<std::string, FrameList>& animations) {
+  // Packed files have no directory to write next to
+  if (!FileUtil::Exists(path)) return false;
+
+  std::map<std::string, std::uint32_t> interned;
+  std::vector<std::uint32_t> stringOffsets;
+  std::string stringData;
+
+  auto intern = [&interned, &stringOffsets, &stringData](const std::string& value) {
+    auto iter = interned.find(value);
+    if (iter != interned.end()) return iter->second;
+
+    std::uint32_t index = static_cast<std::uint32_t>(stringOffsets.size());
+    stringOffsets.push_back(static_cast<std::uint32_t>(stringData.size()));
+    stringData += value;
+    interned.insert(std::make_pair(value, index));
+    return index;
+  };
+
+  std::vector<State> states;
+  std::vector<FrameData> frames;
+  std::vector<PointData> points;
+
+  for (auto& animation : animations) {
+    const FrameList& list = animation.second;
+
+    State state;
+    state.name = intern(animation.first);
+    state.firstFrame = static_cast<std::uint32_t>(frames.size());
+    state.frameCount = static_cast<std::uint32_t>(list.GetFrameCount());
+    states.push_back(state);
+
+    for (std::size_t i = 0; i < list.GetFrameCount(); i++) {
+      const Frame& frame = list.GetFrame(static_cast<int>(i));
+
+      FrameData data;
+      data.duration = frame.duration;
+      data.x = frame.subregion.left;
+      data.y = frame.subregion.top;
+      data.w = frame.subregion.width;
+      data.h = frame.subregion.height;
+      data.originX = frame.origin.x;
+      data.originY = frame.origin.y;
+      data.applyOrigin = frame.applyOrigin ? 1 : 0;
+      data.firstPoint = static_cast<std::uint32_t>(points.size());
+      data.pointCount = static_cast<std::uint32_t>(frame.points.size());
+      frames.push_back(data);
+
+      for (auto& point : frame.points) {
+        points.push_back(PointData{ intern(point.first), static_cast<std::int32_t>(point.second.x), static_cast<std::int32_t>(point.second.y) });
+      }
+    }
+  }
+
+  // Closing offset so each string's length is the next offset minus its own
+  stringOffsets.push_back(static_cast<std::uint32_t>(stringData.size()));
+
+  Header header;
+  std::memset(&header, 0, sizeof(Header));
+  std::memcpy(header.magic, "OBNA", 4);
+  header.version = VERSION;
+  header.sourceModified = FileUtil::GetModifiedTime(path);
+  header.sourceSize = static_cast<std::uint64_t>(FileUtil::GetSize(path));
+  header.sourceHash = HashText(text);
+  header.stringCount = static_cast<std::uint32_t>(stringOffsets.size() - 1);
+  header.stringBytes = static_cast<std::uint32_t>(stringData.size());
+  header.stateCount = static_cast<std::uint32_t>(states.size());
+  header.frameCount = static_cast<std::uint32_t>(frames.size());
+  header.pointCount = static_cast<std::uint32_t>(points.size());
+
+  std::string bytes(reinterpret_cast<const char*>(&header), sizeof(Header));
+  WriteTable(bytes, stringOffsets);
+  bytes += stringData;
+  WriteTable(bytes, states);
+  WriteTable(bytes, frames);
+  WriteTable(bytes, points);
+
+  // Loader threads compile in parallel. Readers must never see half a file.
+  if (!SaveService::WriteAtomic(CachePath(path), bytes)) {
+    LOG_WARN(CONTENT, "Could not write compiled animation for %s", path.c_str());
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,121 @@
+/*! \file bnCompiledAnimation.h */
+
+/*! \brief Binary form of .animation files that loads without parsing
+ *
+ * Parsing the text format is slow for the larger navi sheets. The first time
+ * a file is parsed its frame lists are written next to it as a compiled
+ * .animationc file. Later loads read that file in one go and rebuild the frame
+ * lists straight from its tables.
+ *
+ * The compiled file remembers the modified time, size and hash of the text
+ * it came from. If the time or size changed the text is hashed again, and
+ * only when the hash differs is the text parsed and the cache rewritten.
+ *
+ * Compiled files use the native byte order. They are a local cache and are not
+ * meant to be shipped.
+ *
+ * Layout:
+ *
+ * | Header | uint32 string offsets[stringCount + 1] | string bytes | State[] | FrameData[] | PointData[] |
+ *
+ * State names and point labels are interned in the string table.
+ */
+#pragma once
+#include <string>
+#include <map>
+#include <cstdint>
+
+#include "bnAnimator.h"
+
+#define COMPILED_ANIMATION_EXTENSION ".animationc"
+
+class CompiledAnimation {
+public:
+  /**
+   * @struct Header
+   * @brief Start of every compiled animation file
+   */
+  struct Header {
+    char magic[4]; /*!< "OBNA" */
+    std::uint32_t version;
+    std::int64_t sourceModified; /*!< FileUtil::GetModifiedTime() of the text file */
+    std::uint64_t sourceSize; /*!< Size of the text file */
+    std::uint64_t sourceHash; /*!< FNV-1a hash of the text */
+    std::uint32_t stringCount;
+    std::uint32_t stringBytes;
+    std::uint32_t stateCount;
+    std::uint32_t frameCount;
+    std::uint32_t pointCount;
+    std::uint32_t reserved;
+  };
+
+  /**
+   * @struct State
+   * @brief One animation state and the range of frames it owns
+   */
+  struct State {
+    std::uint32_t name; /*!< String index */
+    std::uint32_t firstFrame;
+    std::uint32_t frameCount;
+  };
+
+  /**
+   * @struct FrameData
+   * @brief One frame and the range of points it owns
+   */
+  struct FrameData {
+    float duration;
+    std::int32_t x, y, w, h;
+    float originX, originY;
+    std::uint32_t applyOrigin;
+    std::uint32_t firstPoint;
+    std::uint32_t pointCount;
+  };
+
+  /**
+   * @struct PointData
+   * @brief A named point on a frame
+   */
+  struct PointData {
+    std::uint32_t name; /*!< String index */
+    std::int32_t x, y;
+  };
+
+  static const std::uint32_t VERSION = 2;
+
+  /**
+   * @brief Path of the compiled file for an animation file
+   * @param path path to the .animation file
+   * @return path with the compiled extension
+   */
+  static std::string CachePath(const std::string& path);
+
+  /**
+   * @brief Load the compiled frame lists for an animation file if they are up to date
+   * @param path path to the .animation file
+   * @param animations filled with the frame lists on success
+   * @param text set to the contents of the text file if it had to be read
+   * @return true if the cache was used. If false, parse the text and call Save()
+   */
+  static bool Load(const std::string& path, std::map<std::string, FrameList>& animations, std::string& text);
+
+  /**
+   * @brief Write the compiled frame lists next to the animation file
+   * @param path path to the .animation file
+   * @param text contents of the text file that was parsed
+   * @param animations parsed frame lists
+   * @return true if the cache was written
+   *
+   * Nothing is written for files that only exist in the resource archive
+   */
+  static bool Save(const std::string& path, const std::string& text, const std::map<std::string, FrameList>& animations);
+
+private:
+  /**
+   * @brief Rebuild the frame lists from the tables
+   * @param bytes the whole compiled file
+   * @param animations filled with the frame lists
+   * @return false if the tables are inconsistent
+   */
+  static bool Decode(const std::string& bytes, std::map<std::string, FrameList>& animations);
+};
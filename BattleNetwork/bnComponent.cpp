@@ -1,3 +1,3 @@
 #include "bnComponent.h"
 
-long Component::numOfComponents = 0;
\ No newline at end of file
+std::atomic<long> Component::numOfComponents{0};
\ No newline at end of file
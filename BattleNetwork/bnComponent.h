@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 
 class Entity;
 class BattleScene;
@@ -15,7 +16,7 @@ class BattleScene;
 class Component {
 private:
   Entity* owner; /*!< Who the component is attached to */
-  static long numOfComponents; /*!< Resource counter to generate new IDs */
+  static std::atomic<long> numOfComponents; /*!< Resource counter to generate new IDs */
   long ID; /*!< ID for quick lookups, resource management, and scripting */
 
 public:
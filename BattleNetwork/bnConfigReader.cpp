@@ -1,19 +1,6 @@
 #include "bnConfigReader.h"
 #include "bnInputManager.h"
 
-void ConfigReader::Trim(std::string& line) {
-  while (line.compare(0, 1, " ") == 0)
-    line.erase(line.begin()); // remove leading whitespaces
-  while (line.size() > 0 && line.compare(line.size() - 1, 1, " ") == 0)
-    line.erase(line.end() - 1); // remove trailing whitespaces
-}
-
-std::string ConfigReader::ValueOf(std::string _key, std::string _line) {
-  int keyIndex = (int)_line.find(_key);
-  std::string s = _line.substr(keyIndex + _key.size() + 2);
-  return s.substr(0, s.find("\""));
-}
-
 Gamepad ConfigReader::GetGamepadCode(int key) {
 
   return (Gamepad)key;
@@ -25,169 +12,155 @@ sf::Keyboard::Key ConfigReader::GetKeyCodeFromAscii(int ascii) {
 
 // Parsing
 
-const bool ConfigReader::Parse(std::string buffer) {
-  return ParseDiscord(buffer);
+const bool ConfigReader::Parse(const std::string& buffer, const std::string& source) {
+  KeyValueReader reader(buffer, source, KeyValueReader::Style::ini);
+  return ParseDiscord(reader);
 }
 
-const bool ConfigReader::ParseDiscord(std::string buffer) {
-  int endline = 0;
-
-  do {
-    endline = (int)buffer.find("\n");
-    std::string line = buffer.substr(0, endline);
+const bool ConfigReader::ParseDiscord(KeyValueReader& reader) {
+  std::string_view key, value;
 
-    Trim(line);
+  while (reader.Next()) {
+    if (reader.IsSection()) {
+      if (reader.GetTag() == "Audio") {
+        return ParseAudio(reader);
+      }
 
-    if (line.find("[Audio]") != std::string::npos) {
-      return ParseAudio(buffer);
+      continue;
     }
 
-    if (line.find("User") != std::string::npos) {
-      std::string value = ValueOf("User", line);
-      settings.discord.user = value;
-    }
+    if (!reader.NextAttribute(key, value)) continue;
 
-    if (line.find("Key") != std::string::npos) {
-      std::string value = ValueOf("Key", line);
-      settings.discord.key = value;
+    if (key == "User") {
+      settings.discord.user = KeyValueReader::ToString(value);
     }
-
-    // Read next line...
-    buffer = buffer.substr(endline + 1);
-  } while (endline > -1);
+    else if (key == "Key") {
+      settings.discord.key = KeyValueReader::ToString(value);
+    }
+  }
 
   return false;
 }
 
-const bool ConfigReader::ParseAudio(std::string buffer) {
-  int endline = 0;
+const bool ConfigReader::ParseAudio(KeyValueReader& reader) {
+  std::string_view key, value;
 
-  do {
-    endline = (int)buffer.find("\n");
-    std::string line = buffer.substr(0, endline);
+  while (reader.Next()) {
+    if (reader.IsSection()) {
+      if (reader.GetTag() == "Net") {
+        return ParseNet(reader);
+      }
 
-    Trim(line);
+      continue;
+    }
+
+    if (!reader.NextAttribute(key, value)) continue;
 
-    if (line.find("[Net]") != std::string::npos) {
-      return ParseNet(buffer);
+    if (key == "Music") {
+      settings.musicLevel = KeyValueReader::ToInt(value);
     }
-    else if (line.find("Music") != std::string::npos) {
-      std::string enabledStr = ValueOf("Music", line);
-      settings.musicLevel = std::atoi(enabledStr.c_str());
+    else if (key == "SFX") {
+      settings.sfxLevel = KeyValueReader::ToInt(value);
     }
-    else if (line.find("SFX") != std::string::npos) {
-      std::string enabledStr = ValueOf("SFX", line);
-      settings.sfxLevel = std::atoi(enabledStr.c_str());
+    else if (key == "Voices Per Frame") {
+      settings.voicesPerFrame = KeyValueReader::ToInt(value);
     }
-
-    // Read next line...
-    buffer = buffer.substr(endline + 1);
-  } while (endline > -1);
+  }
 
   return false;
 }
 
-const bool ConfigReader::ParseNet(std::string buffer) {
-  int endline = 0;
-
-  do {
-    endline = (int)buffer.find("\n");
-    std::string line = buffer.substr(0, endline);
-
-    Trim(line);
-
-    if (line.find("[Video]") != std::string::npos) {
-      return ParseVideo(buffer);
+const bool ConfigReader::ParseNet(KeyValueReader& reader) {
+  while (reader.Next()) {
+    if (reader.IsSection() && reader.GetTag() == "Video") {
+      return ParseVideo(reader);
     }
 
     // NOTE: networking will not be a feature for some time...
-
-    // Read next line...
-    buffer = buffer.substr(endline + 1);
-  } while (endline > -1);
+  }
 
   return false;
 }
 
-const bool ConfigReader::ParseVideo(std::string buffer) {
-  int endline = 0;
-
-  do {
-    endline = (int)buffer.find("\n");
-    std::string line = buffer.substr(0, endline);
-
-    Trim(line);
-
-    if (line.find("[Keyboard]") != std::string::npos) {
-      return ParseKeyboard(buffer);
+const bool ConfigReader::ParseVideo(KeyValueReader& reader) {
+  while (reader.Next()) {
+    if (reader.IsSection() && reader.GetTag() == "Keyboard") {
+      return ParseKeyboard(reader);
     }
 
     // TODO: handle video settings
-
-    // Read next line...
-    buffer = buffer.substr(endline + 1);
-  } while (endline > -1);
+  }
 
   return false;
 }
 
-const bool ConfigReader::ParseKeyboard(std::string buffer) {
-  int endline = 0;
-
-  do {
-    endline = (int)buffer.find("\n");
-    std::string line = buffer.substr(0, endline);
+const bool ConfigReader::ParseKeyboard(KeyValueReader& reader) {
+  std::string_view key, value;
 
-    Trim(line);
+  while (reader.Next()) {
+    if (reader.IsSection()) {
+      if (reader.GetTag() == "Gamepad") {
+        return ParseGamepad(reader);
+      }
 
-    if (line.find("[Gamepad]") != std::string::npos) {
-      return ParseGamepad(buffer);
+      continue;
     }
 
+    if (!reader.NextAttribute(key, value)) continue;
 
-    for (auto key : EventTypes::KEYS) {
-      if (line.find(key) != std::string::npos) {
-        std::string value = ValueOf(key, line);
-        auto code = GetKeyCodeFromAscii(std::atoi(value.c_str()));
+    for (auto& event : EventTypes::KEYS) {
+      if (key == event) {
+        auto code = GetKeyCodeFromAscii(KeyValueReader::ToInt(value));
 
-        settings.keyboard.insert(std::make_pair(code, key));
+        settings.keyboard.insert(std::make_pair(code, event));
       }
     }
-
-    // Read next line...
-    buffer = buffer.substr(endline + 1);
-  } while (endline > -1);
+  }
 
   return false;
 }
 
 
-const bool ConfigReader::ParseGamepad(std::string buffer) {
-  int endline = 0;
+const bool ConfigReader::ParseGamepad(KeyValueReader& reader) {
+  std::string_view key, value;
+
+  while (reader.Next()) {
+    if (reader.IsSection()) {
+      if (reader.GetTag() == "Log") {
+        return ParseLog(reader);
+      }
 
-  do {
-    endline = (int)buffer.find("\n");
-    std::string line = buffer.substr(0, endline);
+      continue;
+    }
 
-    Trim(line);
+    if (!reader.NextAttribute(key, value)) continue;
 
-    for (auto key : EventTypes::KEYS) {
-      if (line.find(key) != std::string::npos) {
-        std::string value = ValueOf(key, line);
-        settings.gamepad.insert(std::make_pair(GetGamepadCode(std::atoi(value.c_str())), key));
+    for (auto& event : EventTypes::KEYS) {
+      if (key == event) {
+        settings.gamepad.insert(std::make_pair(GetGamepadCode(KeyValueReader::ToInt(value)), event));
       }
     }
-
-    // Read next line...
-    buffer = buffer.substr(endline + 1);
-  } while (endline > -1);
+  }
 
   // We've come to the end of the config file with all expected headers
   return true;
 }
 
+const bool ConfigReader::ParseLog(KeyValueReader& reader) {
+  std::string_view key, value;
+
+  while (reader.Next()) {
+    if (reader.IsSection() || !reader.NextAttribute(key, value)) continue;
+
+    // Names are checked when they are applied with Logger::Configure()
+    settings.logLevels[std::string(key)] = KeyValueReader::ToString(value);
+  }
+
+  return true;
+}
+
 ConfigReader::ConfigReader(std::string filepath) {
-  settings.isOK = Parse(FileUtil::Read(filepath));
+  settings.isOK = Parse(FileUtil::Read(filepath), filepath);
 
   // We need SOME values
   // Provide default layout
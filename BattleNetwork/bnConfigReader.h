@@ -2,6 +2,7 @@
 #include <map>
 #include "bnInputEvent.h"
 #include "bnFileUtil.h"
+#include "bnKeyValueReader.h"
 #include "bnConfigSettings.h"
 /*
 Example file contents
@@ -51,20 +52,6 @@ class ConfigReader {
 private:
   ConfigSettings settings;
 
-  /**
-   * @brief Aux function. Trim leading and trailing whitespaces
-   * @param line string to modifiy
-   */
-  void Trim(std::string& line);
-
-  /**
-   * @brief Aux function. Given a key in a line, find the value.
-   * @param _key
-   * @param _line
-   * @return value
-   */
-  std::string ValueOf(std::string _key, std::string _line);
-
   /**
    * @brief Deprecated. 
    * @param key
@@ -83,61 +70,71 @@ private:
   /**
    * @brief Parse entire file contents
    * @param buffer file contents
+   * @param source file path for error messages
    * @return true if entire file is good
    */
-  const bool Parse(std::string buffer);
+  const bool Parse(const std::string& buffer, const std::string& source);
 
   /**
    * @brief File begins with [Discord] and settings
-   * @param buffer file contents
+   * @param reader at the start of the file
    * @return true if rest of contents are good, false if malformed
    * 
    * Expects [Audio] to be next
    */
-  const bool ParseDiscord(std::string buffer);
+  const bool ParseDiscord(KeyValueReader& reader);
 
   /**
    * @brief Parse [Audio] 
-   * @param buffer file contents
+   * @param reader positioned after the section header
    * @return true if file is good, false if malformed
    * 
    * expects [Net] to be next
    */
-  const bool ParseAudio(std::string buffer);
+  const bool ParseAudio(KeyValueReader& reader);
 
   /**
    * @brief Parse [Net] and settings
-   * @param buffer file contents
+   * @param reader positioned after the section header
    * @return true if file is good, false if malformed
    * 
    * Expects [Video] to be next
    */
-  const bool ParseNet(std::string buffer);
+  const bool ParseNet(KeyValueReader& reader);
 
   /**
    * @brief Parses [Video] and settings
-   * @param buffer file contents
+   * @param reader positioned after the section header
    * @return true if good, false if malformed
    * 
    * expects [Keyboard] to be next
    */
-  const bool ParseVideo(std::string buffer);
+  const bool ParseVideo(KeyValueReader& reader);
 
   /**
    * @brief Parse [Keyboard] and settings
-   * @param buffer file contents
+   * @param reader positioned after the section header
    * @return true if the file is ok, false otherwise
    * 
    * expects [Gamepad] next
    */
-  const bool ParseKeyboard(std::string buffer);
+  const bool ParseKeyboard(KeyValueReader& reader);
 
   /**
    * @brief Parses [Gamepad] and settings
-   * @param buffer file contents
+   * @param reader positioned after the section header
+   * @return true and denotes end of file
+   *
+   * [Log] may follow
+   */
+  const bool ParseGamepad(KeyValueReader& reader);
+
+  /**
+   * @brief Parses the optional [Log] section
+   * @param reader positioned after the section header
    * @return true and denotes end of file
    */
-  const bool ParseGamepad(std::string buffer);
+  const bool ParseLog(KeyValueReader& reader);
 
 public:
 
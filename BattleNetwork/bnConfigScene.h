@@ -50,6 +50,7 @@ private:
   Background* bg;
 
   sf::Sprite uiSprite;
+  std::vector<TextureHandle> textures; /*!< Keeps the sprite textures loaded while the scene is alive */
 
   struct uiData {
     std::string label;
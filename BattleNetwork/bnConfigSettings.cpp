@@ -33,6 +33,21 @@ void ConfigSettings::SetSFXLevel(int level)
   sfxLevel = level;
 }
 
+const int ConfigSettings::GetVoicesPerFrame()
+{
+  return voicesPerFrame;
+}
+
+void ConfigSettings::SetVoicesPerFrame(int count)
+{
+  voicesPerFrame = count;
+}
+
+const std::map<std::string, std::string>& ConfigSettings::GetLogLevels() const
+{
+  return logLevels;
+}
+
 const std::list<std::string> ConfigSettings::GetPairedActions(sf::Keyboard::Key event) {
   std::list<std::string> list;
 
@@ -110,6 +125,8 @@ ConfigSettings & ConfigSettings::operator=(ConfigSettings rhs)
   this->gamepad = rhs.gamepad;
   this->musicLevel = rhs.musicLevel;
   this->sfxLevel = rhs.sfxLevel;
+  this->voicesPerFrame = rhs.voicesPerFrame;
+  this->logLevels = rhs.logLevels;
   this->isOK = rhs.isOK;
   this->keyboard = rhs.keyboard;
   return *this;
@@ -137,6 +154,8 @@ ConfigSettings::ConfigSettings(const ConfigSettings & rhs)
   this->gamepad = rhs.gamepad;
   this->musicLevel = rhs.musicLevel;
   this->sfxLevel = rhs.sfxLevel;
+  this->voicesPerFrame = rhs.voicesPerFrame;
+  this->logLevels = rhs.logLevels;
   this->isOK = rhs.isOK;
   this->keyboard = rhs.keyboard;
 }
@@ -144,4 +163,5 @@ ConfigSettings::ConfigSettings(const ConfigSettings & rhs)
 ConfigSettings::ConfigSettings()
 {
   isOK = false;
+  voicesPerFrame = 0;
 }
@@ -37,6 +37,19 @@ public:
   const int GetSFXLevel();
   void SetMusicLevel(int level);
   void SetSFXLevel(int level);
+
+  /**
+   * @brief How many new sounds may start on the same frame
+   * @return count or 0 to use the default
+   */
+  const int GetVoicesPerFrame();
+  void SetVoicesPerFrame(int count);
+
+  /**
+   * @brief Get the [Log] section
+   * @return "Level" or a log category name, to a level name. See Logger::Configure().
+   */
+  const std::map<std::string, std::string>& GetLogLevels() const;
   /**
    * @brief For a keyboard event, return the action string
    * @param event sfml keyboard key
@@ -85,6 +98,8 @@ private:
 
   int musicLevel;
   int sfxLevel;
+  int voicesPerFrame; /*!< 0 if not set */
+  std::map<std::string, std::string> logLevels; /*!< Empty if the file has no [Log] section */
 
   // State flags
   bool isOK; /*!< true if the file was ok */
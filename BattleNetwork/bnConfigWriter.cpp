@@ -18,6 +18,10 @@ void ConfigWriter::Write(std::string path)
   w << "[Audio]" << w.endl();
   w << "Music=" << "\"" << std::to_string(settings.GetMusicLevel()) <<  "\""<< w.endl();
   w << "SFX=" << "\"" << std::to_string(settings.GetSFXLevel()) <<  "\"" << w.endl();
+
+  if (settings.GetVoicesPerFrame() > 0) {
+    w << "Voices Per Frame=" << "\"" << std::to_string(settings.GetVoicesPerFrame()) << "\"" << w.endl();
+  }
   w << "[Net]" << w.endl();
   w << "uPNP=" << "\"0\"" << w.endl();
   w << "[Video]" << w.endl();
@@ -33,6 +37,14 @@ void ConfigWriter::Write(std::string path)
   for (auto a : EventTypes::KEYS) {
     w << a << "=" << "\"" << std::to_string(GetAsciiFromGamepad(settings.GetPairedGamepadButton(a))) << "\"" << w.endl();
   }
+
+  if (settings.GetLogLevels().size()) {
+    w << "[Log]" << w.endl();
+
+    for (auto& entry : settings.GetLogLevels()) {
+      w << entry.first << "=" << "\"" << entry.second << "\"" << w.endl();
+    }
+  }
 }
 
 int ConfigWriter::GetAsciiFromGamepad(Gamepad code)
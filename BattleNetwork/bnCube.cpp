@@ -10,7 +10,7 @@
 const int Cube::numOfAllowedCubesOnField = 2;
 
 Cube::Cube(Field* _field, Team _team) : Obstacle(field, team), InstanceCountingTrait<Cube>(), pushedByDrag(false) {
-  this->setTexture(LOAD_TEXTURE(MISC_CUBE));
+  this->setTexture(TEXTURES.LoadTexture(TextureType::MISC_CUBE));
   this->setScale(2.f, 2.f);
   this->SetFloatShoe(false);
   this->SetName("Cube");
@@ -3,11 +3,13 @@
 CustEmblem::CustEmblem() {
   numWires = 12;
   wireShader = &LOAD_SHADER(BADGE_WIRE);
-  wireShader->setUniform("texture", sf::Shader::CurrentTexture);
-  wireShader->setUniform("numOfWires", numWires);
+  SHADERS.SetUniform(wireShader, "texture", sf::Shader::CurrentTexture);
+  SHADERS.SetUniform(wireShader, "numOfWires", numWires);
 
-  emblem.setTexture(LOAD_TEXTURE(CUST_BADGE));
-  emblemWireMask.setTexture(LOAD_TEXTURE(CUST_BADGE_MASK));
+  emblemTexture = TEXTURES.LoadTexture(TextureType::CUST_BADGE);
+  wireMaskTexture = TEXTURES.LoadTexture(TextureType::CUST_BADGE_MASK);
+  emblem.setTexture(*emblemTexture);
+  emblemWireMask.setTexture(*wireMaskTexture);
 
   emblemWireMask.setPosition(-9.0f, -7.0f);
 }
@@ -82,6 +84,7 @@ void CustEmblem::draw(sf::RenderTarget& target, sf::RenderStates states) const {
       wireShader->setUniform("progress", (float)e.progress);
       wireShader->setUniform("index", e.index);
       wireShader->setUniform("inColor", sf::Glsl::Vec4(e.color));
+      SmartShader::Invalidate(wireShader);
       target.draw(emblemWireMask, states);
     }
   }
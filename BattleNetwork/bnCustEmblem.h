@@ -4,6 +4,7 @@
 #include <algorithm>
 #include "bnTextureResourceManager.h"
 #include "bnShaderResourceManager.h"
+#include "bnSmartShader.h"
 
 /**
  * @class CustEmblem
@@ -15,6 +16,7 @@ class CustEmblem : public sf::Drawable, public sf::Transformable {
 private:
   sf::Sprite emblem; /*!< The emblem drawn in place */
   sf::Sprite emblemWireMask; /*!< The pixel color mask for electricity paths */
+  TextureHandle emblemTexture, wireMaskTexture; /*!< Keeps the emblem and mask textures loaded */
 
   mutable sf::Shader* wireShader; /*!< The shader that uses the mask and progress values */
 
@@ -12,7 +12,7 @@ using sf::IntRect;
 ElementalDamage::ElementalDamage(Field* field) : Artifact(field), animationComponent(this)
 {
   SetLayer(0);
-  setTexture(LOAD_TEXTURE(ELEMENT_ALERT));
+  setTexture(TEXTURES.LoadTexture(TextureType::ELEMENT_ALERT));
   setScale(0.f, 0.0f);
   swoosh::game::setOrigin(*this, 0.5, 0.5);
   progress = 0;
@@ -15,7 +15,8 @@ using std::to_string;
 
 EnemyChipsUI::EnemyChipsUI(Character* _owner) : ChipUsePublisher(), Component(_owner) {
   chipCount = curr = 0;
-  icon = sf::Sprite(*TEXTURES.GetTexture(CHIP_ICONS));
+  iconTexture = TEXTURES.LoadTexture(CHIP_ICONS);
+  icon = sf::Sprite(*iconTexture);
   icon.setScale(sf::Vector2f(2.f, 2.f));
   this->character = _owner;
 }
@@ -38,7 +39,7 @@ void EnemyChipsUI::OnUpdate(float _elapsed) {
   else if (GetOwner() && GetOwner()->IsDeleted()) {
     GetOwner()->FreeComponentByID(this->GetID());
     this->FreeOwner();
-    std::cout << "owner is free" << std::endl;
+    LOG_TRACE(BATTLE, "Enemy chip UI owner is free");
   }
 }
 
@@ -72,7 +73,7 @@ void EnemyChipsUI::UseNextChip() {
     return;
   }
 
-  std::cout << "selected chip " << selectedChips[curr].GetShortName() << " is broadcasted by enemy UI" << std::endl;
+  LOG_DEBUG(BATTLE, "Selected chip %s is broadcasted by enemy UI", selectedChips[curr].GetShortName().c_str());
   this->Broadcast(selectedChips[curr], *this->character);
 
   curr++;
@@ -68,4 +68,5 @@ private:
   int curr;
   Character* character;
   mutable sf::Sprite icon;
+  TextureHandle iconTexture;
 };
@@ -50,6 +50,9 @@ void Engine::Draw(Drawable& _drawable, bool applyShaders) {
     }
 #endif 
 
+    // Shaders that have not compiled yet draw like the default shader
+    stateCopy.shader = ShaderResourceManager::Resolve(stateCopy.shader);
+
     surface->draw(_drawable, stateCopy);
   } else {
     surface->draw(_drawable);
@@ -72,6 +75,8 @@ void Engine::Draw(Drawable* _drawable, bool applyShaders) {
     }
 #endif
 
+    stateCopy.shader = ShaderResourceManager::Resolve(stateCopy.shader);
+
     surface->draw(*_drawable, stateCopy);
   } else {
     surface->draw(*_drawable);
@@ -152,6 +157,12 @@ void Engine::Draw(vector<SpriteSceneNode*> _drawable) {
   }
 }
 
+void Engine::Draw(SpriteBatch& batch) {
+  if (!HasRenderSurface()) return;
+
+  batch.Flush(*surface, state);
+}
+
 void Engine::Draw(vector<Drawable*> _drawable, bool applyShaders) {
   if (!HasRenderSurface()) return;
 
@@ -166,6 +177,9 @@ bool Engine::Running() {
 }
 
 void Engine::Clear() {
+  // Uniforms from the last frame should not leak into the next one
+  SmartShader::ReleaseUniforms();
+
   if (HasRenderSurface()) {
     surface->clear();
   }
@@ -211,6 +225,10 @@ void Engine::RevokeShader() {
   SetShader(nullptr);
 }
 
+const sf::Shader* Engine::GetShader() const {
+  return state.shader;
+}
+
 const bool Engine::IsMouseHovering(sf::Sprite & sprite) const
 {
   sf::Vector2i mousei = sf::Mouse::getPosition(*window);
@@ -10,6 +10,7 @@ using std::vector;
 
 #include "bnCamera.h"
 #include "bnLayered.h"
+#include "bnSpriteBatch.h"
 
 /**
  * @class Engine
@@ -62,6 +63,12 @@ public:
    * @param _drawable vector of SpriteSceneNode*
    */
   void Draw(vector<SpriteSceneNode*> _drawable);
+
+  /**
+   * @brief Flushes all quads collected in the sprite batch through the engine pipeline
+   * @param batch
+   */
+  void Draw(SpriteBatch& batch);
   
   /**
    * @brief Returns true if the window is open
@@ -91,6 +98,12 @@ public:
    */
   void RevokeShader();
 
+  /**
+   * @brief Get the post processing effect used on the screen
+   * @return const sf::Shader* or nullptr if none is set
+   */
+  const sf::Shader* GetShader() const;
+
   /**
    * @brief Query if mouse is hovering over a sprite
    * @param sprite
@@ -4,7 +4,7 @@
 #include "bnField.h"
 #include <Swoosh/Ease.h>
 
-long Entity::numOfIDs = 0;
+std::atomic<long> Entity::numOfIDs{0};
 
 // First entity ID begins at 1
 Entity::Entity()
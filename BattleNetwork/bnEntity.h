@@ -17,6 +17,7 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <atomic>
 using std::string;
 
 #include "bnAnimation.h"
@@ -41,7 +42,7 @@ class Entity : public SpriteSceneNode {
 
 private:
   long ID;              /*!< IDs are used for tagging during battle & to identify entities in scripting. */
-  static long numOfIDs; /*!< Internal counter to identify the next entity with. */
+  static std::atomic<long> numOfIDs; /*!< Internal counter to identify the next entity with. */
   int alpha;            /*!< Control the transparency of an entity. */
   long lastComponentID; /*!< Entities keep track of new components to run through scene injection later. */
   bool hasSpawned;      /*!< Flag toggles true when the entity is first placed onto the field. Calls OnSpawn(). */
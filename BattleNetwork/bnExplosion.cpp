@@ -15,7 +15,7 @@ Explosion::Explosion(Field* _field, Team _team, int _numOfExplosions, double _pl
   numOfExplosions = _numOfExplosions;
   playbackSpeed = _playbackSpeed;
   count = 0;
-  setTexture(LOAD_TEXTURE(MOB_EXPLOSION));
+  setTexture(TEXTURES.LoadTexture(TextureType::MOB_EXPLOSION));
   setScale(2.f, 2.f);
   animationComponent = new AnimationComponent(this);
   animationComponent->Setup("resources/mobs/mob_explosion.animation");
@@ -60,7 +60,7 @@ Explosion::Explosion(const Explosion & copy) : Artifact(copy.GetField())
   team = copy.GetTeam();
   numOfExplosions = copy.numOfExplosions-1;
   playbackSpeed = copy.playbackSpeed;
-  setTexture(LOAD_TEXTURE(MOB_EXPLOSION));
+  setTexture(TEXTURES.LoadTexture(TextureType::MOB_EXPLOSION));
   setScale(2.f, 2.f);
 
   animationComponent = new AnimationComponent(this);
@@ -3,9 +3,11 @@
 #include <cstring>
 #include <sstream>
 #include <assert.h>
+#include <filesystem>
 #include <SFML/System.hpp>
 
 #include "bnLogger.h"
+#include "bnArchive.h"
 
 #ifdef __ANDROID_NDK__
 #include <android/asset_manager.h>
@@ -19,7 +21,7 @@
  * @date 04/05/19
  * @brief Ammature file utility that reads in a file as a string dump.
  * 
- * Has function that finds a key and attempts to parse the value wrapped in quotes.
+ * Parsing the key="value" text formats is done by KeyValueReader.
  * Much can be improved here as this was originally legacy code.
  */
 class FileUtil {
@@ -88,7 +90,18 @@ public:
         }
     };
 
+  /**
+   * @brief Reads a loose or packed file into a string
+   * @param _path
+   * @return file contents or an empty string if the file does not exist
+   */
   static std::string Read(const std::string& _path) {
+    ArchiveView view;
+
+    if (IsPacked(_path, view)) {
+      return std::string(view.data, view.size);
+    }
+
     sf::FileInputStream in;
 
     if (in.open(_path) && in.getSize() > 0) {
@@ -97,7 +110,7 @@ public:
       in.read(buffer, size);
       buffer[size] = '\0';
 
-      std::string strbuff(buffer);
+      std::string strbuff(buffer, (std::size_t)size);
 
       delete[] buffer;
 
@@ -107,15 +120,119 @@ public:
     return std::string("");
   }
 
-  static std::string ValueOf(std::string key, std::string line) {
-      int keyIndex = (int)line.find(key);
-      std::string error("Key '" + key + "' was not found in line '" + line + "'");
-      if (keyIndex == -1) {
-        Logger::Log(error);
-        throw std::runtime_error(error);
-      }
+  /**
+   * @brief Writes bytes to a file, replacing its contents
+   * @param _path
+   * @param data bytes to write. Written as-is with no newline translation.
+   * @return true if every byte was written
+   */
+  static bool WriteBytes(const std::string& _path, const std::string& data) {
+    std::FILE* file = std::fopen(_path.c_str(), "wb");
+
+    if (!file) return false;
+
+    bool ok = std::fwrite(data.data(), sizeof(char), data.size(), file) == data.size();
+
+    return std::fclose(file) == 0 && ok;
+  }
+
+  /**
+   * @brief Query if a file should be read from the archive
+   * @param _path
+   * @param view set to the packed bytes if packed
+   * @return true if the file is packed and there is no loose file to override it
+   */
+  static bool IsPacked(const std::string& _path, ArchiveView& view) {
+    if (!ARCHIVE.IsMounted() || Exists(_path)) return false;
+
+    return ARCHIVE.Find(_path, view);
+  }
+
+  /**
+   * @brief Loads an SFML resource from a loose file or straight from the archive
+   * @param resource any type with loadFromFile(path) and loadFromMemory(data, size)
+   * @param _path
+   * @return true if the resource loaded
+   *
+   * Packed files are read from the archive's memory without a copy.
+   * Fonts and music keep reading from that memory for as long as they are open.
+   */
+  template<typename T>
+  static bool LoadResource(T& resource, const std::string& _path) {
+    ArchiveView view;
+
+    if (IsPacked(_path, view)) {
+      return resource.loadFromMemory(view.data, view.size);
+    }
+
+    return resource.loadFromFile(_path);
+  }
+
+  /**
+   * @brief Query if a file or directory exists
+   * @param _path
+   * @return true if it exists, false otherwise
+   */
+  static bool Exists(const std::string& _path) {
+    std::error_code ec;
+    return std::filesystem::exists(_path, ec);
+  }
+
+  /**
+   * @brief Get the size of a file in bytes
+   * @param _path
+   * @return size or 0 if the file does not exist
+   *
+   * Packed files report their unpacked size
+   */
+  static std::uintmax_t GetSize(const std::string& _path) {
+    std::error_code ec;
+    std::uintmax_t size = std::filesystem::file_size(_path, ec);
+
+    if (ec && ARCHIVE.IsMounted()) {
+      return static_cast<std::uintmax_t>(ARCHIVE.GetSize(_path));
+    }
+
+    return ec ? 0 : size;
+  }
+
+  /**
+   * @brief Get the last time the file was written to
+   * @param _path
+   * @return an opaque timestamp that changes when the file does or 0 if it does not exist
+   *
+   * Packed files report the modified time of the archive
+   */
+  static long long GetModifiedTime(const std::string& _path) {
+    std::error_code ec;
+    auto time = std::filesystem::last_write_time(_path, ec);
+
+    if (ec && ARCHIVE.IsMounted() && ARCHIVE.GetSize(_path) > 0) {
+      return ARCHIVE.GetModifiedTime();
+    }
+
+    return ec ? 0 : (long long)time.time_since_epoch().count();
+  }
+
+  /**
+   * @brief Deletes a file
+   * @param _path
+   * @return true if the file does not exist afterwards
+   */
+  static bool Remove(const std::string& _path) {
+    std::error_code ec;
+    std::filesystem::remove(_path, ec);
+    return !std::filesystem::exists(_path, ec);
+  }
 
-      std::string s = line.substr(keyIndex + key.size() + 2);
-      return s.substr(0, s.find("\""));
+  /**
+   * @brief Creates the directory and any missing parent directories
+   * @param _path
+   * @return true if the directory exists afterwards
+   */
+  static bool MakeDirectory(const std::string& _path) {
+    std::error_code ec;
+    std::filesystem::create_directories(_path, ec);
+    return std::filesystem::is_directory(_path, ec);
   }
 };
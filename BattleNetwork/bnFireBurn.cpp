@@ -8,8 +8,8 @@
 FireBurn::FireBurn(Field* _field, Team _team, Type type, int damage) : damage(damage), Spell(_field, _team) {
   SetLayer(-1);
 
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_FIREBURN);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_FIREBURN);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   //When the animation ends, delete this
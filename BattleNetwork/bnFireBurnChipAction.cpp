@@ -19,7 +19,8 @@ FireBurnChipAction::FireBurnChipAction(Character * owner, FireBurn::Type type, i
   this->damage = damage;
   this->type = type;
 
-  overlay.setTexture(*TextureResourceManager::GetInstance().LoadTextureFromFile(PATH));
+  overlayTexture = TEXTURES.LoadTexture(PATH);
+  overlay.setTexture(*overlayTexture);
   this->attachment = new SpriteSceneNode(overlay);
   this->attachment->SetLayer(-1);
   attachmentAnim.Reload();
@@ -9,7 +9,7 @@ Fishy::Fishy(Field* _field, Team _team, double speed) : Obstacle(field, team) {
   field = _field;
   hit = false;
   
-  auto texture = TEXTURES.LoadTextureFromFile("resources/spells/fishy_temp.png");
+  texture = TEXTURES.LoadTexture("resources/spells/fishy_temp.png");
   setTexture(*texture);
   setScale(2.f, 2.f);
   // why do we need to do this??
@@ -61,7 +61,7 @@ const bool Fishy::OnHit(const Hit::Properties props) {
 }
 
 void Fishy::Attack(Character* _entity) {
-  std::cout << "fishy team: " << (int)this->GetTeam() << std::endl;
+  LOG_TRACE(BATTLE, "fishy team: %i", (int)this->GetTeam());
 
   if (!hit) {
 
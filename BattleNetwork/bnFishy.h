@@ -1,6 +1,7 @@
 #pragma once
 #include "bnObstacle.h"
 #include "bnAnimation.h"
+#include "bnTextureResourceManager.h"
 
 /**
  * @class Fishy
@@ -13,6 +14,7 @@
 class Fishy : public Obstacle {
 protected:
   sf::Sprite fishy;
+  TextureHandle texture;
   double speed;
   bool hit;
 public:
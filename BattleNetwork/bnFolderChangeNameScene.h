@@ -27,6 +27,7 @@ private:
   int cursorPosY; /*!< y location in column */
   int currTable;  /*!< which table we're on */
   sf::Sprite cursorPieceLeft, cursorPieceRight;
+  std::vector<TextureHandle> textures; /*!< Keeps the sprite textures loaded while the scene is alive */
   Animation animatorLeft;
   Animation animatorRight;
   float elapsed;
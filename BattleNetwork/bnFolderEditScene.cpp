@@ -87,6 +87,7 @@ std::string FolderEditScene::FormatChipDesc(const std::string && desc)
 
 FolderEditScene::FolderEditScene(swoosh::ActivityController &controller, ChipFolder& folder) :
   camera(sf::View(sf::Vector2f(240, 160), sf::Vector2f(480, 320))), folder(folder), hasFolderChanged(false),
+  packQuery(ChipQuery::Group::CODE),
   swoosh::Activity(&controller)
 {
   // Move chip data into their appropriate containers for easier management
@@ -126,21 +127,21 @@ FolderEditScene::FolderEditScene(swoosh::ActivityController &controller, ChipFol
   chipDesc->setFillColor(sf::Color::Black);
 
   // folder menu graphic
-  bg = sf::Sprite(LOAD_TEXTURE(FOLDER_VIEW_BG));
+  bg = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_VIEW_BG));
   bg.setScale(2.f, 2.f);
 
-  folderDock = sf::Sprite(LOAD_TEXTURE(FOLDER_DOCK));
+  folderDock = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_DOCK));
   folderDock.setScale(2.f, 2.f);
   folderDock.setPosition(2.f, 30.f);
 
-  packDock = sf::Sprite(LOAD_TEXTURE(PACK_DOCK));
+  packDock = sf::Sprite(HOLD_TEXTURE(textures, PACK_DOCK));
   packDock.setScale(2.f, 2.f);
   packDock.setPosition(480.f, 30.f);
 
-  scrollbar = sf::Sprite(LOAD_TEXTURE(FOLDER_SCROLLBAR));
+  scrollbar = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_SCROLLBAR));
   scrollbar.setScale(2.f, 2.f);
 
-  folderCursor = sf::Sprite(LOAD_TEXTURE(FOLDER_CURSOR));
+  folderCursor = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_CURSOR));
   folderCursor.setScale(2.f, 2.f);
   folderCursor.setPosition((2.f*90.f), 64.0f);
   folderSwapCursor = folderCursor;
@@ -149,34 +150,34 @@ FolderEditScene::FolderEditScene(swoosh::ActivityController &controller, ChipFol
   packCursor.setPosition((2.f*90.f) + 480.0f, 64.0f);
   packSwapCursor = packCursor;
 
-  mbPlaceholder = sf::Sprite(LOAD_TEXTURE(FOLDER_MB));
+  mbPlaceholder = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_MB));
   mbPlaceholder.setScale(2.f, 2.f);
 
-  folderNextArrow = sf::Sprite(LOAD_TEXTURE(FOLDER_NEXT_ARROW));
+  folderNextArrow = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_NEXT_ARROW));
   folderNextArrow.setScale(2.f, 2.f);
 
   packNextArrow = folderNextArrow;
   packNextArrow.setScale(-2.f, 2.f);
 
-  folderChipCountBox = sf::Sprite(LOAD_TEXTURE(FOLDER_SIZE));
+  folderChipCountBox = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_SIZE));
   folderChipCountBox.setPosition(sf::Vector2f(425.f, 10.f + folderChipCountBox.getLocalBounds().height));
   folderChipCountBox.setScale(2.f, 2.f);
   folderChipCountBox.setOrigin(folderChipCountBox.getLocalBounds().width / 2.0f, folderChipCountBox.getLocalBounds().height / 2.0f);
 
-  chipHolder = sf::Sprite(LOAD_TEXTURE(FOLDER_CHIP_HOLDER));
+  chipHolder = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_CHIP_HOLDER));
   chipHolder.setScale(2.f, 2.f);
 
-  element = sf::Sprite(LOAD_TEXTURE(ELEMENT_ICON));
+  element = sf::Sprite(HOLD_TEXTURE(textures, ELEMENT_ICON));
   element.setScale(2.f, 2.f);
 
   // Current chip graphic
-  chip = sf::Sprite(LOAD_TEXTURE(CHIP_CARDS));
+  chip = sf::Sprite(HOLD_TEXTURE(textures, CHIP_CARDS));
   cardSubFrame = sf::IntRect(TEXTURES.GetCardRectFromID(0));
   chip.setTextureRect(cardSubFrame);
   chip.setScale(2.f, 2.f);
   chip.setOrigin(chip.getLocalBounds().width / 2.0f, chip.getLocalBounds().height / 2.0f);
 
-  chipIcon = sf::Sprite(LOAD_TEXTURE(CHIP_ICONS));
+  chipIcon = sf::Sprite(HOLD_TEXTURE(textures, CHIP_ICONS));
   chipIcon.setScale(2.f, 2.f);
 
   chipRevealTimer.start();
@@ -352,12 +353,10 @@ void FolderEditScene::onUpdate(double elapsed) {
 
               // If the chip slot had a chip, find the corresponding bucket to add it back into
               if (findBucket) {
-                auto iter = std::find_if(packChipBuckets.begin(), packChipBuckets.end(),
-                  [&prev](const PackBucket& in) { return prev.GetShortName() == in.ViewChip().GetShortName(); }
-                );
+                int bucket = FindBucket(prev);
 
-                if (iter != packChipBuckets.end()) {
-                  iter->AddChip();
+                if (bucket != -1) {
+                  packChipBuckets[bucket].AddChip();
                 }
               }
 
@@ -393,9 +392,7 @@ void FolderEditScene::onUpdate(double elapsed) {
           }
           else {
             // swap the pack
-            auto temp = packChipBuckets[packView.swapChipIndex];
-            packChipBuckets[packView.swapChipIndex] = packChipBuckets[packView.currChipIndex];
-            packChipBuckets[packView.currChipIndex] = temp;
+            SwapBuckets(packView.swapChipIndex, packView.currChipIndex);
             AUDIO.Play(AudioType::CHIP_CONFIRM);
 
             packView.swapChipIndex = -1;
@@ -427,12 +424,10 @@ void FolderEditScene::onUpdate(double elapsed) {
 
               // If the chip slot had a chip, find the corresponding bucket to add it back into
               if (findBucket) {
-                auto iter = std::find_if(packChipBuckets.begin(), packChipBuckets.end(),
-                  [&prev](const PackBucket& in) { return prev.GetShortName() == in.ViewChip().GetShortName(); }
-                );
+                int bucket = FindBucket(prev);
 
-                if (iter != packChipBuckets.end()) {
-                  iter->AddChip();
+                if (bucket != -1) {
+                  packChipBuckets[bucket].AddChip();
                 }
               }
 
@@ -459,6 +454,11 @@ void FolderEditScene::onUpdate(double elapsed) {
         }
       }
     }
+    else if (INPUT.Has(EventTypes::PRESSED_QUICK_OPT) && currViewMode == ViewMode::PACK) {
+      NextPackSort();
+      AUDIO.Play(AudioType::CHIP_SELECT);
+      chipRevealTimer.reset();
+    }
     else if (INPUT.Has(EventTypes::PRESSED_UI_RIGHT) && currViewMode == ViewMode::FOLDER) {
       currViewMode = ViewMode::PACK;
       canInteract = false;
@@ -838,9 +838,11 @@ void FolderEditScene::ExcludeFolderDataFromPack()
 {
   Chip mock; // will not be used
   for (auto& f : folderChipSlots) {
-    auto iter = std::find_if(packChipBuckets.begin(), packChipBuckets.end(), [&f](PackBucket& pack) { return pack.ViewChip() == f.ViewChip(); });
-    if (iter != packChipBuckets.end()) {
-      iter->GetChip(mock);
+    if (f.IsEmpty()) continue;
+
+    int bucket = FindBucket(f.ViewChip());
+    if (bucket != -1) {
+      packChipBuckets[bucket].GetChip(mock);
     }
   }
 }
@@ -863,21 +865,71 @@ void FolderEditScene::PlaceFolderDataIntoChipSlots()
 
 void FolderEditScene::PlaceLibraryDataIntoBuckets()
 {
-  ChipLibrary::Iter iter = CHIPLIB.Begin();
-  std::map<Chip, bool, Chip::Compare> visited; // visit table
+  packQuery.SortBy(ChipQuery::Sort::ALPHABETICAL);
 
-  while (iter != CHIPLIB.End()) {
-    if (visited.find(*iter) != visited.end()) {
-      iter++;
-      continue;
-    }
+  for (std::size_t i = 0; i < packQuery.GetSize(); i++) {
+    Chip chip = packQuery.MakeChip(i);
+    packBucketIndex[chip] = (int)packChipBuckets.size();
+    packChipBuckets.push_back(PackBucket(packQuery.At(i).count, chip));
+  }
+}
 
-    visited[(*iter)] = true;
-    int count = CHIPLIB.GetCountOf(*iter);
-    auto bucket = PackBucket(count, Chip(*iter));
-    packChipBuckets.push_back(bucket);
-    iter++;
+const int FolderEditScene::FindBucket(const Chip& chip) const
+{
+  auto iter = packBucketIndex.find(chip);
+  return iter == packBucketIndex.end() ? -1 : iter->second;
+}
+
+void FolderEditScene::SwapBuckets(int a, int b)
+{
+  std::swap(packChipBuckets[a], packChipBuckets[b]);
+  packBucketIndex[packChipBuckets[a].ViewChip()] = a;
+  packBucketIndex[packChipBuckets[b].ViewChip()] = b;
+}
+
+void FolderEditScene::NextPackSort()
+{
+  if (packChipBuckets.empty()) return;
+
+  Chip selected = packChipBuckets[packView.currChipIndex].ViewChip();
+
+  int next = (static_cast<int>(packQuery.GetSort()) + 1) % static_cast<int>(ChipQuery::Sort::SIZE);
+
+  packQuery.Refresh();
+  packQuery.SortBy(static_cast<ChipQuery::Sort>(next));
+
+  // Buckets are moved, not rebuilt, so the counts taken by the folder stay
+  std::vector<PackBucket> sorted;
+  sorted.reserve(packChipBuckets.size());
+
+  std::vector<bool> moved(packChipBuckets.size(), false);
+
+  for (std::size_t i = 0; i < packQuery.GetSize(); i++) {
+    int bucket = FindBucket(packQuery.MakeChip(i));
+
+    if (bucket == -1 || moved[bucket]) continue;
+
+    moved[bucket] = true;
+    sorted.push_back(packChipBuckets[bucket]);
   }
+
+  // Anything the library no longer has stays at the bottom
+  for (std::size_t i = 0; i < packChipBuckets.size(); i++) {
+    if (!moved[i]) sorted.push_back(packChipBuckets[i]);
+  }
+
+  packChipBuckets.swap(sorted);
+  packBucketIndex.clear();
+
+  for (int i = 0; i < (int)packChipBuckets.size(); i++) {
+    packBucketIndex[packChipBuckets[i].ViewChip()] = i;
+  }
+
+  // Scroll so the same chip is highlighted in the same row on screen
+  int row = packView.currChipIndex - packView.lastChipOnScreen;
+  packView.currChipIndex = std::max(0, FindBucket(selected));
+  packView.lastChipOnScreen = std::max(0, packView.currChipIndex - row);
+  packView.swapChipIndex = -1;
 }
 
 void FolderEditScene::WriteNewFolderData()
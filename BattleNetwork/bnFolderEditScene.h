@@ -11,6 +11,9 @@
 #include "bnAnimation.h"
 #include "bnLanBackground.h"
 #include "bnChipFolder.h"
+#include "bnChipQuery.h"
+
+#include <map>
 
 /**
  * @class FolderEditScene
@@ -94,9 +97,28 @@ private:
   void PlaceLibraryDataIntoBuckets();
   void WriteNewFolderData();
 
+  /**
+   * @brief Find the pack bucket that holds a chip
+   * @param chip matched by name and code
+   * @return index into packChipBuckets or -1
+   */
+  const int FindBucket(const Chip& chip) const;
+
+  /**
+   * @brief Swap two pack buckets and keep the lookup up to date
+   */
+  void SwapBuckets(int a, int b);
+
+  /**
+   * @brief Order the pack by the next sort key. Counts taken by the folder are kept.
+   */
+  void NextPackSort();
+
 private:
   std::vector<FolderSlot> folderChipSlots; /*!< Rows in the folder that can be inserted with chips or replaced */
   std::vector<PackBucket> packChipBuckets; /*!< Rows in the pack that represent how many of a chip are left */
+  std::map<Chip, int, Chip::Compare> packBucketIndex; /*!< Chip to its row in packChipBuckets */
+  ChipQuery packQuery; /*!< Presorted pack orders. Quick Opt in the pack changes the order. */
   bool hasFolderChanged; /*!< Flag if folder needs to be saved before quitting screen */
   Camera camera;
   ChipFolder& folder;
@@ -137,6 +159,7 @@ private:
   sf::Sprite chip;
   sf::IntRect cardSubFrame;
   sf::Sprite chipIcon;
+  std::vector<TextureHandle> textures; /*!< Keeps the sprite textures loaded while the scene is alive */
   swoosh::Timer chipRevealTimer;
   swoosh::Timer easeInTimer;
 
@@ -60,41 +60,43 @@ FolderScene::FolderScene(swoosh::ActivityController &controller, ChipFolderColle
   numberLabel->setPosition(sf::Vector2f(170.f, 28.0f));
 
   // folder menu graphic
-  bg = sf::Sprite(LOAD_TEXTURE(FOLDER_INFO_BG));
+  bg = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_INFO_BG));
   bg.setScale(2.f, 2.f);
 
-  scrollbar = sf::Sprite(LOAD_TEXTURE(FOLDER_SCROLLBAR));
+  scrollbar = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_SCROLLBAR));
   scrollbar.setScale(2.f, 2.f);
   scrollbar.setPosition(410.f, 60.f);
 
-  folderBox = sf::Sprite(LOAD_TEXTURE(FOLDER_BOX));
+  folderBox = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_BOX));
   folderBox.setScale(2.f, 2.f);
 
-  folderOptions = sf::Sprite(LOAD_TEXTURE(FOLDER_OPTIONS));
+  folderOptions = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_OPTIONS));
   folderOptions.setOrigin(folderOptions.getGlobalBounds().width / 2.0f, folderOptions.getGlobalBounds().height / 2.0f);
   folderOptions.setPosition(98.0f, 210.0f);
   folderOptions.setScale(2.f, 0.f); // hide on start
 
-  folderCursor = sf::Sprite(LOAD_TEXTURE(FOLDER_BOX_CURSOR));
+  folderCursor = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_BOX_CURSOR));
   folderCursor.setScale(2.f, 2.f);
 
-  folderEquip = sf::Sprite(LOAD_TEXTURE(FOLDER_EQUIP));
+  folderEquip = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_EQUIP));
   folderEquip.setScale(2.f, 2.f);
 
-  cursor = sf::Sprite(LOAD_TEXTURE(TEXT_BOX_CURSOR));
+  cursor = sf::Sprite(HOLD_TEXTURE(textures, TEXT_BOX_CURSOR));
   cursor.setScale(2.f, 2.f);
   cursor.setPosition(2.0, 155.0f);
 
-  element = sf::Sprite(LOAD_TEXTURE(ELEMENT_ICON));
+  element = sf::Sprite(HOLD_TEXTURE(textures, ELEMENT_ICON));
   element.setScale(2.f, 2.f);
   element.setPosition(2.f*25.f, 146.f);
 
-  chipIcon = sf::Sprite(LOAD_TEXTURE(CHIP_ICONS));
+  chipIcon = sf::Sprite(HOLD_TEXTURE(textures, CHIP_ICONS));
   chipIcon.setScale(2.f, 2.f);
 
-  mbPlaceholder = sf::Sprite(LOAD_TEXTURE(FOLDER_MB));
+  mbPlaceholder = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_MB));
   mbPlaceholder.setScale(2.f, 2.f);
 
+  navigatorMug = TEXTURES.LoadTexture(TextureType::MUG_NAVIGATOR);
+
   equipAnimation = Animation("resources/ui/folder_equip.animation");
   equipAnimation.SetAnimation("BLINK");
   equipAnimation << Animator::Mode::Loop;
@@ -614,7 +616,7 @@ void FolderScene::DeleteFolder(std::function<void()> onSuccess)
   };
 
   textbox.EnqueMessage(
-    sf::Sprite(LOAD_TEXTURE(MUG_NAVIGATOR)), 
+    sf::Sprite(*navigatorMug), 
     "resources/ui/navigator.animation", 
     new Question("Are you sure you want to permanently delete this folder?", 
     onYes,
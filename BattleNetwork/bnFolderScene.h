@@ -62,6 +62,8 @@ private:
   sf::Sprite folderEquip;
   sf::Sprite chipIcon;
   sf::Sprite mbPlaceholder;
+  std::vector<TextureHandle> textures; /*!< Keeps the sprite textures loaded while the scene is alive */
+  TextureHandle navigatorMug; /*!< Mugshot for the delete folder question */
 
   Animation equipAnimation; /*!< Flashes */
   Animation folderCursorAnimation; /*!< Flashes */
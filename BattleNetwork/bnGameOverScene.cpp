@@ -6,7 +6,8 @@
 GameOverScene::GameOverScene(swoosh::ActivityController& controller) : swoosh::Activity(&controller) {
   fadeInCooldown = 2.0f;
 
-  gameOver.setTexture(*TEXTURES.GetTexture(TextureType::GAME_OVER));
+  gameOverTexture = TEXTURES.LoadTexture(TextureType::GAME_OVER);
+  gameOver.setTexture(*gameOverTexture);
   gameOver.setScale(2.f, 2.f);
   gameOver.setOrigin(gameOver.getLocalBounds().width / 2, gameOver.getLocalBounds().height / 2);
 
@@ -17,6 +17,7 @@ class GameOverScene : public swoosh::Activity {
 private:
   float fadeInCooldown; /*!< Fade in time */
   sf::Sprite gameOver; /*!< GAME OVER */
+  TextureHandle gameOverTexture; /*!< Keeps the GAME OVER texture loaded */
   bool leave; /*!< Scene state coming/going flag */
 
 public:
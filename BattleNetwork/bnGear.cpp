@@ -6,7 +6,7 @@
 #include "bnAudioResourceManager.h"
 
 Gear::Gear(Field* _field, Team _team, Direction startDir) : startDir(startDir), Obstacle(field, team) {
-  this->setTexture(LOAD_TEXTURE(MOB_METALMAN_ATLAS));
+  this->setTexture(TEXTURES.LoadTexture(TextureType::MOB_METALMAN_ATLAS));
   this->setScale(2.f, 2.f);
   this->SetFloatShoe(false);
   this->SetName("MetalGear");
@@ -11,7 +11,7 @@
 #define COMPONENT_HEIGHT 160
 
 GridBackground::GridBackground(void)
-  : x(0.0f), y(0), progress(0.0f), Background(LOAD_TEXTURE(NAVI_SELECT_BG), 240, 160) {
+  : x(0.0f), y(0), progress(0.0f), Background(TEXTURES.LoadTexture(TextureType::NAVI_SELECT_BG), 240, 160) {
   FillScreen(sf::Vector2u(COMPONENT_WIDTH, COMPONENT_HEIGHT));
 }
 
@@ -18,7 +18,7 @@ void HideUntil::OnUpdate(float _elapsed) {
 }
 
 void HideUntil::Inject(BattleScene& scene) {
-  std::cout << "scene is " << &scene << std::endl;
+  LOG_TRACE(BATTLE, "HideUntil injected into scene %p", (void*)&scene);
 
   scene.Inject(this);
   this->scene = &scene;
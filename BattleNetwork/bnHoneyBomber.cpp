@@ -25,13 +25,13 @@ HoneyBomber::HoneyBomber(Rank _rank)
   animationComponent->SetPlaybackSpeed(1.0);
   animationComponent->SetAnimation("IDLE");
 
-  setTexture(*TEXTURES.GetTexture(TextureType::MOB_HONEYBOMBER_ATLAS));
+  setTexture(TEXTURES.LoadTexture(TextureType::MOB_HONEYBOMBER_ATLAS));
   setScale(2.f, 2.f);
   animationComponent->OnUpdate(0);
   this->RegisterComponent(animationComponent);
 
   shadow = new SpriteSceneNode();
-  shadow->setTexture(LOAD_TEXTURE(MISC_SHADOW));
+  shadow->setTexture(TEXTURES.LoadTexture(TextureType::MISC_SHADOW));
   shadow->SetLayer(1);
   shadow->setPosition(-12.0f, 6.0f);
   this->AddNode(shadow);
@@ -40,6 +40,7 @@ namespace Overworld {
     Animation numbermanAnimations; /*!< numberman animations to animate */
 
     std::vector<NPC*> npcs; /*!< list of npcs */
+    TextureHandle progTexture; /*!< mr prog texture shared by every npc */
 
     public:
     /**
@@ -375,7 +375,7 @@ void InputManager::Update() {
       state = "PRESSED";
       break;
     }
-    Logger::Logf("input event %s, %s", e.name.c_str(), state.c_str());
+    LOG_TRACE(CORE, "input event %s, %s", e.name.c_str(), state.c_str());
   }
   */
 
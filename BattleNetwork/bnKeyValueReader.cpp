@@ -0,0 +1,235 @@
+#include "bnKeyValueReader.h"
+#include "bnLogger.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+  bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+  }
+
+  std::string_view Trim(std::string_view text) {
+    while (!text.empty() && IsSpace(text.front())) text.remove_prefix(1);
+    while (!text.empty() && IsSpace(text.back())) text.remove_suffix(1);
+    return text;
+  }
+}
+
+KeyValueReader::KeyValueReader(std::string_view buffer, std::string_view source, Style style)
+  : buffer(buffer), source(source), style(style), next(0), attributes(0), cursor(0), lineNumber(0), errors(0), isSection(false) {
+}
+
+bool KeyValueReader::Next() {
+  while (next <= buffer.size()) {
+    std::size_t end = buffer.find('\n', next);
+    if (end == std::string_view::npos) end = buffer.size();
+
+    line = Trim(buffer.substr(next, end - next));
+    next = end + 1;
+    lineNumber++;
+
+    if (line.empty() || line.front() == '#') continue;
+
+    isSection = false;
+    attributes = 0;
+
+    if (style == Style::ini) {
+      if (line.front() == '[') {
+        std::size_t close = line.find(']');
+
+        if (close == std::string_view::npos) {
+          Error("Section is missing ']'");
+          continue;
+        }
+
+        tag = line.substr(1, close - 1);
+        isSection = true;
+        attributes = line.size();
+      }
+    }
+    else {
+      std::size_t pos = 0;
+      while (pos < line.size() && !IsSpace(line[pos]) && line[pos] != '=') pos++;
+
+      // A line that starts with key= has no tag
+      if (pos < line.size() && line[pos] == '=') {
+        tag = std::string_view();
+      }
+      else {
+        tag = line.substr(0, pos);
+        attributes = pos;
+      }
+    }
+
+    cursor = attributes;
+    return true;
+  }
+
+  line = tag = std::string_view();
+  return false;
+}
+
+std::string_view KeyValueReader::GetTag() const {
+  return tag;
+}
+
+const bool KeyValueReader::IsSection() const {
+  return isSection;
+}
+
+bool KeyValueReader::ReadAttribute(std::size_t& pos, std::string_view& key, std::string_view& value, const char*& error) const {
+  error = nullptr;
+
+  while (pos < line.size() && IsSpace(line[pos])) pos++;
+
+  if (pos >= line.size()) return false;
+
+  std::size_t start = pos;
+
+  if (style == Style::ini) {
+    pos = line.find('=', start);
+
+    if (pos == std::string_view::npos) {
+      pos = line.size();
+      error = "Expected key=\"value\"";
+      return false;
+    }
+
+    key = Trim(line.substr(start, pos - start));
+  }
+  else {
+    while (pos < line.size() && !IsSpace(line[pos]) && line[pos] != '=') pos++;
+
+    key = line.substr(start, pos - start);
+
+    if (pos >= line.size() || line[pos] != '=') {
+      pos = line.size();
+      error = "Expected '=' after key";
+      return false;
+    }
+  }
+
+  pos++; // '='
+
+  while (pos < line.size() && IsSpace(line[pos])) pos++;
+
+  if (pos < line.size() && line[pos] == '"') {
+    std::size_t close = line.find('"', pos + 1);
+
+    if (close == std::string_view::npos) {
+      pos = line.size();
+      error = "Value is missing a closing quote";
+      return false;
+    }
+
+    value = line.substr(pos + 1, close - pos - 1);
+    pos = close + 1;
+  }
+  else if (style == Style::ini) {
+    value = Trim(line.substr(pos));
+    pos = line.size();
+  }
+  else {
+    start = pos;
+    while (pos < line.size() && !IsSpace(line[pos])) pos++;
+    value = line.substr(start, pos - start);
+  }
+
+  return true;
+}
+
+bool KeyValueReader::NextAttribute(std::string_view& key, std::string_view& value) {
+  const char* error = nullptr;
+
+  if (ReadAttribute(cursor, key, value, error)) return true;
+
+  if (error) Error(error);
+
+  return false;
+}
+
+bool KeyValueReader::Find(std::string_view key, std::string_view& value) const {
+  std::size_t pos = attributes;
+  std::string_view k, v;
+  const char* error = nullptr;
+
+  while (ReadAttribute(pos, k, v, error)) {
+    if (k == key) {
+      value = v;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::string_view KeyValueReader::Get(std::string_view key, std::string_view fallback) const {
+  std::string_view value;
+  return Find(key, value) ? value : fallback;
+}
+
+std::string_view KeyValueReader::Require(std::string_view key) {
+  std::string_view value;
+
+  if (!Find(key, value)) {
+    Error("Missing attribute '" + ToString(key) + "'");
+  }
+
+  return value;
+}
+
+const unsigned KeyValueReader::GetLineNumber() const {
+  return lineNumber;
+}
+
+const unsigned KeyValueReader::GetErrorCount() const {
+  return errors;
+}
+
+void KeyValueReader::Error(const std::string& message) {
+  errors++;
+
+  // Loaders may run on worker threads
+  LOG_WARN(CONTENT, "%.*s:%u: %s", (int)source.size(), source.data(), lineNumber, message.c_str());
+}
+
+int KeyValueReader::ToInt(std::string_view value) {
+  return static_cast<int>(ToInt64(value));
+}
+
+long long KeyValueReader::ToInt64(std::string_view value) {
+  std::size_t pos = 0;
+  while (pos < value.size() && IsSpace(value[pos])) pos++;
+
+  bool negative = false;
+
+  if (pos < value.size() && (value[pos] == '-' || value[pos] == '+')) {
+    negative = value[pos] == '-';
+    pos++;
+  }
+
+  long long result = 0;
+
+  for (; pos < value.size() && value[pos] >= '0' && value[pos] <= '9'; pos++) {
+    result = result * 10 + (value[pos] - '0');
+  }
+
+  return negative ? -result : result;
+}
+
+float KeyValueReader::ToFloat(std::string_view value) {
+  // strtof needs a terminated string. Numbers in our files are short.
+  char number[64];
+  std::size_t length = std::min(value.size(), sizeof(number) - 1);
+
+  std::memcpy(number, value.data(), length);
+  number[length] = '\0';
+
+  return std::strtof(number, nullptr);
+}
+
+std::string KeyValueReader::ToString(std::string_view value) {
+  return std::string(value.data(), value.size());
+}
@@ -0,0 +1,166 @@
+/*! \file bnKeyValueReader.h */
+
+/*! \brief Walks a text buffer once and hands out its tags, keys and values
+ *
+ * Every text format in the game is a variation of the same thing:
+ *
+ * ```
+ * # comment
+ * Chip name="Cannon" code="A"
+ * VERSION="1.0"
+ * [Audio]
+ * Music="3"
+ * ```
+ *
+ * The reader steps through the buffer one line at a time. Blank lines and
+ * lines starting with '#' are skipped. Tags, keys and values are views into
+ * the buffer so nothing is copied or allocated while reading. The buffer must
+ * outlive the reader.
+ *
+ * In Style::tagged (the default) the first word on a line is its tag and the
+ * rest are key="value" attributes. A line that starts with an attribute has an
+ * empty tag.
+ *
+ * In Style::ini a [Section] line sets the tag for the lines that follow it.
+ * The key is everything before the '=' so keys may contain spaces.
+ *
+ * Values may be quoted or end at the next whitespace. Problems are logged
+ * with the source name and line number.
+ */
+#pragma once
+#include <string>
+#include <string_view>
+
+class KeyValueReader {
+public:
+  enum class Style : char {
+    tagged,
+    ini
+  };
+
+  /**
+   * @brief Start reading a buffer
+   * @param buffer text to read. Must outlive the reader.
+   * @param source name used in error messages e.g. the file path
+   * @param style how lines are laid out
+   */
+  KeyValueReader(std::string_view buffer, std::string_view source = "", Style style = Style::tagged);
+
+  /**
+   * @brief Move to the next line with content
+   * @return false at the end of the buffer
+   */
+  bool Next();
+
+  /**
+   * @brief Get the tag of the current line
+   * @return first word in Style::tagged, current section name in Style::ini
+   */
+  std::string_view GetTag() const;
+
+  /**
+   * @brief Query if the current line is a [Section] header (Style::ini only)
+   * @return true if the line started a new section
+   */
+  const bool IsSection() const;
+
+  /**
+   * @brief Read the next attribute on the current line
+   * @param key set to the attribute name
+   * @param value set to the attribute value without quotes
+   * @return false when the line has no more attributes or is malformed
+   */
+  bool NextAttribute(std::string_view& key, std::string_view& value);
+
+  /**
+   * @brief Find an attribute on the current line by name
+   * @param key exact attribute name
+   * @param value set to the value if found
+   * @return true if the attribute exists
+   */
+  bool Find(std::string_view key, std::string_view& value) const;
+
+  /**
+   * @brief Find an attribute on the current line or use a fallback
+   * @param key exact attribute name
+   * @param fallback returned if the attribute does not exist
+   * @return value or fallback
+   */
+  std::string_view Get(std::string_view key, std::string_view fallback) const;
+
+  /**
+   * @brief Find an attribute that must exist. Logs an error with the line number if it is missing.
+   * @param key exact attribute name
+   * @return value or an empty view if missing
+   */
+  std::string_view Require(std::string_view key);
+
+  /**
+   * @brief Get the line number of the current line
+   * @return base 1 line number
+   */
+  const unsigned GetLineNumber() const;
+
+  /**
+   * @brief Query how many errors were logged while reading
+   * @return error count
+   */
+  const unsigned GetErrorCount() const;
+
+  /**
+   * @brief Log a problem with the current line
+   * @param message what was wrong
+   */
+  void Error(const std::string& message);
+
+  /**
+   * @brief Parse an integer like atoi() without a copy
+   * @param value
+   * @return number or 0 if the value does not start with one
+   */
+  static int ToInt(std::string_view value);
+
+  /**
+   * @brief Parse a 64-bit integer like atoll() without a copy
+   * @param value
+   * @return number or 0 if the value does not start with one
+   */
+  static long long ToInt64(std::string_view value);
+
+  /**
+   * @brief Parse a float like atof() without a heap allocation
+   * @param value
+   * @return number or 0 if the value does not start with one
+   */
+  static float ToFloat(std::string_view value);
+
+  /**
+   * @brief Copy a view into a string
+   * @param value
+   * @return std::string with the same characters
+   */
+  static std::string ToString(std::string_view value);
+
+private:
+  /**
+   * @brief Read one attribute starting at pos
+   * @param pos read position within line. Moved past the attribute.
+   * @param key
+   * @param value
+   * @param error set to a description if the attribute is malformed
+   * @return false at the end of the line or on error
+   */
+  bool ReadAttribute(std::size_t& pos, std::string_view& key, std::string_view& value, const char*& error) const;
+
+  std::string_view buffer; /*!< Whole text being read */
+  std::string_view source; /*!< Name for error messages */
+  Style style;
+  std::size_t next; /*!< Start of the next unread line */
+  std::string_view line; /*!< Current line without leading or trailing whitespace */
+  std::string_view tag; /*!< Tag of the current line or section */
+  std::size_t attributes; /*!< Where the attributes begin in line */
+  std::size_t cursor; /*!< Read position for NextAttribute() */
+  unsigned lineNumber;
+  unsigned errors;
+  bool isSection;
+};
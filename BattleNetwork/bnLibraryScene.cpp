@@ -90,6 +90,7 @@ std::string LibraryScene::FormatChipDesc(const std::string && desc)
 LibraryScene::LibraryScene(swoosh::ActivityController &controller) :
   camera(ENGINE.GetView()),
   textbox(sf::Vector2f(4, 255)),
+  uniqueChips(ChipQuery::Group::CHIP),
   swoosh::Activity(&controller)
 {
 
@@ -134,41 +135,41 @@ touchPosX = touchPosStartX = -1;
   chipDesc->setFillColor(sf::Color::Black);
 
   // folder menu graphic
-  bg = sf::Sprite(LOAD_TEXTURE(FOLDER_VIEW_BG));
+  bg = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_VIEW_BG));
   bg.setScale(2.f, 2.f);
 
-  folderDock = sf::Sprite(LOAD_TEXTURE(FOLDER_DOCK));
+  folderDock = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_DOCK));
   folderDock.setScale(2.f, 2.f);
   folderDock.setPosition(2.f, 30.f);
 
-  scrollbar = sf::Sprite(LOAD_TEXTURE(FOLDER_SCROLLBAR));
+  scrollbar = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_SCROLLBAR));
   scrollbar.setScale(2.f, 2.f);
   scrollbar.setPosition(410.f, 60.f);
 
-  cursor = sf::Sprite(LOAD_TEXTURE(FOLDER_CURSOR));
+  cursor = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_CURSOR));
   cursor.setScale(2.f, 2.f);
   cursor.setPosition((2.f*90.f), 64.0f);
 
-  stars = sf::Sprite(LOAD_TEXTURE(FOLDER_RARITY));
+  stars = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_RARITY));
   stars.setScale(2.f, 2.f);
 
-  chipHolder = sf::Sprite(LOAD_TEXTURE(FOLDER_CHIP_HOLDER));
+  chipHolder = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_CHIP_HOLDER));
   chipHolder.setScale(2.f, 2.f);
   chipHolder.setPosition(4.f, 35.f);
 
-  element = sf::Sprite(LOAD_TEXTURE(ELEMENT_ICON));
+  element = sf::Sprite(HOLD_TEXTURE(textures, ELEMENT_ICON));
   element.setScale(2.f, 2.f);
   element.setPosition(2.f*25.f, 146.f);
 
   // Current chip graphic
-  chip = sf::Sprite(LOAD_TEXTURE(CHIP_CARDS));
+  chip = sf::Sprite(HOLD_TEXTURE(textures, CHIP_CARDS));
   cardSubFrame = sf::IntRect(TEXTURES.GetCardRectFromID(0));
   chip.setTextureRect(cardSubFrame);
   chip.setScale(2.f, 2.f);
   chip.setPosition(83.f, 93.f);
   chip.setOrigin(chip.getLocalBounds().width / 2.0f, chip.getLocalBounds().height / 2.0f);
 
-  chipIcon = sf::Sprite(LOAD_TEXTURE(CHIP_ICONS));
+  chipIcon = sf::Sprite(HOLD_TEXTURE(textures, CHIP_ICONS));
   chipIcon.setScale(2.f, 2.f);
 
   chipRevealTimer.start();
@@ -185,19 +186,37 @@ LibraryScene::~LibraryScene() { ; }
 
 void LibraryScene::MakeUniqueChipsFromPack()
 {
-  ChipLibrary::Iter iter = CHIPLIB.Begin();
+  uniqueChips.Refresh();
 
-  for (iter; iter != CHIPLIB.End(); iter++) {
-    this->uniqueChips.insert(uniqueChips.begin(), *iter);
+  numOfChips = (int)uniqueChips.GetSize();
+}
+
+void LibraryScene::NextSort()
+{
+  int next = (static_cast<int>(uniqueChips.GetSort()) + 1) % static_cast<int>(ChipQuery::Sort::SIZE);
+
+  if (numOfChips == 0) {
+    uniqueChips.SortBy(static_cast<ChipQuery::Sort>(next));
+    return;
   }
 
-  auto pred = [](const Chip &a, const Chip &b) -> bool {
-    return a.GetShortName() == b.GetShortName();
-  };
+  const ChipRecord* selected = uniqueChips.At(currChipIndex).record;
 
-  this->uniqueChips.unique(pred);
+  uniqueChips.SortBy(static_cast<ChipQuery::Sort>(next));
 
-  numOfChips = (int)uniqueChips.size();
+  // Scroll so the same chip is highlighted in the same row on screen
+  int row = currChipIndex - lastChipOnScreen;
+  currChipIndex = std::max(0, uniqueChips.IndexOf(selected->name, '*'));
+  lastChipOnScreen = std::max(0, currChipIndex - row);
+}
+
+void LibraryScene::ClampSelection()
+{
+  currChipIndex = std::max(0, std::min(numOfChips - 1, currChipIndex));
+
+  lastChipOnScreen = std::min(lastChipOnScreen, currChipIndex);
+  lastChipOnScreen = std::max(lastChipOnScreen, currChipIndex - maxChipsOnScreen + 1);
+  lastChipOnScreen = std::max(0, lastChipOnScreen);
 }
 
 void LibraryScene::onStart() {
@@ -224,6 +243,20 @@ void LibraryScene::onUpdate(double elapsed) {
 
   // Scene keyboard controls
   if (!gotoNextScene) {
+    // The library may have changed while the scene was open
+    if (uniqueChips.Refresh()) {
+      numOfChips = (int)uniqueChips.GetSize();
+
+      // The list may have shrunk under the cursor
+      ClampSelection();
+    }
+
+    if (INPUT.Has(EventTypes::PRESSED_QUICK_OPT) && textbox.IsClosed()) {
+      NextSort();
+      AUDIO.Play(AudioType::CHIP_SELECT);
+      chipRevealTimer.reset();
+    }
+
     if (INPUT.Has(EventTypes::PRESSED_UI_UP)) {
       selectInputCooldown -= elapsed;
 
@@ -262,17 +295,11 @@ void LibraryScene::onUpdate(double elapsed) {
       selectInputCooldown = 0;
     }
 
-    if (INPUT.Has(EventTypes::PRESSED_CONFIRM) && textbox.IsClosed()) {
-      auto iter = uniqueChips.begin();
-      int i = 0;
-
-      while (i < currChipIndex) {
-        i++;
-        iter++;
-      }
+    if (INPUT.Has(EventTypes::PRESSED_CONFIRM) && textbox.IsClosed() && numOfChips > 0) {
+      const ChipRecord& record = *uniqueChips.At(currChipIndex).record;
 
       textbox.DequeMessage(); // make sure textbox is empty
-      textbox.EnqueMessage(sf::Sprite(), "", new Message(iter->GetVerboseDescription()));
+      textbox.EnqueMessage(sf::Sprite(), "", new Message(std::string(record.verboseDescription)));
       textbox.Open();
       AUDIO.Play(AudioType::CHIP_DESC);
     }
@@ -289,11 +316,7 @@ void LibraryScene::onUpdate(double elapsed) {
       //textbox.Continue();
     }
 
-    currChipIndex = std::max(0, currChipIndex);
-    currChipIndex = std::min(numOfChips - 1, currChipIndex);
-
-    lastChipOnScreen = std::max(0, lastChipOnScreen);
-    lastChipOnScreen = std::min(numOfChips - 1, lastChipOnScreen);
+    ClampSelection();
 
     if (INPUT.Has(EventTypes::PRESSED_CANCEL) && textbox.IsClosed()) {
       gotoNextScene = true;
@@ -343,29 +366,24 @@ void LibraryScene::onDraw(sf::RenderTexture& surface) {
 
   ENGINE.Draw(scrollbar);
 
-  if (uniqueChips.size() == 0) return;
+  if (numOfChips == 0) return;
 
-  // Move the chip library iterator to the current highlighted chip
-  auto iter = uniqueChips.begin();
-
-  for (int j = 0; j < lastChipOnScreen; j++) {
-    iter++;
-  }
-
-  // Now that we are at the viewing range, draw each chip in the list
+  // Draw each chip in the viewing range
   for (int i = 0; i < maxChipsOnScreen && lastChipOnScreen + i < numOfChips; i++) {
-    chipIcon.setTextureRect(TEXTURES.GetIconRectFromID(iter->GetIconID()));
+    const ChipRecord* record = uniqueChips.At(lastChipOnScreen + i).record;
+
+    chipIcon.setTextureRect(TEXTURES.GetIconRectFromID(record->icon));
     chipIcon.setPosition(2.f*104.f, 65.0f + (32.f*i));
     ENGINE.Draw(chipIcon, false);
 
     chipLabel->setOrigin(0, 0);
     chipLabel->setFillColor(sf::Color::White);
     chipLabel->setPosition(2.f*120.f, 60.0f + (32.f*i));
-    chipLabel->setString(iter->GetShortName());
+    chipLabel->setString(std::string(record->name));
     ENGINE.Draw(chipLabel, false);
 
     //Draw rating
-    unsigned rarity = iter->GetRarity() - 1;
+    unsigned rarity = record->rarity - 1;
     stars.setTextureRect(sf::IntRect(0, 16 * rarity, 22, 16));
     stars.setPosition(2.f*199.f, 74.0f + (32.f*(float)i));
     ENGINE.Draw(stars, false);
@@ -378,32 +396,30 @@ void LibraryScene::onDraw(sf::RenderTexture& surface) {
       cursor.setPosition((2.f*90.f) + bounce, y);
       ENGINE.Draw(cursor);
 
-      sf::IntRect cardSubFrame = TEXTURES.GetCardRectFromID(iter->GetID());
+      sf::IntRect cardSubFrame = TEXTURES.GetCardRectFromID(record->id);
       chip.setTextureRect(cardSubFrame);
       chip.setScale((float)swoosh::ease::linear(chipRevealTimer.getElapsed().asSeconds(), 0.25f, 1.0f)*2.0f, 2.0f);
       ENGINE.Draw(chip, false);
 
       // This draws the currently highlighted chip
-      if (iter->GetDamage() > 0) {
+      if (record->damage > 0) {
         chipLabel->setFillColor(sf::Color::White);
-        chipLabel->setString(std::to_string(iter->GetDamage()));
+        chipLabel->setString(std::to_string(record->damage));
         chipLabel->setOrigin(chipLabel->getLocalBounds().width + chipLabel->getLocalBounds().left, 0);
         chipLabel->setPosition(2.f*(70.f), 135.f);
 
         ENGINE.Draw(chipLabel, false);
       }
 
-      std::string formatted = FormatChipDesc(iter->GetDescription());
+      std::string formatted = FormatChipDesc(std::string(record->description));
       chipDesc->setString(formatted);
       ENGINE.Draw(chipDesc, false);
 
-      int offset = (int)(iter->GetElement());
+      int offset = (int)(record->element);
       element.setTextureRect(sf::IntRect(14 * offset, 0, 14, 14));
       element.setPosition(2.f*25.f, 142.f);
       ENGINE.Draw(element, false);
     }
-
-    iter++;
   }
 
   ENGINE.Draw(textbox);
@@ -9,6 +9,7 @@
 #include "bnTextureResourceManager.h"
 #include "bnEngine.h"
 #include "bnChip.h"
+#include "bnChipQuery.h"
 #include "bnAnimation.h"
 #include "bnAnimatedTextBox.h"
 
@@ -47,6 +48,7 @@ private:
   sf::IntRect cardSubFrame; /*!< The frame of the current chip from the texture atlas */
 
   sf::Sprite chipIcon; /*!< The mini icon */
+  std::vector<TextureHandle> textures; /*!< Keeps the sprite textures loaded while the scene is alive */
   swoosh::Timer chipRevealTimer; /*!< Ease into the next chip for a flip effect */
   swoosh::Timer easeInTimer;
 
@@ -60,7 +62,7 @@ private:
   double frameElapsed; /*!< delta last frame time in seconds */
   bool gotoNextScene; /*!< If true, player cannot interact with scene */
 
-  std::list<Chip> uniqueChips; /*!< List of unique chips in pack */
+  ChipQuery uniqueChips; /*!< Unique chips in pack. Quick Opt changes the order. */
 
   /**
    * @brief Takes user's folder and puts unique chips in a list
@@ -69,6 +71,16 @@ private:
    */
   void MakeUniqueChipsFromPack();
 
+  /**
+   * @brief Sort the list by the next key and keep the highlighted chip selected
+   */
+  void NextSort();
+
+  /**
+   * @brief Keep the highlighted chip and the first row on screen inside the list
+   */
+  void ClampSelection();
+
 #ifdef __ANDROID__
     bool canSwipe;
     bool touchStart;
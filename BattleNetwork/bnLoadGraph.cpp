@@ -0,0 +1,118 @@
+#include "bnLoadGraph.h"
+#include "bnAssetLoader.h"
+
+#include <stdexcept>
+
+LoadGraph::LoadGraph() : finished(0), isStarted(false)
+{
+}
+
+LoadGraph::Node LoadGraph::Add(const Job& job, const std::vector<Node>& after)
+{
+  // An empty job would be mistaken for an event
+  return Insert(job ? job : Job([]() {}), after);
+}
+
+LoadGraph::Node LoadGraph::AddOnce(const std::string& key, const Job& job, const std::vector<Node>& after)
+{
+  auto iter = keys.find(key);
+
+  if (iter != keys.end()) return iter->second;
+
+  Node node = Add(job, after);
+  keys.insert(std::make_pair(key, node));
+
+  return node;
+}
+
+LoadGraph::Node LoadGraph::AddEvent(const std::vector<Node>& after)
+{
+  return Insert(nullptr, after);
+}
+
+LoadGraph::Node LoadGraph::Insert(const Job& job, const std::vector<Node>& after)
+{
+  if (isStarted) {
+    throw std::logic_error("Nodes cannot be added to a load graph after it starts");
+  }
+
+  Node node = nodes.size();
+  nodes.emplace_back();
+
+  Vertex& vertex = nodes.back();
+  vertex.job = job;
+  vertex.completed = false;
+  vertex.done = false;
+
+  // Jobs also wait for Start(). Events also wait for Complete().
+  vertex.waiting = (int)after.size() + (job ? 1 : 2);
+
+  for (Node before : after) {
+    nodes[before].next.push_back(node);
+  }
+
+  return node;
+}
+
+void LoadGraph::Start()
+{
+  if (isStarted) return;
+
+  isStarted = true;
+
+  for (Node node = 0; node < nodes.size(); node++) {
+    Release(node);
+  }
+}
+
+void LoadGraph::Complete(Node event)
+{
+  Vertex& vertex = nodes[event];
+
+  if (vertex.job || vertex.completed.exchange(true)) return;
+
+  Release(event);
+}
+
+void LoadGraph::Release(Node node)
+{
+  Vertex& vertex = nodes[node];
+
+  if (--vertex.waiting != 0) return;
+
+  if (!vertex.job) {
+    Finish(node);
+    return;
+  }
+
+  LOADER.Decode([this, node]() {
+    nodes[node].job();
+    Finish(node);
+  });
+}
+
+void LoadGraph::Finish(Node node)
+{
+  Vertex& vertex = nodes[node];
+  vertex.done = true;
+  finished++;
+
+  for (Node next : vertex.next) {
+    Release(next);
+  }
+}
+
+const bool LoadGraph::IsDone(Node node) const
+{
+  return nodes[node].done;
+}
+
+const bool LoadGraph::IsFinished() const
+{
+  return finished == nodes.size();
+}
+
+const std::size_t LoadGraph::GetSize() const
+{
+  return nodes.size();
+}
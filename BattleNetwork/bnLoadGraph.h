@@ -0,0 +1,126 @@
+/*! \file bnLoadGraph.h */
+
+/*! \brief Runs loading jobs on the asset loader as soon as what they need is loaded
+ *
+ * Every job is a node that lists the nodes it has to wait for. Nothing runs
+ * before Start(). After that a node is queued on the asset loader the moment
+ * the last node it waits for finishes, so independent jobs run side by side
+ * and nothing waits on work it does not need.
+ *
+ * AddOnce() shares one node between every job that needs the same thing. A
+ * texture that two navis use is loaded once and both navis wait for it.
+ *
+ * Event nodes have no job. They finish when Complete() is called, e.g. once
+ * the main thread sees that the media has finished loading.
+ *
+ * The graph must outlive the jobs it queued. Build it on one thread, then
+ * Complete() and the queries are safe from any thread.
+ */
+#pragma once
+#include <functional>
+#include <deque>
+#include <vector>
+#include <map>
+#include <string>
+#include <atomic>
+#include <cstddef>
+
+class LoadGraph {
+public:
+  typedef std::size_t Node;
+  typedef std::function<void()> Job;
+
+  LoadGraph();
+
+  /**
+   * @brief Add a job
+   * @param job runs on a worker thread
+   * @param after nodes that must finish first
+   * @return node
+   */
+  Node Add(const Job& job, const std::vector<Node>& after = {});
+
+  /**
+   * @brief Add a job unless one was already added with the same key
+   * @param key names what the job loads, e.g. a texture path
+   * @param job runs on a worker thread
+   * @param after nodes that must finish first. Ignored if the key exists.
+   * @return the new node or the one already added for the key
+   */
+  Node AddOnce(const std::string& key, const Job& job, const std::vector<Node>& after = {});
+
+  /**
+   * @brief Add a node that finishes when Complete() is called
+   * @param after nodes that must also finish first
+   * @return node
+   */
+  Node AddEvent(const std::vector<Node>& after = {});
+
+  /**
+   * @brief Queue every node that is not waiting on anything. No nodes can be added after this.
+   */
+  void Start();
+
+  /**
+   * @brief Mark an event as happened. Does nothing the second time.
+   * @param event node from AddEvent()
+   */
+  void Complete(Node event);
+
+  /**
+   * @brief Query if a node has finished
+   * @param node
+   * @return true if finished
+   */
+  const bool IsDone(Node node) const;
+
+  /**
+   * @brief Query if every node has finished
+   * @return true if finished
+   */
+  const bool IsFinished() const;
+
+  /**
+   * @brief Query the number of nodes
+   * @return count
+   */
+  const std::size_t GetSize() const;
+
+private:
+  /**
+   * @struct Vertex
+   * @brief One node and what waits on it
+   */
+  struct Vertex {
+    Job job;
+    std::vector<Node> next; /*!< Nodes waiting on this one */
+    std::atomic<int> waiting; /*!< Unfinished nodes before this one plus one for Start() and one for Complete() */
+    std::atomic<bool> completed; /*!< Complete() was called */
+    std::atomic<bool> done;
+  };
+
+  /**
+   * @brief Append a node
+   * @param job empty for an event
+   * @param after
+   * @return node
+   */
+  Node Insert(const Job& job, const std::vector<Node>& after);
+
+  /**
+   * @brief Count down something a node waits for. Queues it when nothing is left.
+   * @param node
+   */
+  void Release(Node node);
+
+  /**
+   * @brief Mark a node done and release the nodes waiting on it
+   * @param node
+   */
+  void Finish(Node node);
+
+  std::deque<Vertex> nodes; /*!< Deque so nodes never move while jobs hold them */
+  std::map<std::string, Node> keys; /*!< AddOnce() key to node */
+  std::atomic<std::size_t> finished; /*!< Nodes that are done */
+  bool isStarted;
+};
@@ -1,6 +1,394 @@
 #include "bnLogger.h"
 
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <cctype>
+
+#if defined(__ANDROID__)
+#include <android/log.h>
+#endif
+
 // explicitely define static member variables
 std::mutex Logger::m;
-std::queue<std::string> Logger::logs = std::queue<std::string>();
-std::ofstream Logger::file;
\ No newline at end of file
+std::atomic<int> Logger::thresholds[static_cast<int>(LogCategory::SIZE)] = {
+  LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL,
+  LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL
+};
+
+namespace {
+  static_assert(static_cast<int>(LogCategory::SIZE) == 7, "Give every category a threshold and a name");
+
+  const char* LEVEL_NAMES[] = { "TRACE", "DEBUG", "INFO", "WARN", "ERROR", "NONE" };
+  const char* CATEGORY_NAMES[] = { "Core", "Battle", "Chips", "Content", "Sound", "Script", "Menus" };
+
+  bool EqualsNoCase(std::string_view a, const char* b) {
+    std::size_t i = 0;
+
+    for (; i < a.size() && b[i]; i++) {
+      if (std::toupper((unsigned char)a[i]) != std::toupper((unsigned char)b[i])) return false;
+    }
+
+    return i == a.size() && !b[i];
+  }
+
+  static_assert((LOG_CAPACITY & (LOG_CAPACITY - 1)) == 0, "LOG_CAPACITY must be a power of 2");
+
+  /**
+   * @class Backend
+   * @brief Ring buffer of formatted messages and the thread that writes them
+   *
+   * Bounded multi producer queue. Every slot has a sequence number that says
+   * whose turn it is. A producer claims a slot by moving head forward, fills
+   * it and publishes it by bumping the sequence. Only the flusher moves tail.
+   */
+  class Backend {
+  public:
+    Backend() : head(0), tail(0), dropped(0), reported(0), flushRequests(0), flushed(0), isRunning(true), file(nullptr) {
+      for (std::size_t i = 0; i < LOG_CAPACITY; i++) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+      }
+
+      thread = std::thread(&Backend::Work, this);
+    }
+
+    ~Backend() {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        isRunning = false;
+      }
+
+      wake.notify_all();
+      thread.join();
+
+      if (file) {
+        std::fclose(file);
+      }
+    }
+
+    /**
+     * @brief Claim a slot
+     * @return slot to fill then Publish() or nullptr if the ring is full
+     */
+    char* Claim(std::size_t& pos) {
+      pos = head.load(std::memory_order_relaxed);
+
+      while (true) {
+        Record& record = ring[pos & (LOG_CAPACITY - 1)];
+        std::size_t sequence = record.sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)pos;
+
+        if (diff == 0) {
+          if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            // Wake the flusher early every half ring so a burst is written before the ring fills
+            if ((pos & (LOG_CAPACITY / 2 - 1)) == LOG_CAPACITY / 2 - 1) {
+              wake.notify_one();
+            }
+
+            return record.text;
+          }
+        }
+        else if (diff < 0) {
+          // The flusher has not freed this slot yet
+          dropped.fetch_add(1, std::memory_order_relaxed);
+          wake.notify_one();
+          return nullptr;
+        }
+        else {
+          pos = head.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    /**
+     * @brief Hand a filled slot to the flusher
+     * @param pos from Claim()
+     * @param length bytes of text in the slot
+     */
+    void Publish(std::size_t pos, std::size_t length) {
+      Record& record = ring[pos & (LOG_CAPACITY - 1)];
+      record.length = (unsigned short)length;
+      record.sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    void Flush() {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      // Everything claimed before now is written by the time the flusher gets past this position
+      std::size_t until = head.load(std::memory_order_acquire);
+      flushRequests++;
+      wake.notify_all();
+
+      done.wait(lock, [this, until]() { return flushed >= until || !isRunning; });
+      flushRequests--;
+    }
+
+    bool PopDisplay(std::string& next) {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      if (display.empty()) return false;
+
+      next = std::move(display.front());
+      display.pop_front();
+      return true;
+    }
+
+    unsigned long long GetDropped() const {
+      return dropped.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct Record {
+      std::atomic<std::size_t> sequence;
+      unsigned short length;
+      char text[LOG_RECORD_BYTES];
+    };
+
+    void Work() {
+      std::string batch;
+      std::vector<std::string> lines;
+
+      std::unique_lock<std::mutex> lock(mutex);
+
+      while (true) {
+        bool stopping = !isRunning;
+        lock.unlock();
+
+        batch.clear();
+        lines.clear();
+
+        std::size_t end = Drain(batch, lines);
+        Report(batch, lines);
+        Write(batch);
+
+        lock.lock();
+
+        for (auto& line : lines) {
+          if (display.size() == LOG_DISPLAY_LINES) {
+            display.pop_front();
+          }
+
+          display.push_back(std::move(line));
+        }
+
+        flushed = end;
+        done.notify_all();
+
+        if (stopping && lines.empty()) break;
+
+        if (lines.empty() && isRunning && flushRequests == 0) {
+          wake.wait_for(lock, std::chrono::milliseconds(LOG_FLUSH_MILLISECONDS));
+        }
+      }
+    }
+
+    /**
+     * @brief Take every published message out of the ring
+     * @return position of the first slot not taken
+     */
+    std::size_t Drain(std::string& batch, std::vector<std::string>& lines) {
+      while (true) {
+        Record& record = ring[tail & (LOG_CAPACITY - 1)];
+
+        if (record.sequence.load(std::memory_order_acquire) != tail + 1) break;
+
+        lines.emplace_back(record.text, record.length);
+        batch.append(record.text, record.length);
+        batch.push_back('\n');
+
+        // Free the slot for the producer that wraps around to it
+        record.sequence.store(tail + LOG_CAPACITY, std::memory_order_release);
+        tail++;
+      }
+
+      return tail;
+    }
+
+    /**
+     * @brief Add a line for messages dropped since the last report
+     */
+    void Report(std::string& batch, std::vector<std::string>& lines) {
+      unsigned long long total = dropped.load(std::memory_order_relaxed);
+
+      if (total == reported) return;
+
+      std::string line = "[Logger] Dropped " + std::to_string(total - reported) + " messages. The log buffer was full.";
+      reported = total;
+
+      batch += line + "\n";
+      lines.push_back(std::move(line));
+    }
+
+    /**
+     * @brief Write a batch to the file and the console with one call each
+     */
+    void Write(const std::string& batch) {
+      if (batch.empty()) return;
+
+      if (!file) {
+        file = std::fopen("log.txt", "w");
+
+        if (file) {
+          std::fprintf(file, "StartTime %lld\n", (long long)std::time(0));
+        }
+      }
+
+      if (file) {
+        std::fwrite(batch.data(), 1, batch.size(), file);
+        std::fflush(file);
+      }
+
+#if defined(__ANDROID__)
+      __android_log_print(ANDROID_LOG_INFO, "open mmbn engine", "%s", batch.c_str());
+#else
+      std::fwrite(batch.data(), 1, batch.size(), stderr);
+#endif
+    }
+
+    Record ring[LOG_CAPACITY];
+    std::atomic<std::size_t> head; /*!< Next slot to claim */
+    std::size_t tail; /*!< Next slot to write. Only the flusher uses it. */
+    std::atomic<unsigned long long> dropped;
+    unsigned long long reported; /*!< Dropped messages already written about */
+
+    std::mutex mutex; /*!< Guards everything below. Never taken by Log(). */
+    std::condition_variable wake; /*!< Wakes the flusher early */
+    std::condition_variable done; /*!< Wakes Flush() after a batch is written */
+    std::deque<std::string> display; /*!< Written messages for GetNextLog() */
+    unsigned flushRequests; /*!< Callers waiting in Flush() */
+    std::size_t flushed; /*!< Every slot before this has been written */
+    bool isRunning;
+    std::FILE* file;
+    std::thread thread;
+  };
+
+  Backend& GetBackend() {
+    static Backend backend;
+    return backend;
+  }
+}
+
+const bool Logger::GetNextLog(std::string& next) {
+  return GetBackend().PopDisplay(next);
+}
+
+void Logger::Log(const string& _message) {
+  if (_message.empty())
+    return;
+
+  Backend& backend = GetBackend();
+  std::size_t pos;
+  char* text = backend.Claim(pos);
+
+  if (!text) return;
+
+  std::size_t length = std::min(_message.size(), (std::size_t)LOG_RECORD_BYTES - 1);
+  std::memcpy(text, _message.data(), length);
+  backend.Publish(pos, length);
+}
+
+void Logger::Logf(const char* fmt, ...) {
+  Backend& backend = GetBackend();
+  std::size_t pos;
+  char* text = backend.Claim(pos);
+
+  if (!text) return;
+
+  va_list vl;
+  va_start(vl, fmt);
+  int length = vsnprintf(text, LOG_RECORD_BYTES, fmt, vl);
+  va_end(vl);
+
+  // Longer messages were cut short
+  length = std::max(0, std::min(length, LOG_RECORD_BYTES - 1));
+  backend.Publish(pos, (std::size_t)length);
+}
+
+void Logger::LogAt(int level, LogCategory category, const char* fmt, ...) {
+  Backend& backend = GetBackend();
+  std::size_t pos;
+  char* text = backend.Claim(pos);
+
+  if (!text) return;
+
+  int prefix = std::snprintf(text, LOG_RECORD_BYTES, "[%s][%s] ", LEVEL_NAMES[level], CATEGORY_NAMES[static_cast<int>(category)]);
+  prefix = std::max(0, std::min(prefix, LOG_RECORD_BYTES - 1));
+
+  va_list vl;
+  va_start(vl, fmt);
+  int length = vsnprintf(text + prefix, LOG_RECORD_BYTES - prefix, fmt, vl);
+  va_end(vl);
+
+  length = std::max(0, std::min(prefix + length, LOG_RECORD_BYTES - 1));
+  backend.Publish(pos, (std::size_t)length);
+}
+
+void Logger::SetLevel(LogCategory category, int level) {
+  thresholds[static_cast<int>(category)].store(level, std::memory_order_relaxed);
+}
+
+void Logger::SetLevel(int level) {
+  for (auto& threshold : thresholds) {
+    threshold.store(level, std::memory_order_relaxed);
+  }
+}
+
+void Logger::Configure(const std::map<std::string, std::string>& levels) {
+  auto all = levels.find("Level");
+
+  if (all != levels.end()) {
+    int level = ParseLevel(all->second);
+
+    if (level < 0) {
+      LOG_WARN(CORE, "Unknown log level %s", all->second.c_str());
+    }
+    else {
+      SetLevel(level);
+    }
+  }
+
+  for (auto& entry : levels) {
+    if (entry.first == "Level") continue;
+
+    LogCategory category = ParseCategory(entry.first);
+    int level = ParseLevel(entry.second);
+
+    if (category == LogCategory::SIZE || level < 0) {
+      LOG_WARN(CORE, "Unknown log setting %s=%s", entry.first.c_str(), entry.second.c_str());
+      continue;
+    }
+
+    SetLevel(category, level);
+  }
+}
+
+const int Logger::ParseLevel(std::string_view name) {
+  for (int i = 0; i <= LOG_LEVEL_NONE; i++) {
+    if (EqualsNoCase(name, LEVEL_NAMES[i])) return i;
+  }
+
+  return -1;
+}
+
+const LogCategory Logger::ParseCategory(std::string_view name) {
+  for (int i = 0; i < static_cast<int>(LogCategory::SIZE); i++) {
+    if (EqualsNoCase(name, CATEGORY_NAMES[i])) return static_cast<LogCategory>(i);
+  }
+
+  return LogCategory::SIZE;
+}
+
+void Logger::Flush() {
+  GetBackend().Flush();
+}
+
+const unsigned long long Logger::GetDropped() {
+  return GetBackend().GetDropped();
+}
@@ -1,3 +1,22 @@
+/*! \file bnLogger.h */
+
+/*! \brief Thread safe logging utility that writes on a background thread
+ *
+ * Log() and Logf() format the message into a slot of a fixed size ring
+ * buffer and return. Any thread can log at the same time without taking a
+ * lock. A flusher thread takes the messages out in batches and writes each
+ * batch to log.txt and the console with one call.
+ *
+ * The ring never grows. If it is full the message is dropped and counted,
+ * and the flusher writes how many were lost once there is room again.
+ * Messages longer than LOG_RECORD_BYTES are cut short.
+ *
+ * Prefer the leveled macros, e.g. LOG_DEBUG(BATTLE, "summon %s", name).
+ * Levels below LOG_COMPILE_LEVEL compile to nothing, arguments included.
+ * The rest are checked against a per category threshold set at run time from
+ * the [Log] section of options.ini. A message below the threshold costs one
+ * relaxed atomic load and its arguments are never evaluated or formatted.
+ */
 #pragma once
 #include <iostream>
 #include <string>
@@ -5,23 +24,72 @@
 #include <queue>
 #include <mutex>
 #include <fstream>
-
-#if defined(__ANDROID__)
-#include <android/log.h>
-#endif
+#include <atomic>
+#include <map>
+#include <string_view>
 
 using std::string;
 using std::to_string;
 using std::cerr;
 using std::endl;
 
-/*! \brief Thread safe logging utility logs directly to a file */
+/*! \brief Number of messages the ring buffer holds. Must be a power of 2. */
+#define LOG_CAPACITY 1024
+
+/*! \brief Longest message in bytes including the terminator */
+#define LOG_RECORD_BYTES 512
+
+/*! \brief How long the flusher sleeps when there is nothing to write */
+#define LOG_FLUSH_MILLISECONDS 10
+
+/*! \brief Newest messages kept for GetNextLog() */
+#define LOG_DISPLAY_LINES 256
+
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_WARN  3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_NONE  5
+
+/*! \brief Lowest level that is compiled in. Release builds drop trace and debug messages. */
+#ifndef LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define LOG_COMPILE_LEVEL LOG_LEVEL_INFO
+#else
+#define LOG_COMPILE_LEVEL LOG_LEVEL_TRACE
+#endif
+#endif
+
+/*! \brief Level messages must reach to be written unless options.ini says otherwise */
+#define LOG_DEFAULT_LEVEL LOG_LEVEL_INFO
+
+/**
+ * @brief Part of the engine a message comes from. Each has its own run time threshold.
+ */
+enum class LogCategory : int {
+  CORE = 0, /*!< Start up, threads, config */
+  BATTLE,   /*!< Battle scene, summons, entities */
+  CHIPS,    /*!< Chip library, folders, program advances */
+  CONTENT,  /*!< Textures, shaders, animations, archives */
+  SOUND,
+  SCRIPT,
+  MENUS,    /*!< Every scene that is not a battle */
+  SIZE
+};
+
 class Logger {
 private:
   static std::mutex m;
-  static std::queue<std::string> logs; /*!< get the log stream in order */
-  static std::ofstream file; /*!< The file to write to */
+  static std::atomic<int> thresholds[static_cast<int>(LogCategory::SIZE)]; /*!< Lowest level written for each category */
+
 public:
+  /**
+   * @brief Mutex for callers that want several lines to stay together
+   * @return mutex
+   *
+   * Logging does not need it. It does not stop other threads from logging.
+   */
   static std::mutex* GetMutex() {
     return &m;
   }
@@ -29,76 +97,89 @@ public:
   /**
    * @brief Gets the next log and stores it in the input string
    * @param next input string to store result into
-   * @return true if there's more text. False if there's no text to input.
+   * @return true if there was a log. False if there's no text to input.
+   *
+   * Only the newest LOG_DISPLAY_LINES messages that have been written are kept for this
    */
-  static const bool GetNextLog(std::string &next) {
-    if (logs.size() == 0)
-      return false;
+  static const bool GetNextLog(std::string &next);
 
-    next = logs.front();
-    logs.pop();
+  /**
+   * @brief Queue a message to be written
+   * @param _message
+   */
+  static void Log(const string& _message);
 
-    return (logs.size()+1 > 0);
+  /**
+   * @brief Uses varadic args to print any string format
+   * @param fmt string format
+   * @param ... input to match the format
+   */
+  static void Logf(const char* fmt, ...);
+
+  /**
+   * @brief Logf with the level and category in front. Use the LOG_ macros instead.
+   * @param level LOG_LEVEL_ value
+   * @param category
+   * @param fmt string format
+   * @param ... input to match the format
+   */
+  static void LogAt(int level, LogCategory category, const char* fmt, ...);
+
+  /**
+   * @brief Query if a message would be written at run time
+   * @param level LOG_LEVEL_ value
+   * @param category
+   * @return true if level is at or above the category's threshold
+   */
+  static const bool IsEnabled(int level, LogCategory category) {
+    return level >= thresholds[static_cast<int>(category)].load(std::memory_order_relaxed);
   }
 
   /**
-   * @brief If first time opening, timestamps file and pushes message to file
-   * @param _message
+   * @brief Set the lowest level written for one category
+   * @param category
+   * @param level LOG_LEVEL_ value
    */
-  static void Log(string _message) {
-    if (_message.empty())
-      return;
+  static void SetLevel(LogCategory category, int level);
 
-    if (!file.is_open()) {
-      file.open("log.txt");
-      file << "StartTime " << time(0) << endl;
-    }
+  /**
+   * @brief Set the lowest level written for every category
+   * @param level LOG_LEVEL_ value
+   */
+  static void SetLevel(int level);
 
-#if defined(__ANDROID__)
-    __android_log_print(ANDROID_LOG_INFO,"open mmbn engine","%s",_message.c_str());
-#else
-    cerr << _message << endl;
-#endif
+  /**
+   * @brief Apply the [Log] section of options.ini
+   * @param levels "Level" for every category or a category name, to a level name
+   *
+   * "Level" is applied first so categories can override it. Unknown names are logged and skipped.
+   */
+  static void Configure(const std::map<std::string, std::string>& levels);
 
-    logs.push(_message);
-    file << _message << endl;
-  }
-  
   /**
-   * @brief Uses varadic args to print any string format
-   * @param fmt string format
-   * @param ... input to match the format 
+   * @brief Get a level from its name
+   * @param name e.g. "DEBUG". Not case sensitive.
+   * @return LOG_LEVEL_ value or -1 if unknown
    */
-  static void Logf(const char* fmt, ...) {
-    int size = 512;
-    char* buffer = 0;
-    buffer = new char[size];
-    va_list vl;
-    va_start(vl, fmt);
-    int nsize = vsnprintf(buffer, size, fmt, vl);
-    if (size <= nsize) {
-      delete[] buffer;
-      buffer = 0;
-      buffer = new char[nsize + 1];
-      nsize = vsnprintf(buffer, size, fmt, vl);
-    }
-    std::string ret(buffer);
-    va_end(vl);
-    delete[] buffer;
-    cerr << ret << endl;
-    logs.push(ret);
-
-#if defined(__ANDROID__)
-    __android_log_print(ANDROID_LOG_INFO,"open mmbn engine","%s",ret.c_str());
-#else
-    if (!file.is_open()) {
-      file.open("log.txt");
-      file << "StartTime " << time(0) << endl;
-    }
+  static const int ParseLevel(std::string_view name);
 
-    file << ret << endl;
-#endif
-  }
+  /**
+   * @brief Get a category from its name
+   * @param name e.g. "Battle". Not case sensitive.
+   * @return category or LogCategory::SIZE if unknown
+   */
+  static const LogCategory ParseCategory(std::string_view name);
+
+  /**
+   * @brief Blocks until every message logged before the call has been written
+   */
+  static void Flush();
+
+  /**
+   * @brief Query how many messages were lost because the ring buffer was full
+   * @return count since start up
+   */
+  static const unsigned long long GetDropped();
 
   static string ToString(float _number) {
     return to_string(_number);
@@ -106,9 +187,42 @@ public:
 
 private:
   Logger() { ; }
-  
-  /**
-   * @brief Dumps queue and closes file
-   */
-  ~Logger() { file.close(); while (!logs.empty()) { logs.pop(); }  }
-};
\ No newline at end of file
+};
+
+/*! \brief Writes a message if the category's run time threshold allows it */
+#define LOG_AT(level, category, ...) \
+  do { \
+    if (Logger::IsEnabled(level, LogCategory::category)) { \
+      Logger::LogAt(level, LogCategory::category, __VA_ARGS__); \
+    } \
+  } while (0)
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_TRACE
+#define LOG_TRACE(category, ...) LOG_AT(LOG_LEVEL_TRACE, category, __VA_ARGS__)
+#else
+#define LOG_TRACE(category, ...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(category, ...) LOG_AT(LOG_LEVEL_DEBUG, category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(category, ...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(category, ...) LOG_AT(LOG_LEVEL_INFO, category, __VA_ARGS__)
+#else
+#define LOG_INFO(category, ...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(category, ...) LOG_AT(LOG_LEVEL_WARN, category, __VA_ARGS__)
+#else
+#define LOG_WARN(category, ...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(category, ...) LOG_AT(LOG_LEVEL_ERROR, category, __VA_ARGS__)
+#else
+#define LOG_ERROR(category, ...) ((void)0)
+#endif
@@ -41,7 +41,7 @@ MainMenuScene::MainMenuScene(swoosh::ActivityController& controller) :
   selectInputCooldown = maxSelectInputCooldown;
 
   // ui sprite maps
-  ui = sf::Sprite(LOAD_TEXTURE(MAIN_MENU_UI));
+  ui = sf::Sprite(HOLD_TEXTURE(textures, MAIN_MENU_UI));
   ui.setScale(2.f, 2.f);
   uiAnimator = Animation("resources/ui/main_menu_ui.animation");
   uiAnimator.Reload();
@@ -49,7 +49,7 @@ MainMenuScene::MainMenuScene(swoosh::ActivityController& controller) :
   // Keep track of selected navi
   currentNavi = 0;
 
-  owNavi = sf::Sprite(LOAD_TEXTURE(NAVI_MEGAMAN_ATLAS));
+  owNavi = sf::Sprite(HOLD_TEXTURE(textures, NAVI_MEGAMAN_ATLAS));
   owNavi.setScale(2.f, 2.f);
   owNavi.setPosition(0, 0.f);
   naviAnimator = Animation("resources/navis/megaman/megaman.animation");
@@ -61,10 +61,10 @@ MainMenuScene::MainMenuScene(swoosh::ActivityController& controller) :
   // Map will transform navi's ortho position into isometric position
   map->AddSprite(&owNavi);
 
-  overlay = sf::Sprite(LOAD_TEXTURE(MAIN_MENU));
+  overlay = sf::Sprite(HOLD_TEXTURE(textures, MAIN_MENU));
   overlay.setScale(2.f, 2.f);
 
-  ow = sf::Sprite(LOAD_TEXTURE(MAIN_MENU_OW));
+  ow = sf::Sprite(HOLD_TEXTURE(textures, MAIN_MENU_OW));
   ow.setScale(2.f, 2.f);
 
   gotoNextScene = true;
@@ -46,6 +46,7 @@ private:
 
   SelectedNavi currentNavi; /*!< Current navi selection index */
   sf::Sprite owNavi; /*!< Overworld navi sprite */
+  std::vector<TextureHandle> textures; /*!< Keeps the sprite textures loaded while the scene is alive */
   Animation naviAnimator; /*!< Animators navi sprite */
  
   bool gotoNextScene; /*!< If true, player cannot interact with screen yet */
@@ -36,7 +36,7 @@ private:
       animation->SetAnimation("Head1");
       animation->SetPlaybackSpeed(0); 
       setScale(2.f, 2.f);
-      setTexture(*TEXTURES.GetTexture(TextureType::MOB_MEGALIAN_ATLAS));
+      setTexture(TEXTURES.LoadTexture(TextureType::MOB_MEGALIAN_ATLAS));
       animation->OnUpdate(0);
       this->SetLayer(-1); // on top of base
       this->SetHealth(base->GetHealth());
@@ -132,7 +132,7 @@ private:
           base->FinishMove();
           this->SetDirection(Direction::LEFT);
 
-          Logger::Log("tele1: " + std::to_string(tele1) + " tele2: " + std::to_string(tele2));
+          LOG_TRACE(BATTLE, "tele1: %i tele2: %i", (int)tele1, (int)tele2);
 
           lastTile = GetTile();
         }
@@ -143,7 +143,7 @@ private:
 
           this->SetSlideTime(sf::milliseconds(250 + (adjusted * 500)));
 
-          Logger::Log("timer: " + std::to_string(timer-5.0) + " adjusted: " + std::to_string(adjusted) + " SetSlideTime: " + std::to_string(250 + (adjusted * 500)));
+          LOG_TRACE(BATTLE, "timer: %f adjusted: %i SetSlideTime: %i", timer - 5.0, adjusted, 250 + (adjusted * 500));
 
           if(playOnce) {
             AUDIO.Play(AudioType::TOSS_ITEM_LITE);
@@ -9,14 +9,13 @@
 
 Megaman::Megaman() : Player() {
 
-  auto base_palette = TEXTURES.LoadTextureFromFile("resources/navis/megaman/forms/base.palette.png");
-  PaletteSwap* pswap = new PaletteSwap(this, *base_palette);
+  auto base_palette = TEXTURES.LoadTexture("resources/navis/megaman/forms/base.palette.png");
+  PaletteSwap* pswap = new PaletteSwap(this, base_palette);
   RegisterComponent(pswap);
-  delete base_palette;
 
   SetHealth(900);
   SetName("Megaman");
-  setTexture(*TEXTURES.GetTexture(TextureType::NAVI_MEGAMAN_ATLAS));
+  setTexture(TEXTURES.LoadTexture(TextureType::NAVI_MEGAMAN_ATLAS));
 
   this->AddForm<TenguCross>()->SetUIPath("resources/navis/megaman/forms/tengu_entry.png");
   this->AddForm<HeatCross>()->SetUIPath("resources/navis/megaman/forms/heat_entry.png");
@@ -72,9 +71,9 @@ void TenguCross::OnActivate(Player& player)
 {
   overlayAnimation = Animation("resources/navis/megaman/forms/tengu_cross.animation");
   overlayAnimation.Load();
-  auto cross = TextureResourceManager::GetInstance().LoadTextureFromFile("resources/navis/megaman/forms/tengu_cross.png");
+  auto cross = TEXTURES.LoadTexture("resources/navis/megaman/forms/tengu_cross.png");
   overlay = new SpriteSceneNode();
-  overlay->setTexture(*cross);
+  overlay->setTexture(cross);
   overlay->SetLayer(-1);
   overlay->EnableParentShader(false);
 
@@ -144,9 +143,9 @@ void HeatCross::OnActivate(Player& player)
 {
   overlayAnimation = Animation("resources/navis/megaman/forms/heat_cross.animation");
   overlayAnimation.Load();
-  auto cross = TextureResourceManager::GetInstance().LoadTextureFromFile("resources/navis/megaman/forms/heat_cross.png");
+  auto cross = TEXTURES.LoadTexture("resources/navis/megaman/forms/heat_cross.png");
   overlay = new SpriteSceneNode();
-  overlay->setTexture(*cross);
+  overlay->setTexture(cross);
   overlay->SetLayer(-1);
   overlay->EnableParentShader(false);
 
@@ -221,9 +220,9 @@ void TomahawkCross::OnActivate(Player& player)
 {
   overlayAnimation = Animation("resources/navis/megaman/forms/hawk_cross.animation");
   overlayAnimation.Load();
-  auto cross = TextureResourceManager::GetInstance().LoadTextureFromFile("resources/navis/megaman/forms/hawk_cross.png");
+  auto cross = TEXTURES.LoadTexture("resources/navis/megaman/forms/hawk_cross.png");
   overlay = new SpriteSceneNode();
-  overlay->setTexture(*cross);
+  overlay->setTexture(cross);
   overlay->SetLayer(-1);
   overlay->EnableParentShader(false);
 
@@ -2,7 +2,8 @@
 #include "bnAnimatedTextBox.h"
 #include "bnTextureResourceManager.h"
 Message::Message(std::string message) : MessageInterface(message) {
-  nextCursor = sf::Sprite(LOAD_TEXTURE(TEXT_BOX_NEXT_CURSOR));
+  nextCursorTexture = TEXTURES.LoadTexture(TextureType::TEXT_BOX_NEXT_CURSOR);
+  nextCursor = sf::Sprite(*nextCursorTexture);
   totalElapsed = 0;
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "bnMessageInterface.h"
+#include "bnTextureResourceManager.h"
 #include <string>
 
 /**
@@ -10,6 +11,7 @@
    */
 class Message : public MessageInterface {
   mutable sf::Sprite nextCursor; /*!< Green cursor at bottom-right */
+  TextureHandle nextCursorTexture; /*!< Keeps the cursor texture loaded */
   double totalElapsed;
 public:
   Message(std::string message);
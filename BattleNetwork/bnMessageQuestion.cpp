@@ -6,7 +6,8 @@ Question::Question(std::string message, std::function<void()> onYes, std::functi
   this->onNo = onNo;
   this->onYes = onYes;
   this->isQuestionReady = false;
-  selectCursor = sf::Sprite(LOAD_TEXTURE(TEXT_BOX_CURSOR));
+  selectCursorTexture = TEXTURES.LoadTexture(TextureType::TEXT_BOX_CURSOR);
+  selectCursor = sf::Sprite(*selectCursorTexture);
   elapsed = 0;
   yes = canceled = false;
 }
@@ -20,6 +20,7 @@ private:
   std::function<void()> onNo; /*!< Callback when user presses no */
   bool isQuestionReady; /*!< Flag for when the user has been prompted and input is waiting */
   mutable sf::Sprite selectCursor; /*!< Used for making selections */
+  TextureHandle selectCursorTexture; /*!< Keeps the cursor texture loaded */
   double elapsed;
   sf::Text options;
 public:
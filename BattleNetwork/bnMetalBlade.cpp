@@ -10,8 +10,8 @@ MetalBlade::MetalBlade(Field* _field, Team _team, double speed) : Spell(_field,
 
   SetLayer(0);
 
-  auto texture = TEXTURES.GetTexture(TextureType::MOB_METALMAN_ATLAS);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::MOB_METALMAN_ATLAS);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   this->speed = speed;
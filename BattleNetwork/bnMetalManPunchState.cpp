@@ -29,21 +29,21 @@ void MetalManPunchState::OnEnter(MetalMan& metal) {
 
 
     auto onFinish = [metal = &metal, nextTile, lastTile, this]() {
-      Logger::Log("metalman move on finish called");
+      LOG_TRACE(BATTLE, "metalman move on finish called");
 
       metal->Teleport(nextTile->GetX(), nextTile->GetY());
       metal->AdoptNextTile();
       metal->FinishMove();
 
       auto onFinishPunch = [m = metal, lastTile]() { 
-        Logger::Log("finish punch called");
+        LOG_TRACE(BATTLE, "finish punch called");
         m->Teleport(lastTile->GetX(), lastTile->GetY());
         m->AdoptNextTile();
         m->FinishMove();
         m->GoToNextState(); 
       };
       auto onGroundHit = [this, m = metal]() {       
-        Logger::Log("on ground hit called"); 
+        LOG_TRACE(BATTLE, "on ground hit called");
         this->Attack(*m); 
       };
 
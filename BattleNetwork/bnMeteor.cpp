@@ -14,8 +14,8 @@ Meteor::Meteor(Field* _field, Team _team, Battle::Tile* target, int damage, floa
 
   this->HighlightTile(Battle::Tile::Highlight::flash);
 
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_METEOR);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_METEOR);
+  setTexture(texture);
 
   setScale(0.f, 0.f);
 
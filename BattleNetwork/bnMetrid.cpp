@@ -42,7 +42,7 @@ Metrid::Metrid(Rank _rank)
 
   hitHeight = 60;
 
-  setTexture(*TEXTURES.GetTexture(TextureType::MOB_METRID));
+  setTexture(TEXTURES.LoadTexture(TextureType::MOB_METRID));
   setScale(2.f, 2.f);
   animationComponent->SetPlaybackMode(Animator::Mode::Loop);
 
@@ -34,7 +34,7 @@ Mettaur::Mettaur(Rank _rank)
 
   hitHeight = 60;
 
-  setTexture(*TEXTURES.GetTexture(TextureType::MOB_METTAUR));
+  setTexture(TEXTURES.LoadTexture(TextureType::MOB_METTAUR));
 
   setScale(2.f, 2.f);
 
@@ -66,7 +66,7 @@ void Mettaur::OnUpdate(float _elapsed) {
 }
 
 const bool Mettaur::OnHit(const Hit::Properties props) {
-    Logger::Log("Mettaur OnHit");
+    LOG_TRACE(BATTLE, "Mettaur OnHit");
 
   return true;
 }
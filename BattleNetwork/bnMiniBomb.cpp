@@ -17,8 +17,8 @@ MiniBomb::MiniBomb(Field* _field, Team _team, sf::Vector2f startPos, float _dura
 
   this->HighlightTile(Battle::Tile::Highlight::flash);
 
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_MINI_BOMB);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_MINI_BOMB);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   SetLayer(-1);
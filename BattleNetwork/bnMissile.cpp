@@ -14,8 +14,8 @@ Missile::Missile(Field* _field, Team _team, Battle::Tile* target, float _duratio
 
 
     goingUp = true;
-    auto texture = TEXTURES.GetTexture(TextureType::MOB_METALMAN_ATLAS);
-    setTexture(*texture);
+    auto texture = TEXTURES.LoadTexture(TextureType::MOB_METALMAN_ATLAS);
+    setTexture(texture);
 
     anim = new AnimationComponent(this);
     this->RegisterComponent(anim);
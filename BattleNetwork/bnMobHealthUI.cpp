@@ -13,7 +13,8 @@ MobHealthUI::MobHealthUI(Character* _mob)
   healthCounter = mob->GetHealth();
   cooldown = 0;
   color = sf::Color::White;
-  glyphs.setTexture(LOAD_TEXTURE(ENEMY_HP_NUMSET));
+  glyphsTexture = TEXTURES.LoadTexture(TextureType::ENEMY_HP_NUMSET);
+  glyphs.setTexture(*glyphsTexture);
   glyphs.setScale(2.f, 2.f);
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "bnUIComponent.h"
+#include "bnTextureResourceManager.h"
 using sf::Font;
 using sf::Text;
 class Character;
@@ -46,6 +47,7 @@ private:
   Character * mob; /*!< Owner of health */
   sf::Color color; /*!< Color of the glyphs */
   mutable sf::Sprite glyphs; /*!< Drawable texture */
+  TextureHandle glyphsTexture; /*!< Keeps the glyph texture loaded */
   int healthCounter; /*!< mob's current health */
   double cooldown; /*!< Time after dial to uncolorize */
 };
\ No newline at end of file
@@ -4,8 +4,9 @@
 #include <exception>
 #include <atomic>
 #include <thread>
+#include <chrono>
 
-MobRegistration::MobMeta::MobMeta() : placeholderTexture(nullptr)
+MobRegistration::MobMeta::MobMeta()
 {
   mobFactory = nullptr;
   name = "Unknown";
@@ -20,10 +21,6 @@ MobRegistration::MobMeta::~MobMeta()
   if (mobFactory) {
     delete mobFactory;
   }
-
-  if (placeholderTexture) {
-    delete placeholderTexture;
-  }
 }
 
 MobRegistration::MobMeta& MobRegistration::MobMeta::SetPlaceholderTexturePath(std::string path)
@@ -62,9 +59,21 @@ MobRegistration::MobMeta & MobRegistration::MobMeta::SetName(const std::string &
   return *this;
 }
 
+MobRegistration::MobMeta& MobRegistration::MobMeta::SetTextures(const std::vector<TextureType>& textures)
+{
+  this->textures = textures;
+  return *this;
+}
+
+MobRegistration::MobMeta& MobRegistration::MobMeta::SetAnimationPaths(const std::vector<std::string>& paths)
+{
+  this->animations = paths;
+  return *this;
+}
+
 const sf::Texture* MobRegistration::MobMeta::GetPlaceholderTexture() const
 {
-  return this->placeholderTexture;
+  return this->placeholderTexture.get();
 }
 
 const std::string MobRegistration::MobMeta::GetPlaceholderTexturePath() const
@@ -139,15 +148,32 @@ const unsigned MobRegistration::Size()
   return (unsigned)roster.size();
 }
 
-void MobRegistration::LoadAllMobs(std::atomic<int>& progress)
+void MobRegistration::Prefetch(int index)
+{
+  if (index < 0 || index >= (int)Size()) return;
+
+  prefetch.Request(roster[index]->textures, roster[index]->animations);
+}
+
+void MobRegistration::LoadAllMobs(LoadGraph& graph, LoadGraph::Node field, std::atomic<int>& progress)
 {
+  auto begin = std::chrono::steady_clock::now();
+  std::vector<LoadGraph::Node> mobs;
+
+  // Enemy textures are left for Prefetch() so they are only loaded for mobs that are picked
   for (int i = 0; i < (int)Size(); i++) {
-    roster[i]->loadMobClass();
+    const MobMeta* meta = roster[i];
 
-    Logger::GetMutex()->lock();
-    Logger::Logf("Loaded mob: %s", roster[i]->GetName().c_str());
-    Logger::GetMutex()->unlock();
+    mobs.push_back(graph.Add([meta, &progress]() {
+      meta->loadMobClass();
 
-    progress++;
+      LOG_INFO(CONTENT, "Loaded mob: %s", meta->GetName().c_str());
+
+      progress++;
+    }, { field }));
   }
+
+  graph.Add([begin]() {
+    LOG_INFO(CONTENT, "Loaded registered mobs: %f secs", std::chrono::duration<float>(std::chrono::steady_clock::now() - begin).count());
+  }, mobs);
 }
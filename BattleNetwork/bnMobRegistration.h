@@ -12,6 +12,8 @@
 #include "bnTextureResourceManager.h"
 #include "bnField.h"
 #include "bnMobFactory.h"
+#include "bnAssetPrefetch.h"
+#include "bnLoadGraph.h"
 
 class Mob;
 
@@ -30,10 +32,12 @@ public:
     std::string name;       /*!< Name of the mob */
     std::string description;/*!< Description of mob that shows up in the text box */
     std::string placeholderPath; /*!< Path to the preview image */
-    sf::Texture* placeholderTexture; /*!< Texture of the preview image */
+    TextureHandle placeholderTexture; /*!< Texture of the preview image */
     int atk; /*!< Strength of mob to display */
     double speed; /*!< Speed of mob to display */
     int hp; /*!< Total health of mob to display */
+    std::vector<TextureType> textures; /*!< Textures the enemies load when the mob is built */
+    std::vector<std::string> animations; /*!< Animation files the enemies load when the mob is built */
 
     std::function<void()> loadMobClass; /*!< Deferred mob loader function */
     public:
@@ -94,6 +98,20 @@ public:
      * @return MobMeta& to chain
      */
     MobMeta& SetName(const std::string& name);
+
+    /**
+     * @brief Sets the textures the mob's enemies use
+     * @param textures prefetched on the select screen
+     * @return MobMeta& to chain
+     */
+    MobMeta& SetTextures(const std::vector<TextureType>& textures);
+
+    /**
+     * @brief Sets the animation files the mob's enemies use
+     * @param paths prefetched on the select screen
+     * @return MobMeta& to chain
+     */
+    MobMeta& SetAnimationPaths(const std::vector<std::string>& paths);
     
     /**
      * @brief Gets the preview texture
@@ -146,6 +164,7 @@ public:
 
 private:
   std::vector<const MobMeta*> roster; /*!< List of all mobs registered */
+  AssetPrefetch prefetch; /*!< Assets of the highlighted mob */
 
   void Register(const MobMeta* info);
 public:
@@ -187,10 +206,20 @@ public:
   const unsigned Size();
   
   /**
-   * @brief Used to register all mob and preview data
+   * @brief Loads the textures and animations of a mob's enemies in the background
+   * @param index roster index of the highlighted mob
+   *
+   * Replaces the mob prefetched before so building it does not stall the battle
+   */
+  void Prefetch(int index);
+
+  /**
+   * @brief Used at startup, adds a job to the load graph for every mob and preview
+   * @param graph mobs load side by side
+   * @param field node that finishes once the battle field textures are packed. Every mob builds a field.
    * @param progress atomic thread safe counter for the successfully loaded assets
    */
-  void LoadAllMobs(std::atomic<int>& progress);
+  void LoadAllMobs(LoadGraph& graph, LoadGraph::Node field, std::atomic<int>& progress);
 
 };
 
@@ -213,7 +242,7 @@ inline MobRegistration::MobMeta & MobRegistration::MobMeta::SetMobClass()
     this->mobFactory = new T(new Field(6, 3));
 
     if (!this->placeholderTexture) {
-      this->placeholderTexture = TEXTURES.LoadTextureFromFile(this->GetPlaceholderTexturePath());
+      this->placeholderTexture = TEXTURES.LoadTexture(this->GetPlaceholderTexturePath());
     }
   };
 
@@ -3,7 +3,7 @@
 #include "bnTextureResourceManager.h"
 
 MysteryData::MysteryData(Field* _field, Team _team) : Character() {
-  this->setTexture(LOAD_TEXTURE(MISC_MYSTERY_DATA));
+  this->setTexture(TEXTURES.LoadTexture(TextureType::MISC_MYSTERY_DATA));
   this->setScale(2.f, 2.f);
   this->SetFloatShoe(true);
 
@@ -1,9 +1,13 @@
 #include "bnNaviRegistration.h"
 #include "bnPlayer.h"
 #include "bnLogger.h"
+#include "bnAssetLoader.h"
+#include "bnTextureResourceManager.h"
 #include <exception>
 #include <atomic>
 #include <thread>
+#include <chrono>
+#include <memory>
 
 NaviRegistration::NaviMeta::NaviMeta() : symbol(), overworldTexture(), battleTexture()
 {
@@ -93,6 +97,12 @@ NaviRegistration::NaviMeta& NaviRegistration::NaviMeta::SetBattleTexture(const s
   return *this;
 }
 
+NaviRegistration::NaviMeta& NaviRegistration::NaviMeta::SetTextures(const std::vector<TextureType>& textures)
+{
+  this->textures = textures;
+  return *this;
+}
+
 const sf::Texture & NaviRegistration::NaviMeta::GetOverworldTexture() const
 {
   return *overworldTexture;
@@ -188,15 +198,75 @@ const unsigned NaviRegistration::Size()
   return (unsigned)roster.size();
 }
 
-void NaviRegistration::LoadAllNavis(std::atomic<int>& progress)
+void NaviRegistration::Prefetch(int index)
+{
+  if (index < 0 || index >= (int)Size()) return;
+
+  NaviMeta& meta = *roster[index];
+  std::vector<std::string> animations;
+
+  if (!meta.battleAnimationPath.empty()) {
+    animations.push_back(meta.battleAnimationPath);
+  }
+
+  if (!meta.overworldAnimationPath.empty() && meta.overworldAnimationPath != meta.battleAnimationPath) {
+    animations.push_back(meta.overworldAnimationPath);
+  }
+
+  prefetch.Request(meta.textures, animations);
+}
+
+void NaviRegistration::LoadAllNavis(LoadGraph& graph, std::atomic<int>& progress)
 {
+  auto begin = std::chrono::steady_clock::now();
+  std::vector<LoadGraph::Node> navis;
+
+  // Filled by upload jobs on the main thread. Each slot is written once before its event completes.
+  auto loaded = std::make_shared<std::vector<TextureHandle>>(static_cast<std::size_t>(TEXTURE_TYPE_SIZE));
+  std::map<TextureType, LoadGraph::Node> uploads;
+
   for (int i = 0; i < (int)Size(); i++) {
-    roster[i]->loadNaviClass();
+    NaviMeta* meta = roster[i];
+    std::vector<LoadGraph::Node> textures;
+
+    // Navis that share a texture wait on the same upload
+    for (auto type : meta->textures) {
+      auto iter = uploads.find(type);
+
+      if (iter == uploads.end()) {
+        LoadGraph::Node uploaded = graph.AddEvent();
+
+        graph.Add([type, loaded, uploaded, &graph]() {
+          auto decoded = std::make_shared<std::vector<TextureResourceManager::DecodedTexture>>(TEXTURES.Decode({ type }));
 
-    Logger::GetMutex()->lock();
-    Logger::Logf("Loaded navi: %s", roster[i]->navi->GetName().c_str());
-    Logger::GetMutex()->unlock();
+          // Textures can only be created on the main thread
+          LOADER.Upload([type, loaded, decoded, uploaded, &graph]() {
+            (*loaded)[static_cast<int>(type)] = TEXTURES.Upload(*decoded).front();
+            graph.Complete(uploaded);
+          });
+        });
 
-    progress++;
+        iter = uploads.insert(std::make_pair(type, uploaded)).first;
+      }
+
+      textures.push_back(iter->second);
+    }
+
+    navis.push_back(graph.Add([meta, loaded, &progress]() {
+      // The navi class finds its textures cached while the meta holds them
+      for (auto type : meta->textures) {
+        meta->loadedTextures.push_back((*loaded)[static_cast<int>(type)]);
+      }
+
+      meta->loadNaviClass();
+
+      LOG_INFO(CONTENT, "Loaded navi: %s", meta->navi->GetName().c_str());
+
+      progress++;
+    }, textures));
   }
+
+  graph.Add([begin]() {
+    LOG_INFO(CONTENT, "Loaded registered navis: %f secs", std::chrono::duration<float>(std::chrono::steady_clock::now() - begin).count());
+  }, navis);
 }
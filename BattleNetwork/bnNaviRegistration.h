@@ -9,6 +9,9 @@
 #include <SFML/Graphics.hpp>
 #include "bnElements.h"
 #include "bnPlayer.h"
+#include "bnTextureType.h"
+#include "bnAssetPrefetch.h"
+#include "bnLoadGraph.h"
 
 class Player; // forward decl
 
@@ -36,6 +39,8 @@ public:
     double speed; /*!< The speed of the navi */
     int hp; /*!< The health of the navi */
     bool isSword; /*!< Is buster or sword based navi */
+    std::vector<TextureType> textures; /*!< Textures the navi class loads. Loaded ahead of the navi. */
+    std::vector<TextureHandle> loadedTextures; /*!< Keeps textures loaded for the navi class */
 
     std::function<void()> loadNaviClass; /*!< Deffered navi loading. Only load navi class when needed */
 
@@ -129,6 +134,13 @@ public:
      * @return NaviMeta& to chain
      */
     NaviMeta& SetBattleTexture(const sf::Texture* texture);
+
+    /**
+     * @brief Sets the textures the navi class uses
+     * @param textures loaded before the navi class at startup and prefetched on the select screen
+     * @return NaviMeta& to chain
+     */
+    NaviMeta& SetTextures(const std::vector<TextureType>& textures);
     
     /**
      * @brief Gets the overworld texture to draw
@@ -199,6 +211,7 @@ public:
 
 private:
   std::vector<NaviMeta*> roster; /*!< Complete roster of net navis to load */
+  AssetPrefetch prefetch; /*!< Assets of the highlighted navi */
  
   /**
    * @brief Registers a navi through a NaviMeta data object
@@ -246,10 +259,19 @@ public:
   const unsigned Size();
   
   /**
-   * @brief Used at startup, loads every navi queued by the roster
+   * @brief Loads the assets a navi uses in battle in the background
+   * @param index roster index of the highlighted navi
+   *
+   * Replaces the navi prefetched before
+   */
+  void Prefetch(int index);
+
+  /**
+   * @brief Used at startup, adds a job to the load graph for every navi queued by the roster
+   * @param graph each navi loads as soon as its textures are loaded
    * @param progress atomic thread safe counter when loading resources
    */
-  void LoadAllNavis(std::atomic<int>& progress);
+  void LoadAllNavis(LoadGraph& graph, std::atomic<int>& progress);
   
 };
 
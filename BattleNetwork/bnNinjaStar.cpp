@@ -10,8 +10,8 @@
 NinjaStar::NinjaStar(Field* _field, Team _team, float _duration) : duration(_duration), Spell(_field, _team) {
   SetLayer(0);;
   
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_NINJA_STAR);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_NINJA_STAR);
+  setTexture(texture);
   
   // Swoosh util sets the texture origin to 50% x and 80% y
   swoosh::game::setOrigin(*this, 0.5, 0.8);
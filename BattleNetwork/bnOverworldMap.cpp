@@ -14,6 +14,8 @@ namespace Overworld {
     // std::cout << "num of lights: " << lights.size() << "\n";
 
     cam = nullptr;
+
+    lightTexture = TEXTURES.LoadTexture(TextureType::LIGHT);
   }
 
   void Map::ToggleLighting(bool state) {
@@ -171,7 +173,7 @@ namespace Overworld {
 
     if (cam) {
       for (int i = 0; i < lights.size() && enableLighting; i++) {
-        sf::Sprite originTest(*TEXTURES.GetTexture(TextureType::LIGHT));
+        sf::Sprite originTest(*lightTexture);
 
         sf::Vector2f pos = lights[i]->GetPosition();
 
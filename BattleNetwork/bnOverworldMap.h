@@ -9,7 +9,7 @@
 namespace Overworld {
   /*! \brief Structure to hold tile data */
   class Tile {
-    sf::Texture* texture;
+    TextureHandle texture;
     sf::Vector2f pos;
 
     bool cleanup; /*!< flag to remove tile */
@@ -21,10 +21,10 @@ namespace Overworld {
       int randTex = rand() % 100;
 
       if (randTex > 80) {
-        texture = TEXTURES.GetTexture(TextureType::MAIN_MENU_OW2);
+        texture = TEXTURES.LoadTexture(TextureType::MAIN_MENU_OW2);
       }
       else {
-        texture = TEXTURES.GetTexture(TextureType::MAIN_MENU_OW);
+        texture = TEXTURES.LoadTexture(TextureType::MAIN_MENU_OW);
       }
     }
 
@@ -32,7 +32,7 @@ namespace Overworld {
     Tile() { pos = sf::Vector2f(0, 0); LoadTexture(); cleanup = false;  }
     Tile(const Tile& rhs) { texture = rhs.texture; pos = rhs.pos;  cleanup = false; }
 
-    Tile(sf::Texture* _texture, sf::Vector2f pos = sf::Vector2f()) : pos(pos) { texture = _texture; cleanup = false; }
+    Tile(const TextureHandle& _texture, sf::Vector2f pos = sf::Vector2f()) : pos(pos) { texture = _texture; cleanup = false; }
     Tile(sf::Vector2f pos) : pos(pos) { LoadTexture(); cleanup = false;}
     ~Tile() { ; }
     const sf::Vector2f GetPos() const { return pos; }
@@ -75,6 +75,7 @@ namespace Overworld {
     int cols, rows; /*!< map is made out of Cols x Rows tiles */
     int tileWidth, tileHeight; /*!< tile dimensions */
     Camera* cam; /*!< camera */
+    TextureHandle lightTexture; /*!< texture drawn for each light source */
 
     /**
      * @brief Transforms an ortho vector into an isometric vector
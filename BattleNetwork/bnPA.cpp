@@ -1,13 +1,18 @@
 #include "bnPA.h"
 #include "bnLogger.h"
 #include "bnFileUtil.h"
+#include "bnKeyValueReader.h"
 #include <assert.h>
 #include <iostream>
+#include <queue>
+#include <SFML/System.hpp>
 #include "bnChipLibrary.h"
 
 PA::PA()
 {
   advanceChipRef = nullptr;
+  matched = -1;
+  nodes.push_back(Node({ {}, 0, -1 }));
 }
 
 
@@ -24,89 +29,171 @@ PA::~PA()
 
 void PA::LoadPA()
 {
+  sf::Clock clock;
+
   advances.clear();
+  matched = -1;
 
-  string data = FileUtil::Read("resources/database/PA.txt");
+  const std::string path = "resources/database/PA.txt";
+  string data = FileUtil::Read(path);
+  KeyValueReader reader(data, path);
 
-  int endline = 0;
   std::vector<PA::PAData::Required> currSteps;
   std::string currPA;
-  std::string damage;
-  std::string icon;
+  int damage = 0;
+  int icon = 0;
   std::string type;
 
-  do {
-    endline = (int)data.find("\n");
-    string line = data.substr(0, endline);
-
-    while (line.compare(0, 1, " ") == 0)
-      line.erase(line.begin()); // remove leading whitespaces
-    while (line.size() > 0 && line.compare(line.size() - 1, 1, " ") == 0)
-      line.erase(line.end() - 1); // remove trailing whitespaces
+  auto addPA = [this, &currSteps, &currPA, &damage, &icon, &type]() {
+    if (currSteps.size() > 1) {
+      Element elemType = ChipLibrary::GetElementFromStr(type);
 
-    if (line[0] == '#') {
-      // Skip comments
-      data = data.substr(endline + 1);
-      continue;
+      advances.push_back(PA::PAData({ currPA, (unsigned)icon, (unsigned)damage, elemType, currSteps }));
+    }
+    else {
+      LOG_WARN(CHIPS, "PA \"%s\": only has 1 required chip for recipe. PA's must have 2 or more chips. Skipping entry.", currPA.c_str());
     }
 
-    if (line.find("PA") != string::npos) {
+    currSteps.clear();
+  };
+
+  while (reader.Next()) {
+    std::string_view tag = reader.GetTag();
+
+    if (tag == "PA") {
       if (!currSteps.empty()) {
-        if (currSteps.size() > 1) {
-          Element elemType = ChipLibrary::GetElementFromStr(type);
-
-          advances.push_back(PA::PAData({ currPA, (unsigned)atoi(icon.c_str()), (unsigned)atoi(damage.c_str()), elemType, currSteps }));
-          currSteps.clear();
-        }
-        else {
-          Logger::Log("Error. PA \"" + currPA + "\": only has 1 required chip for recipe. PA's must have 2 or more chips. Skipping entry.");
-          currSteps.clear();
-        }
+        addPA();
       }
-      
-      currPA = valueOf("name", line);
-      damage = valueOf("damage", line);
-      icon = valueOf("iconIndex", line);
-      type = valueOf("type", line);
-    } else if (line.find("Chip") != string::npos) {
-      string name = valueOf("name", line);
-      string code = valueOf("code", line);
-
-      currSteps.push_back(PA::PAData::Required({ name,code[0] }));
-
-      //std::cout << "chip step: " << name << " " << code[0] << endl;
+
+      currPA = KeyValueReader::ToString(reader.Require("name"));
+      damage = KeyValueReader::ToInt(reader.Require("damage"));
+      icon = KeyValueReader::ToInt(reader.Require("iconIndex"));
+      type = KeyValueReader::ToString(reader.Require("type"));
+    } else if (tag == "Chip") {
+      string name = KeyValueReader::ToString(reader.Require("name"));
+      std::string_view code = reader.Require("code");
+
+      if (code.empty()) continue;
+
+      currSteps.push_back(PA::PAData::Required({ name, code[0] }));
     }
+  }
 
-    data = data.substr(endline + 1);
-  } while (endline > -1);
+  addPA();
 
-  if (currSteps.size() > 1) {
-    Element elemType = ChipLibrary::GetElementFromStr(type);
+  Compile();
 
-    //std::cout << "PA entry 2: " << currPA << " " << (unsigned)atoi(icon.c_str()) << " " << (unsigned)atoi(damage.c_str()) << " " << type << endl;
-    advances.push_back(PA::PAData({ currPA, (unsigned)atoi(icon.c_str()), (unsigned)atoi(damage.c_str()), elemType, currSteps }));
-    currSteps.clear();
+  LOG_INFO(CHIPS, "Loaded %i PAs (%i states) in %f secs", (int)advances.size(), (int)nodes.size(), clock.getElapsedTime().asSeconds());
+}
+
+const int PA::Symbol(const std::string& name, char code, bool add)
+{
+  std::string key = name;
+  key += ':';
+  key += code;
+
+  auto found = symbols.find(key);
+
+  if (found != symbols.end()) {
+    return found->second;
   }
-  else {
-    //std::cout << "Error. PA " + currPA + " only has 1 required chip for recipe. PA's must have 2 or more chips. Skipping entry.\n";
-    Logger::Log("Error. PA \"" + currPA + "\": only has 1 required chip for recipe. PA's must have 2 or more chips. Skipping entry.");
-    currSteps.clear();
+
+  if (!add) return -1;
+
+  int symbol = (int)symbols.size();
+  symbols.insert(std::make_pair(key, symbol));
+  return symbol;
+}
+
+const bool PA::IsBetter(int a, int b) const
+{
+  if (a < 0) return false;
+  if (b < 0) return true;
+
+  if (advances[a].steps.size() != advances[b].steps.size()) {
+    return advances[a].steps.size() > advances[b].steps.size();
   }
+
+  return a < b;
 }
 
-std::string PA::valueOf(std::string _key, std::string _line){
-  int keyIndex = (int)_line.find(_key);
-  assert(keyIndex > -1 && "Key was not found in PA file.");
-  string s = _line.substr(keyIndex + _key.size() + 2);
-  return s.substr(0, s.find("\""));
+void PA::Compile()
+{
+  symbols.clear();
+  nodes.clear();
+  nodes.push_back(Node({ {}, 0, -1 }));
+
+  // Build the trie of recipes
+  for (int i = 0; i < (int)advances.size(); i++) {
+    unsigned state = 0;
+
+    for (auto& step : advances[i].steps) {
+      unsigned symbol = (unsigned)Symbol(step.chipShortName, step.code, true);
+      auto next = nodes[state].next.find(symbol);
+
+      if (next == nodes[state].next.end()) {
+        nodes.push_back(Node({ {}, 0, -1 }));
+        nodes[state].next[symbol] = (unsigned)nodes.size() - 1;
+        state = (unsigned)nodes.size() - 1;
+      }
+      else {
+        state = next->second;
+      }
+    }
+
+    if (IsBetter(i, nodes[state].match)) {
+      nodes[state].match = i;
+    }
+  }
+
+  // Link every node to its longest suffix in the trie, breadth first
+  // so that shorter suffixes are always linked before they are needed
+  std::queue<unsigned> open;
+
+  for (auto& child : nodes[0].next) {
+    open.push(child.second);
+  }
+
+  while (!open.empty()) {
+    unsigned parent = open.front();
+    open.pop();
+
+    for (auto& child : nodes[parent].next) {
+      unsigned fail = nodes[parent].fail;
+
+      while (fail != 0 && nodes[fail].next.find(child.first) == nodes[fail].next.end()) {
+        fail = nodes[fail].fail;
+      }
+
+      auto next = nodes[fail].next.find(child.first);
+
+      if (next != nodes[fail].next.end()) {
+        fail = next->second;
+      }
+
+      Node& node = nodes[child.second];
+      node.fail = fail;
+
+      // A PA that ends in a suffix also ends here
+      if (IsBetter(nodes[fail].match, node.match)) {
+        node.match = nodes[fail].match;
+      }
+
+      open.push(child.second);
+    }
+  }
 }
 
 const PASteps PA::GetMatchingSteps()
 {
   PASteps result;
 
-  for (int i = 0; i < iter->steps.size(); i++) {
-    result.push_back(std::make_pair(iter->steps[i].chipShortName, iter->steps[i].code));
+  if (matched < 0) return result;
+
+  auto& steps = advances[matched].steps;
+
+  for (int i = 0; i < steps.size(); i++) {
+    result.push_back(std::make_pair(steps[i].chipShortName, steps[i].code));
   }
 
   return result;
@@ -121,62 +208,48 @@ const int PA::FindPA(Chip ** input, unsigned size)
 {
   int startIndex = -1;
 
+  matched = -1;
+
   if (size == 0) {
     return startIndex;
   }
 
-  for (iter = advances.begin(); iter != advances.end(); iter++) {
-    bool match = false;
-    
-    if (iter->steps.size() > size) {
-      continue; // try next 
-    }
+  unsigned state = 0;
 
+  for (unsigned index = 0; index < size; index++) {
+    int symbol = Symbol(input[index]->GetShortName(), input[index]->GetCode(), false);
 
-    int index = 0;
-    while (index <= (int)size - (int)iter->steps.size()) {
-      char code = input[index]->GetCode();
-
-      //std::cout << "iter->steps[0].code == " << iter->steps[0].code << " | iter->steps[0].chipShortName == " << iter->steps[0].chipShortName << std::endl;
-      //std::cout << "code == " << code << " | input[index]->GetShortName() == " << input[index]->GetShortName() << std::endl;
-
-      if (iter->steps[0].code == code && iter->steps[0].chipShortName == input[index]->GetShortName()) {
-        for (unsigned i = 0; i < iter->steps.size(); i++) {
-          char code = input[i + index]->GetCode();
-
-          if (iter->steps[i].code == code && iter->steps[i].chipShortName == input[i + index]->GetShortName()) {
-            match = true;
-            // We do not break here. If it is a match all across the steps, then the for loop ends 
-            // and match stays == true
-
-            if (startIndex == -1) {
-              startIndex = i + index;
-            }
-          }
-          else {
-            match = false;
-            startIndex = -1;
-            break;
-          }
-        }
-      }
+    if (symbol < 0) {
+      // No PA uses this chip. Nothing can match across it.
+      state = 0;
+      continue;
+    }
+
+    auto next = nodes[state].next.find((unsigned)symbol);
 
-      index++;
+    while (state != 0 && next == nodes[state].next.end()) {
+      state = nodes[state].fail;
+      next = nodes[state].next.find((unsigned)symbol);
     }
 
-    if (match) {
-      // Load the PA chip
-      if (advanceChipRef) { delete advanceChipRef; }
+    state = (next == nodes[state].next.end()) ? 0 : next->second;
 
-       advanceChipRef = new Chip(0, iter->icon, 0, iter->damage, iter->type, iter->name, "Program Advance", "", 0);
+    int found = nodes[state].match;
 
-      return startIndex;
+    // Only replace an earlier match with a strictly better one
+    if (IsBetter(found, matched)) {
+      matched = found;
+      startIndex = (int)index - (int)advances[found].steps.size() + 1;
     }
+  }
+
+  if (matched > -1) {
+    // Load the PA chip
+    if (advanceChipRef) { delete advanceChipRef; }
 
-    // else keep looking
-    startIndex = -1;
+    PAData& pa = advances[matched];
+    advanceChipRef = new Chip(0, pa.icon, 0, pa.damage, pa.type, pa.name, "Program Advance", "", 0);
   }
 
   return startIndex;
 }
-
@@ -10,12 +10,19 @@
  * This takes place during the transition from chip custom select screen
  * and battle. The names of each chip in the PA is listed one at a time,
  * then the PA name is displayed and the battle continues.
+ *
+ * Every (name, code) pair used by a recipe is interned as a symbol and the
+ * recipes are compiled into an Aho-Corasick automaton when they are loaded.
+ * FindPA() walks the selected chips once no matter how many PAs exist.
+ * The longest recipe wins. Recipes of the same length are picked in the
+ * order they appear in the file.
  */
    
 #pragma once
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include "bnChip.h"
 
 typedef std::pair<std::string, char> PAStep; /*!< Name of chip and code */
@@ -41,12 +48,44 @@ class PA
     std::vector<Required> steps; /*!< list of steps for PA */
   };
 
+  /*! \class Node
+   *  \desc One state of the matching automaton */
+  struct Node {
+    std::unordered_map<unsigned, unsigned> next; /*!< symbol to child node */
+    unsigned fail;   /*!< longest proper suffix that is also a prefix of some PA */
+    int match;       /*!< best PA that ends here or in a suffix. -1 if none */
+  };
+
   std::vector<PAData> advances; /*!< list of all PAs */
-  std::vector<PAData>::iterator iter; /*!< iterator */
+  std::unordered_map<std::string, unsigned> symbols; /*!< "name:code" to symbol */
+  std::vector<Node> nodes; /*!< automaton. nodes[0] is the root */
+  int matched; /*!< index of the last PA found or -1 */
   Chip* advanceChipRef; /*!< Allocated PA needs to be deleted */
+
+  /**
+   * @brief Look up the symbol for a chip
+   * @param name chip short name
+   * @param code chip code
+   * @param add if true, unknown pairs are given a new symbol
+   * @return symbol or -1 if the pair is not used by any PA
+   */
+  const int Symbol(const std::string& name, char code, bool add);
+
+  /**
+   * @brief Query if one PA should be picked over another
+   * @param a index into advances
+   * @param b index into advances or -1
+   * @return true if a has more steps, or as many steps and comes first in the file
+   */
+  const bool IsBetter(int a, int b) const;
+
+  /**
+   * @brief Build the automaton from advances
+   */
+  void Compile();
 public:
   /**
-   * @brief sets advanceChipRef to null
+   * @brief sets advanceChipRef to null and creates an empty automaton
    */
   PA();
   
@@ -57,28 +96,24 @@ public:
   
   /**
    * @brief Interpets and loads data from PA file at resources/database/PA.txt
+   * and compiles the recipes for matching
    */
   void LoadPA();
   
-  /**
-   * @brief Extracts the value for a key given a line
-   * @param _key to look for
-   * @param _line input string
-   * @return value of key
-   */
-  std::string valueOf(std::string _key, std::string _line);
-  
   /**
    * @brief Given a list of chips, generates a matching PA. 
    * @param input list of chips
    * @param size size of chip list
    * @return -1 if no match. Otherwise returns the start position of the PA
+   *
+   * If several PAs are in the list the longest is used. Ties go to the PA
+   * listed first in the file, then to the one that starts first.
    */
   const int FindPA(Chip** input, unsigned size);
   
   /**
    * @brief Returns the list of matching steps in the PA
-   * @return const PASteps
+   * @return const PASteps. Empty if the last FindPA() had no match
    */
   const PASteps GetMatchingSteps();
   
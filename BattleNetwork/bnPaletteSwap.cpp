@@ -3,11 +3,11 @@
 #include "bnShaderResourceManager.h"
 #include "bnEntity.h"
 
-PaletteSwap::PaletteSwap(Entity * owner, sf::Texture base_palette) : Component(owner), base(base_palette), enabled(true)
+PaletteSwap::PaletteSwap(Entity * owner, const TextureHandle& base_palette) : Component(owner), palette(base_palette), base(base_palette), enabled(true)
 {
   paletteSwap = ShaderResourceManager::GetInstance().GetShader(ShaderType::PALETTE_SWAP);
-  paletteSwap->setUniform("palette", base);
-  paletteSwap->setUniform("texture", sf::Shader::CurrentTexture);
+  SHADERS.SetUniform(paletteSwap, "palette", base);
+  SHADERS.SetUniform(paletteSwap, "texture", sf::Shader::CurrentTexture);
 }
 
 PaletteSwap::~PaletteSwap()
@@ -27,17 +27,13 @@ void PaletteSwap::Inject(BattleScene &)
 
 void PaletteSwap::LoadPaletteTexture(std::string path)
 {
-  auto texture = TextureResourceManager::GetInstance().LoadTextureFromFile(path);
-  palette = *texture;
-  delete texture;
-  paletteSwap->setUniform("palette", palette);
-
+  SetTexture(TEXTURES.LoadTexture(path));
 }
 
-void PaletteSwap::SetTexture(sf::Texture & texture)
+void PaletteSwap::SetTexture(const TextureHandle& texture)
 {
   palette = texture;
-  paletteSwap->setUniform("palette", palette);
+  SHADERS.SetUniform(paletteSwap, "palette", palette);
 }
 
 void PaletteSwap::Revert()
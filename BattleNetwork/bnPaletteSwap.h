@@ -1,22 +1,23 @@
 #pragma once
 #include "bnComponent.h"
+#include "bnTextureResourceManager.h"
 #include <SFML/Graphics.hpp>
 class BattleScene;
 class Entity;
 
 class PaletteSwap : public Component {
 private:
-  sf::Texture palette;
-  sf::Texture base;
+  TextureHandle palette;
+  TextureHandle base;
   sf::Shader* paletteSwap;
   bool enabled; /*!< Turn this effect on/off */
 public:
-  PaletteSwap(Entity* owner, sf::Texture base);
+  PaletteSwap(Entity* owner, const TextureHandle& base);
   ~PaletteSwap();
   void OnUpdate(float _elapsed);
   void Inject(BattleScene&);
   void LoadPaletteTexture(std::string);
-  void SetTexture(sf::Texture& texture);
+  void SetTexture(const TextureHandle& texture);
   void Revert();
   void Enable(bool enabled = true);
 };
@@ -8,8 +8,8 @@
 PanelGrab::PanelGrab(Field* _field, Team _team, float _duration) : duration(_duration), Spell(_field, _team) {
   SetLayer(0);
   
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_AREAGRAB);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_AREAGRAB);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   progress = 0.0f;
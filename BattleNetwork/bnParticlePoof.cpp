@@ -11,7 +11,7 @@ using sf::IntRect;
 ParticlePoof::ParticlePoof() : Artifact(nullptr)
 {
   SetLayer(0);
-  this->setTexture(*TEXTURES.GetTexture(TextureType::SPELL_POOF));
+  this->setTexture(TEXTURES.LoadTexture(TextureType::SPELL_POOF));
   this->setScale(2.f, 2.f);
   poof = (sf::Sprite)*this;
 
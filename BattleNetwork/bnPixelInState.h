@@ -105,11 +105,7 @@ void PixelInState<Any>::OnUpdate(float _elapsed, Any& e) {
 
   sf::IntRect t = e.getTextureRect();
   sf::Vector2u size = e.getTexture()->getSize();
-  pixelated.SetUniform("x", (float)t.left / (float)size.x);
-  pixelated.SetUniform("y", (float)t.top / (float)size.y);
-  pixelated.SetUniform("w", (float)t.width / (float)size.x);
-  pixelated.SetUniform("h", (float)t.height / (float)size.y);
-  pixelated.SetUniform("pixel_threshold", (float)(factor/400.f));
+  PixelateUniforms::Set(pixelated, t, size, (float)(factor/400.f));
 }
 
 template<typename Any>
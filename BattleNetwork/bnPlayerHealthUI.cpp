@@ -11,13 +11,13 @@ PlayerHealthUI::PlayerHealthUI(Player* _player)
     BattleOverTrigger<Player>(_player, [this](BattleScene& scene, Player& player) { this->isBattleOver = true; }) 
 {
   
-  // TODO: move this to the preloaded textures      
-  texture = TEXTURES.LoadTextureFromFile("resources/ui/img_health.png");
+  texture = TEXTURES.LoadTexture("resources/ui/img_health.png");
   sprite.setTexture(*texture);
   sprite.setPosition(3.f, 0.0f);
   sprite.setScale(2.f, 2.f);
 
-  glyphs.setTexture(LOAD_TEXTURE(PLAYER_HP_NUMSET));
+  glyphsTexture = TEXTURES.LoadTexture(TextureType::PLAYER_HP_NUMSET);
+  glyphs.setTexture(*glyphsTexture);
   glyphs.setScale(2.f, 2.f);
 
   lastHP = currHP = startHP = _player->GetHealth();
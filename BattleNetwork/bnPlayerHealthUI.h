@@ -19,6 +19,7 @@
 #include "bnBattleOverTrigger.h"
 #include "bnPlayer.h"
 #include "bnUIComponent.h"
+#include "bnTextureResourceManager.h"
 
 class Entity;
 class Player;
@@ -68,8 +69,9 @@ private:
   int startHP; /*!< HP of target when this component was attached */
   Player* player; /*!< target entity of type Player */
   mutable Sprite glyphs; /*!< bitmap image object to draw */
+  TextureHandle glyphsTexture; /*!< the texture of the glyphs */
   Sprite sprite; /*!< the box surrounding the health */
-  Texture* texture; /*!< the texture of the box */
+  TextureHandle texture; /*!< the texture of the box */
 
   /**
    * @class Color
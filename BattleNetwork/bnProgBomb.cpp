@@ -13,8 +13,8 @@ ProgBomb::ProgBomb(Field* _field, Team _team, sf::Vector2f startPos, float _dura
   cooldown = 0;
   damageCooldown = 0;
   
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_PROG_BOMB);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_PROG_BOMB);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   SetLayer(-1);
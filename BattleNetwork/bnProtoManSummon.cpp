@@ -28,7 +28,8 @@ ProtoManSummon::ProtoManSummon(ChipSummonHandler* _summons) : Spell(_summons->Ge
 
   AUDIO.Play(AudioType::APPEAR);
 
-  setTexture(*TEXTURES.LoadTextureFromFile("resources/spells/protoman_summon.png"), true);
+  texture = TEXTURES.LoadTexture("resources/spells/protoman_summon.png");
+  setTexture(*texture, true);
 
   animationComponent = new AnimationComponent(this);
   this->RegisterComponent(animationComponent);
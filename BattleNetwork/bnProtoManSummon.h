@@ -7,6 +7,7 @@
 #pragma once
 #include "bnSpell.h"
 #include "bnAnimationComponent.h"
+#include "bnTextureResourceManager.h"
 
 class ChipSummonHandler;
 
@@ -60,4 +61,5 @@ private:
   int random;
   ChipSummonHandler* summons;
   AnimationComponent* animationComponent;
+  TextureHandle texture;
 };
@@ -29,6 +29,8 @@ void QueueMobRegistration() {
   auto info = MOBS.AddClass<TwoMettaurMob>();  // Create and register mob info object
   info->SetDescription("Tutorial ranked mettaurs, you got this!"); // Set property
   info->SetPlaceholderTexturePath("resources/mobs/mettaur/preview.png");
+  info->SetTextures({ TextureType::MOB_METTAUR });
+  info->SetAnimationPaths({ "resources/mobs/mettaur/mettaur.animation" });
   info->SetName("Mettaurs");
   info->SetSpeed(1);
   info->SetAttack(10);
@@ -38,6 +40,8 @@ void QueueMobRegistration() {
   info->SetDescription("Starfish can trap you in bubbles"); // Set property
   info->SetName("Bubble Battle");
   info->SetPlaceholderTexturePath("resources/mobs/starfish/preview.png");
+  info->SetTextures({ TextureType::MOB_STARFISH_ATLAS });
+  info->SetAnimationPaths({ "resources/mobs/starfish/starfish.animation" });
   info->SetSpeed(0);
   info->SetAttack(20);
   info->SetHP(100);
@@ -46,6 +50,8 @@ void QueueMobRegistration() {
   info->SetDescription("Family of cannon virii - Watch out!"); // Set property
   info->SetName("Triple Trouble");
   info->SetPlaceholderTexturePath("resources/mobs/canodumb/preview.png");
+  info->SetTextures({ TextureType::MOB_CANODUMB_ATLAS });
+  info->SetAnimationPaths({ "resources/mobs/canodumb/canodumb.animation" });
   info->SetSpeed(0);
   info->SetAttack(20);
   info->SetHP(130);
@@ -54,6 +60,8 @@ void QueueMobRegistration() {
   info->SetDescription("Honey Bombers attack with bees. Do not get in their way!"); // Set property
   info->SetName("Sting Squad");
   info->SetPlaceholderTexturePath("resources/mobs/honeybomber/preview.png");
+  info->SetTextures({ TextureType::MOB_HONEYBOMBER_ATLAS });
+  info->SetAnimationPaths({ "resources/mobs/honeybomber/honeybomber.animation" });
   info->SetSpeed(100);
   info->SetAttack(25);
   info->SetHP(130);
@@ -62,6 +70,8 @@ void QueueMobRegistration() {
   info->SetDescription("Fire-type wizard virii summon meteors."); // Set property
   info->SetName("Fire Frenzy");
   info->SetPlaceholderTexturePath("resources/mobs/metrid/preview.png");
+  info->SetTextures({ TextureType::MOB_METRID, TextureType::MOB_CANODUMB_ATLAS });
+  info->SetAnimationPaths({ "resources/mobs/metrid/metrid.animation", "resources/mobs/canodumb/canodumb.animation" });
   info->SetSpeed(100);
   info->SetAttack(120);
   info->SetHP(250);
@@ -70,6 +80,8 @@ void QueueMobRegistration() {
   info->SetDescription("A rogue Mr.Prog! Can you stop it?"); // Set property
   info->SetName("Enter ProgsMan");
   info->SetPlaceholderTexturePath("resources/mobs/progsman/preview.png");
+  info->SetTextures({ TextureType::MOB_PROGSMAN_ATLAS });
+  info->SetAnimationPaths({ "resources/mobs/progsman/progsman.animation" });
   info->SetSpeed(5);
   info->SetAttack(20);
   info->SetHP(600);
@@ -78,6 +90,8 @@ void QueueMobRegistration() {
   info->SetDescription("MetalMan throws blades, shoots missiles, and can shatter the ground."); // Set property
   info->SetName("BN4 MetalMan");
   info->SetPlaceholderTexturePath("resources/mobs/metalman/preview.png");
+  info->SetTextures({ TextureType::MOB_METALMAN_ATLAS });
+  info->SetAnimationPaths({ "resources/mobs/metalman/metalman.animation" });
   info->SetSpeed(6);
   info->SetAttack(20);
   info->SetHP(1000);
@@ -94,6 +108,8 @@ void QueueMobRegistration() {
   info->SetDescription("MetalMan - On ice!"); // Set property
   info->SetName("Vengence Served Cold");
   info->SetPlaceholderTexturePath("resources/mobs/metalman/preview2.png");
+  info->SetTextures({ TextureType::MOB_METALMAN_ATLAS });
+  info->SetAnimationPaths({ "resources/mobs/metalman/metalman.animation" });
   info->SetSpeed(6);
   info->SetAttack(20);
   info->SetHP(1000);
@@ -101,6 +117,8 @@ void QueueMobRegistration() {
   info = MOBS.AddClass<AlphaBossFight>();  // Create and register mob info object
   info->SetDescription("Alpha is absorbing the net again!"); // Set property
   info->SetPlaceholderTexturePath("resources/mobs/alpha/preview.png");
+  info->SetTextures({ TextureType::MOB_ALPHA_ATLAS });
+  info->SetAnimationPaths({ "resources/mobs/alpha/alpha.animation" });
   info->SetName("Alpha");
   info->SetSpeed(0);
   info->SetAttack(80);
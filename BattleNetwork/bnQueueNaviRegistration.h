@@ -21,6 +21,7 @@ void QueuNaviRegistration() {
   megamanInfo->SetSpecialDescription("Star of the series. Well rounded stats."); // Set property
   megamanInfo->SetBattleAnimationPath("resources/navis/megaman/megaman.animation");
   megamanInfo->SetOverworldAnimationPath("resources/navis/megaman/megaman.animation");
+  megamanInfo->SetTextures({ TextureType::NAVI_MEGAMAN_ATLAS, TextureType::SPELL_BULLET_HIT, TextureType::SPELL_CHARGED_BULLET_HIT });
   megamanInfo->SetSpeed(1);
   megamanInfo->SetAttack(1);
   megamanInfo->SetChargedAttack(10);
@@ -30,6 +31,7 @@ void QueuNaviRegistration() {
   rollInfo->SetSpecialDescription("High HP and quick to recover from hits. FloatShoe enabled.");
   rollInfo->SetBattleAnimationPath("resources/navis/roll/roll.animation");
   rollInfo->SetOverworldAnimationPath("resources/navis/roll/roll.animation");
+  rollInfo->SetTextures({ TextureType::NAVI_ROLL_ATLAS, TextureType::SPELL_BULLET_HIT, TextureType::SPELL_CHARGED_BULLET_HIT });
   rollInfo->SetSpeed(2);
   rollInfo->SetAttack(1);
   rollInfo->SetChargedAttack(10);
@@ -39,6 +41,7 @@ void QueuNaviRegistration() {
   starmanInfo->SetSpecialDescription("Fastest navi w/ rapid fire");
   starmanInfo->SetBattleAnimationPath("resources/navis/starman/starman.animation");
   starmanInfo->SetOverworldAnimationPath("resources/navis/starman/starman.animation");
+  starmanInfo->SetTextures({ TextureType::NAVI_STARMAN_ATLAS, TextureType::SPELL_BULLET_HIT, TextureType::SPELL_CHARGED_BULLET_HIT });
   starmanInfo->SetSpeed(3);
   starmanInfo->SetAttack(1);
   starmanInfo->SetChargedAttack(10);
@@ -48,6 +51,7 @@ void QueuNaviRegistration() {
   forteInfo->SetSpecialDescription("Literally too angry to die. Spawns with aura.");
   forteInfo->SetBattleAnimationPath("resources/navis/forte/forte.animation");
   forteInfo->SetOverworldAnimationPath("resources/navis/forte/forte.animation");
+  forteInfo->SetTextures({ TextureType::NAVI_FORTE_ATLAS, TextureType::SPELL_AURA, TextureType::SPELL_BULLET_HIT, TextureType::SPELL_CHARGED_BULLET_HIT });
   forteInfo->SetSpeed(2);
   forteInfo->SetAttack(3);
   forteInfo->SetChargedAttack(20);
@@ -0,0 +1,139 @@
+#include "bnRenderQueue.h"
+#include "bnSpriteSceneNode.h"
+#include "bnSpriteBatch.h"
+
+#include <algorithm>
+
+namespace {
+  const int ROW_BITS = 8;
+  const int LAYER_BITS = 16;
+  const int SHADER_BITS = 8;
+  const int TEXTURE_BITS = 12;
+  const int INDEX_BITS = 20;
+
+  const std::uint32_t MAX_ROW = (1u << ROW_BITS) - 1u;
+  const std::uint32_t MAX_SHADER = (1u << SHADER_BITS) - 1u;
+  const std::uint32_t MAX_TEXTURE = (1u << TEXTURE_BITS) - 1u;
+  const std::uint32_t MAX_INDEX = (1u << INDEX_BITS) - 1u;
+}
+
+RenderQueue::RenderQueue() : isSorted(true) {
+}
+
+RenderQueue::~RenderQueue() {
+}
+
+std::uint32_t RenderQueue::IDOf(std::unordered_map<const void*, std::uint32_t>& ids, const void* ptr, std::uint32_t max) {
+  // nullptr is always 0 so untextured/unshaded nodes sort first
+  if (!ptr) return 0;
+
+  auto iter = ids.find(ptr);
+
+  if (iter != ids.end()) return iter->second;
+
+  std::uint32_t id = std::min(static_cast<std::uint32_t>(ids.size() + 1), max);
+  ids.insert(std::make_pair(ptr, id));
+
+  return id;
+}
+
+const std::uint64_t RenderQueue::MakeKey(int row, int layer, std::uint32_t shader, std::uint32_t texture, std::uint32_t index) {
+  std::uint64_t r = static_cast<std::uint64_t>(std::max(0, std::min(row, static_cast<int>(MAX_ROW))));
+
+  // Bias the layer into an unsigned 16-bit range then invert it: higher layers are drawn first
+  int clamped = std::max(-32768, std::min(layer, 32767));
+  std::uint64_t l = static_cast<std::uint64_t>(65535 - (clamped + 32768));
+
+  std::uint64_t key = r;
+  key = (key << LAYER_BITS) | l;
+  key = (key << SHADER_BITS) | std::min(shader, MAX_SHADER);
+  key = (key << TEXTURE_BITS) | std::min(texture, MAX_TEXTURE);
+  key = (key << INDEX_BITS) | std::min(index, MAX_INDEX);
+
+  return key;
+}
+
+void RenderQueue::Clear() {
+  items.clear();
+  entries.clear();
+  shaderIDs.clear();
+  textureIDs.clear();
+  isSorted = true;
+}
+
+void RenderQueue::Submit(int row, SpriteSceneNode& node, sf::RenderStates states) {
+  if (node.IsHidden()) return;
+
+  std::uint32_t index = static_cast<std::uint32_t>(items.size());
+
+  // Key on what the node will actually be drawn with
+  const sf::Shader* shader = node.GetShader().Get();
+
+  if (!shader && node.IsUsingParentShader()) {
+    shader = states.shader;
+  }
+
+  std::uint32_t shaderID = IDOf(shaderIDs, shader, MAX_SHADER);
+  std::uint32_t textureID = IDOf(textureIDs, node.getTexture(), MAX_TEXTURE);
+
+  items.push_back(Item{ &node, states });
+  entries.push_back(Entry{ MakeKey(row, node.GetLayer(), shaderID, textureID, index), index });
+
+  isSorted = false;
+}
+
+void RenderQueue::Sort() {
+  if (isSorted) return;
+
+  const std::size_t size = entries.size();
+  scratch.resize(size);
+
+  Entry* src = entries.data();
+  Entry* dst = scratch.data();
+
+  std::size_t counts[256];
+
+  for (int shift = 0; shift < 64; shift += 8) {
+    std::fill(counts, counts + 256, 0);
+
+    for (std::size_t i = 0; i < size; i++) {
+      counts[(src[i].key >> shift) & 0xFF]++;
+    }
+
+    // Every key has the same byte here. This pass would not move anything.
+    if (size > 0 && counts[(src[0].key >> shift) & 0xFF] == size) continue;
+
+    std::size_t offset = 0;
+    for (int b = 0; b < 256; b++) {
+      std::size_t count = counts[b];
+      counts[b] = offset;
+      offset += count;
+    }
+
+    for (std::size_t i = 0; i < size; i++) {
+      dst[counts[(src[i].key >> shift) & 0xFF]++] = src[i];
+    }
+
+    std::swap(src, dst);
+  }
+
+  // An odd number of passes leaves the result in the scratch buffer
+  if (src != entries.data()) {
+    entries.swap(scratch);
+  }
+
+  isSorted = true;
+}
+
+void RenderQueue::Flush(SpriteBatch& batch) {
+  Sort();
+
+  for (auto& entry : entries) {
+    Item& item = items[entry.index];
+    batch.Submit(*item.node, item.states);
+  }
+}
+
+const std::size_t RenderQueue::Size() const {
+  return items.size();
+}
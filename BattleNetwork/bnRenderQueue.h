@@ -0,0 +1,104 @@
+/*! \brief Orders an entire frame of sprite nodes with one linear radix sort
+ *
+ * Every node submitted to the queue is given a 64-bit draw key:
+ *
+ * | row (8) | layer (16) | shader (8) | texture (12) | submission index (20) |
+ *
+ * Sorting by this key draws rows from back to front, higher layers behind lower layers,
+ * and groups nodes with the same shader and texture next to each other so that the
+ * SpriteBatch can merge them into one draw call. The submission index makes every key
+ * unique which keeps the order stable when everything else ties.
+ *
+ * Keys are sorted with an LSD radix sort, 8 bits at a time. Passes where every key
+ * shares the same byte are skipped so a typical frame only needs a few passes.
+ */
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+class SpriteSceneNode;
+class SpriteBatch;
+
+class RenderQueue {
+private:
+  /**
+   * @struct Item
+   * @brief A node waiting to be drawn
+   */
+  struct Item {
+    const SpriteSceneNode* node; /*!< Node to draw */
+    sf::RenderStates states; /*!< Parent states captured at submission */
+  };
+
+  /**
+   * @struct Entry
+   * @brief Draw key paired with the index of the item it sorts
+   */
+  struct Entry {
+    std::uint64_t key;
+    std::uint32_t index;
+  };
+
+  std::vector<Item> items; /*!< Items in submission order */
+  std::vector<Entry> entries; /*!< Sorted keys */
+  std::vector<Entry> scratch; /*!< Radix sort swap buffer */
+  std::unordered_map<const void*, std::uint32_t> shaderIDs; /*!< Shaders seen this frame */
+  std::unordered_map<const void*, std::uint32_t> textureIDs; /*!< Textures seen this frame */
+  bool isSorted; /*!< True if entries are in key order */
+
+  /**
+   * @brief Maps a resource pointer to a small ID in the order it was first seen this frame
+   * @param ids lookup to use
+   * @param ptr resource
+   * @param max largest ID that fits in the key
+   * @return ID
+   */
+  static std::uint32_t IDOf(std::unordered_map<const void*, std::uint32_t>& ids, const void* ptr, std::uint32_t max);
+
+public:
+  RenderQueue();
+  ~RenderQueue();
+
+  /**
+   * @brief Builds a draw key
+   * @param row field row. Lower rows are drawn first.
+   * @param layer layer of the node. Higher layers are drawn first.
+   * @param shader shader ID
+   * @param texture texture ID
+   * @param index submission index
+   * @return 64-bit key
+   */
+  static const std::uint64_t MakeKey(int row, int layer, std::uint32_t shader, std::uint32_t texture, std::uint32_t index);
+
+  /**
+   * @brief Empties the queue for a new frame
+   */
+  void Clear();
+
+  /**
+   * @brief Queue a node to be drawn
+   * @param row field row the node is on
+   * @param node the node to draw
+   * @param states parent transform and shader to inherit
+   */
+  void Submit(int row, SpriteSceneNode& node, sf::RenderStates states = sf::RenderStates::Default);
+
+  /**
+   * @brief Sorts all submitted nodes by their draw key
+   */
+  void Sort();
+
+  /**
+   * @brief Sorts if needed and submits every node to the batch in key order
+   * @param batch
+   */
+  void Flush(SpriteBatch& batch);
+
+  /**
+   * @brief Query the number of queued nodes
+   * @return size
+   */
+  const std::size_t Size() const;
+};
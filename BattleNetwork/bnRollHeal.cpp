@@ -31,7 +31,8 @@ RollHeal::RollHeal(ChipSummonHandler* _summons, int _heal) : Spell(_summons->Get
 
   AUDIO.Play(AudioType::APPEAR);
 
-  setTexture(*TEXTURES.LoadTextureFromFile("resources/spells/spell_roll.png"), true);
+  texture = TEXTURES.LoadTexture("resources/spells/spell_roll.png");
+  setTexture(*texture, true);
 
   animationComponent = new AnimationComponent(this);
   this->RegisterComponent(animationComponent);
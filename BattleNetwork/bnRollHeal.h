@@ -8,6 +8,7 @@
 
 #include "bnSpell.h"
 #include "bnAnimationComponent.h"
+#include "bnTextureResourceManager.h"
 
 class ChipSummonHandler;
 
@@ -51,4 +52,5 @@ private:
   int random;
   ChipSummonHandler* summons;
   AnimationComponent* animationComponent;
+  TextureHandle texture;
 };
@@ -26,7 +26,8 @@ RollHeart::RollHeart(ChipSummonHandler* _summons, int _heal) : heal(_heal), Spel
 
   this->field->AddEntity(*this, _tile->GetX(), _tile->GetY());
 
-  setTexture(*TEXTURES.LoadTextureFromFile("resources/spells/spell_heart.png"), true);
+  texture = TEXTURES.LoadTexture("resources/spells/spell_heart.png");
+  setTexture(*texture, true);
   animationComponent = new AnimationComponent(this);
   this->RegisterComponent(animationComponent);
   animationComponent->Setup(RESOURCE_PATH);
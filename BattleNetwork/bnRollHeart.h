@@ -11,6 +11,7 @@
 #include "bnSpell.h"
 #include "bnChipSummonHandler.h"
 #include "bnAnimationComponent.h"
+#include "bnTextureResourceManager.h"
 
 
 class RollHeart : public Spell {
@@ -42,6 +43,7 @@ private:
   float height; /*!< The start height of the heart */
   Character* caller; /*!< The character that used the chip */
   ChipSummonHandler* summons; /*!< The chip summon system */
+  TextureHandle texture; /*!< Keeps the texture loaded while this exists */
   AnimationComponent* animationComponent;
   bool doOnce; /*!< Flag to restore health once */
 };
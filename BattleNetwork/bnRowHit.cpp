@@ -7,8 +7,8 @@
 RowHit::RowHit(Field* _field, Team _team, int damage) : damage(damage), Spell(_field, _team) {
   SetLayer(0);
 
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_CHARGED_BULLET_HIT);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_CHARGED_BULLET_HIT);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   //When the animation ends, delete this
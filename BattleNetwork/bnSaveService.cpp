@@ -0,0 +1,204 @@
+#include "bnSaveService.h"
+#include "bnLogger.h"
+
+#include <vector>
+#include <cstdio>
+#include <atomic>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+SaveService& SaveService::GetInstance() {
+  static SaveService instance;
+  return instance;
+}
+
+SaveService::SaveService() : writing(0), flushing(0), isRunning(false) {
+}
+
+SaveService::~SaveService() {
+  Stop();
+}
+
+void SaveService::Start() {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (isRunning) return;
+
+  isRunning = true;
+  thread = std::thread(&SaveService::Work, this);
+}
+
+void SaveService::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!isRunning) return;
+
+    isRunning = false;
+  }
+
+  wake.notify_all();
+
+  // The writer finishes everything that is pending before it exits
+  if (thread.joinable()) {
+    thread.join();
+  }
+}
+
+void SaveService::Save(const std::string& path, std::string contents) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (isRunning) {
+      // Replaces older text for the same file that has not been written yet.
+      // The first save decides when it is written so a busy file is never put off for long.
+      auto iter = pending.find(path);
+
+      if (iter == pending.end()) {
+        auto due = std::chrono::steady_clock::now() + std::chrono::milliseconds(SAVE_COALESCE_MILLISECONDS);
+        iter = pending.insert(std::make_pair(path, Pending({ std::string(), due }))).first;
+      }
+
+      iter->second.contents = std::move(contents);
+
+      wake.notify_all();
+      return;
+    }
+  }
+
+  // Not started. Write now.
+  Write(path, contents);
+}
+
+void SaveService::Flush() {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  if (!isRunning) return;
+
+  flushing++;
+  wake.notify_all();
+
+  idle.wait(lock, [this]() { return pending.empty() && writing == 0; });
+
+  flushing--;
+}
+
+const bool SaveService::IsBusy() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return !pending.empty() || writing > 0;
+}
+
+void SaveService::Work() {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (isRunning || !pending.empty()) {
+    if (pending.empty()) {
+      wake.wait(lock, [this]() { return !isRunning || !pending.empty(); });
+      continue;
+    }
+
+    // Take every save that has waited long enough. Write all of them if we are flushing or stopping.
+    auto now = std::chrono::steady_clock::now();
+    auto next = std::chrono::steady_clock::time_point::max();
+    bool hurry = flushing > 0 || !isRunning;
+
+    std::vector<std::pair<std::string, std::string>> ready;
+
+    for (auto iter = pending.begin(); iter != pending.end();) {
+      if (hurry || iter->second.due <= now) {
+        ready.push_back(std::make_pair(iter->first, std::move(iter->second.contents)));
+        iter = pending.erase(iter);
+      }
+      else {
+        next = std::min(next, iter->second.due);
+        iter++;
+      }
+    }
+
+    if (ready.empty()) {
+      wake.wait_until(lock, next);
+      continue;
+    }
+
+    writing++;
+    lock.unlock();
+
+    for (auto& save : ready) {
+      Write(save.first, save.second);
+    }
+
+    lock.lock();
+    writing--;
+
+    if (pending.empty()) {
+      idle.notify_all();
+    }
+  }
+
+  idle.notify_all();
+}
+
+bool SaveService::Write(const std::string& path, const std::string& contents) {
+  bool ok = WriteAtomic(path, contents);
+
+  if (ok) {
+    LOG_INFO(CORE, "Saved %s (%i bytes)", path.c_str(), (int)contents.size());
+  }
+  else {
+    LOG_ERROR(CORE, "Failed to save %s. The previous file was kept.", path.c_str());
+  }
+
+  return ok;
+}
+
+bool SaveService::WriteAtomic(const std::string& path, const std::string& data) {
+  static std::atomic<unsigned> writes{ 0 };
+
+  // Each write gets its own temporary file. Loader threads may write the same path at once.
+  std::string temp = path + "." + std::to_string(writes++) + ".tmp";
+  std::FILE* file = std::fopen(temp.c_str(), "wb");
+
+  if (!file) return false;
+
+  bool ok = std::fwrite(data.data(), sizeof(char), data.size(), file) == data.size();
+  ok = std::fflush(file) == 0 && ok;
+
+  // The rename must not reach the disk before the bytes do
+#ifdef _WIN32
+  ok = _commit(_fileno(file)) == 0 && ok;
+#else
+  ok = fsync(fileno(file)) == 0 && ok;
+#endif
+
+  ok = std::fclose(file) == 0 && ok;
+
+  std::error_code ec;
+
+  if (ok) {
+    std::filesystem::rename(temp, path, ec);
+  }
+
+  if (!ok || ec) {
+    std::filesystem::remove(temp, ec);
+    return false;
+  }
+
+#ifndef _WIN32
+  // Make the rename itself survive a power cut
+  std::string parent = std::filesystem::path(path).parent_path().string();
+  int dir = open(parent.empty() ? "." : parent.c_str(), O_RDONLY);
+
+  if (dir >= 0) {
+    fsync(dir);
+    close(dir);
+  }
+#endif
+
+  return true;
+}
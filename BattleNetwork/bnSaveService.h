@@ -0,0 +1,112 @@
+/*! \file bnSaveService.h */
+
+/*! \brief Singleton that writes save files on a background thread
+ *
+ * Scenes turn their data into text on the main thread and hand it to Save().
+ * The text is written by a worker thread so editing a folder does not stall
+ * the frame.
+ *
+ * Saves for the same file that arrive close together are merged and only the
+ * newest text is written. Every file is written with WriteAtomic() so a crash
+ * or power cut leaves either the old file or the new one, never a half written
+ * one.
+ */
+#pragma once
+#include <string>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+/*! \brief How long to wait for more saves to the same file before writing */
+#define SAVE_COALESCE_MILLISECONDS 250
+
+class SaveService {
+public:
+  /**
+   * @brief If this is the first call, initializes the service.
+   * @return Returns reference to the save service.
+   */
+  static SaveService& GetInstance();
+
+  /**
+   * @brief Starts the writer thread
+   */
+  void Start();
+
+  /**
+   * @brief Writes every pending save and joins the writer thread
+   */
+  void Stop();
+
+  /**
+   * @brief Queue text to be written to a file
+   * @param path file to replace
+   * @param contents the whole file
+   *
+   * If the service has not been started the file is written immediately on the calling thread
+   */
+  void Save(const std::string& path, std::string contents);
+
+  /**
+   * @brief Blocks until every queued save has been written
+   */
+  void Flush();
+
+  /**
+   * @brief Writes bytes to a file so that it is never left half written
+   * @param path
+   * @param data bytes to write
+   * @return true if the file now holds data. On failure the old file is untouched.
+   *
+   * The bytes go to a temporary file next to the target first. It is flushed to
+   * the disk and then renamed over the target, which replaces it in one step.
+   * Safe to call from any thread, even for the same path.
+   */
+  static bool WriteAtomic(const std::string& path, const std::string& data);
+
+  /**
+   * @brief Query if any saves are queued or being written
+   * @return true if busy
+   */
+  const bool IsBusy();
+
+private:
+  SaveService();
+  ~SaveService();
+
+  /**
+   * @brief Writer thread loop
+   */
+  void Work();
+
+  /**
+   * @brief Write a file and log the result
+   * @param path
+   * @param contents
+   * @return true if written
+   */
+  static bool Write(const std::string& path, const std::string& contents);
+
+  /**
+   * @struct Pending
+   * @brief Newest text for a file and when it may be written
+   */
+  struct Pending {
+    std::string contents;
+    std::chrono::steady_clock::time_point due;
+  };
+
+  std::thread thread; /*!< Writes files */
+  std::mutex mutex; /*!< Guards everything below */
+  std::condition_variable wake; /*!< Wakes the writer for a new save, a flush or Stop() */
+  std::condition_variable idle; /*!< Wakes Flush() when nothing is left to write */
+  std::map<std::string, Pending> pending; /*!< Path to newest text */
+  unsigned writing; /*!< Files being written right now */
+  unsigned flushing; /*!< Callers waiting in Flush(). Pending saves are written without waiting. */
+  bool isRunning; /*!< False when the writer should exit */
+};
+
+/*! \brief Shorthand to get instance of the save service */
+#define SAVES SaveService::GetInstance()
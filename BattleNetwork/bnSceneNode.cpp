@@ -4,6 +4,8 @@ SceneNode::SceneNode() {
   show = true;
   layer = 0;
   useParentShader = false;
+  childrenDirty = false;
+  parent = nullptr;
 }
 
 SceneNode::~SceneNode() {
@@ -11,7 +13,14 @@ SceneNode::~SceneNode() {
 }
 
 void SceneNode::SetLayer(int layer) {
+  if (this->layer == layer) return;
+
   this->layer = layer;
+
+  // Our parent's draw order is no longer valid
+  if (parent) {
+    parent->childrenDirty = true;
+  }
 }
 
 const int SceneNode::GetLayer() const {
@@ -37,7 +46,7 @@ const bool SceneNode::IsVisible() const {
 void SceneNode::draw(sf::RenderTarget& target, sf::RenderStates states) const {
   if (!show) return;
 
-  std::sort(childNodes.begin(), childNodes.end(), [](SceneNode* a, SceneNode* b) { return (a->GetLayer() > b->GetLayer()); });
+  SortChildNodes();
 
   // draw its children
   for (std::size_t i = 0; i < childNodes.size(); i++) {
@@ -51,8 +60,16 @@ void SceneNode::draw(sf::RenderTarget& target, sf::RenderStates states) const {
   }
 }
 
+void SceneNode::SortChildNodes() const {
+  if (!childrenDirty) return;
+
+  std::stable_sort(childNodes.begin(), childNodes.end(), [](SceneNode* a, SceneNode* b) { return (a->GetLayer() > b->GetLayer()); });
+
+  childrenDirty = false;
+}
+
 void SceneNode::AddNode(SceneNode* child) { 
-  if (child == nullptr) return;  child->parent = this; childNodes.push_back(child); 
+  if (child == nullptr) return;  child->parent = this; childNodes.push_back(child); childrenDirty = true;
 }
 
 void SceneNode::RemoveNode(SceneNode* find) {
@@ -75,5 +92,7 @@ const bool SceneNode::IsUsingParentShader() const
 
 std::vector<SceneNode*>& SceneNode::GetChildNodes()
 {
+  // The caller may reorder the list
+  childrenDirty = true;
   return childNodes;
 }
@@ -17,6 +17,14 @@ protected:
   bool show; /*!< Flag to hide or display a scene node and its children */
   int layer; /*!< Draw order of this node */
   bool useParentShader;
+  mutable bool childrenDirty; /*!< If true, childNodes must be sorted before the next draw */
+
+  /**
+   * @brief Sort the child nodes by descending layer if they changed since the last sort
+   *
+   * The sort is stable so nodes with the same layer keep the order they were added in
+   */
+  void SortChildNodes() const;
 
 public:
   /**
@@ -0,0 +1,208 @@
+#include "bnScriptCoroutine.h"
+#include "bnScriptResourceManager.h"
+#include "bnLogger.h"
+
+ScriptCoroutine* ScriptCoroutine::running = nullptr;
+
+ScriptCoroutine::ScriptCoroutine() :
+  thread(nullptr), ref(LUA_NOREF), retired(nullptr), retiredRef(LUA_NOREF), nargs(0),
+  state(State::DONE), frames(0), preempted(false), instructions(0)
+{
+}
+
+ScriptCoroutine::~ScriptCoroutine()
+{
+  Release();
+
+  if (retired) {
+    luaL_unref(retired, LUA_REGISTRYINDEX, retiredRef);
+  }
+}
+
+void ScriptCoroutine::Start(lua_State* L, int nargs)
+{
+  Release();
+
+  // Name the behaviour after the script that defined the function
+  lua_Debug ar;
+  lua_pushvalue(L, -(nargs + 1));
+  name = lua_getinfo(L, ">S", &ar) ? ar.short_src : "?";
+
+  thread = lua_newthread(L);
+  ref = luaL_ref(L, LUA_REGISTRYINDEX);
+  lua_xmove(L, thread, nargs + 1);
+  lua_sethook(thread, &ScriptCoroutine::Hook, LUA_MASKCOUNT, SCRIPT_HOOK_INSTRUCTIONS);
+
+  this->nargs = nargs;
+  state = State::RUNNING;
+  frames = 0;
+  event.clear();
+}
+
+void ScriptCoroutine::Stop()
+{
+  Release();
+  state = State::DONE;
+}
+
+void ScriptCoroutine::Release()
+{
+  if (!thread) return;
+
+  if (running == this) {
+    // Lua is still running on this thread. Keep it alive until the resume returns.
+    if (retired) {
+      luaL_unref(retired, LUA_REGISTRYINDEX, retiredRef);
+    }
+
+    retired = thread;
+    retiredRef = ref;
+  }
+  else {
+    luaL_unref(thread, LUA_REGISTRYINDEX, ref);
+  }
+
+  thread = nullptr;
+  ref = LUA_NOREF;
+}
+
+void ScriptCoroutine::Update()
+{
+  switch (state) {
+  case State::WAITING_FRAMES:
+    if (--frames > 0) return;
+    state = State::RUNNING;
+    break;
+  case State::RUNNING:
+    break;
+  default:
+    return;
+  }
+
+  lua_State* resumed = thread;
+  ScriptCoroutine* previous = running;
+
+  running = this;
+  preempted = false;
+  instructions = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  deadline = start + std::chrono::microseconds(SCRIPT_FRAME_MICROSECONDS);
+  limit = start + std::chrono::microseconds(SCRIPT_FRAME_MICROSECONDS * SCRIPT_FRAME_OVERRUN);
+
+  int status = lua_resume(resumed, nullptr, nargs);
+
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  running = previous;
+  nargs = 0;
+
+  SCRIPTS.Profile(name, secs, preempted);
+
+  if (resumed != thread) {
+    // The behaviour replaced or stopped itself. Whatever the old thread did no longer matters.
+    if (retired) {
+      luaL_unref(retired, LUA_REGISTRYINDEX, retiredRef);
+      retired = nullptr;
+      retiredRef = LUA_NOREF;
+    }
+
+    return;
+  }
+
+  if (status == LUA_YIELD) {
+    // WaitFrames() and WaitForEvent() already set the state. A preempted or plain yield runs again next frame.
+    lua_settop(thread, 0);
+  }
+  else if (status == LUA_OK) {
+    lua_settop(thread, 0);
+    state = State::DONE;
+  }
+  else {
+    luaL_traceback(thread, thread, lua_tostring(thread, -1), 0);
+
+    LOG_ERROR(SCRIPT, "Behaviour from %s stopped: %s", name.c_str(), lua_tostring(thread, -1));
+
+    Release();
+    state = State::FAILED;
+  }
+}
+
+void ScriptCoroutine::Signal(const std::string& event)
+{
+  if (state != State::WAITING_EVENT || this->event != event) return;
+
+  this->event.clear();
+  state = State::RUNNING;
+}
+
+const ScriptCoroutine::State ScriptCoroutine::GetState() const
+{
+  return state;
+}
+
+const std::string& ScriptCoroutine::GetName() const
+{
+  return name;
+}
+
+int ScriptCoroutine::WaitFrames(lua_State* L)
+{
+  lua_Integer count = luaL_optinteger(L, 1, 1);
+  ScriptCoroutine* coroutine = running;
+
+  if (!coroutine || coroutine->thread != L || !lua_isyieldable(L)) {
+    return luaL_error(L, "Battle.WaitFrames can only be called from a behaviour");
+  }
+
+  coroutine->state = State::WAITING_FRAMES;
+  coroutine->frames = count < 1 ? 1 : static_cast<unsigned>(count);
+
+  return lua_yield(L, 0);
+}
+
+int ScriptCoroutine::WaitForEvent(lua_State* L)
+{
+  const char* event = luaL_checkstring(L, 1);
+  ScriptCoroutine* coroutine = running;
+
+  if (!coroutine || coroutine->thread != L || !lua_isyieldable(L)) {
+    return luaL_error(L, "Battle.WaitForEvent can only be called from a behaviour");
+  }
+
+  coroutine->state = State::WAITING_EVENT;
+  coroutine->event = event;
+
+  return lua_yield(L, 0);
+}
+
+void ScriptCoroutine::Hook(lua_State* L, lua_Debug* ar)
+{
+  ScriptCoroutine* coroutine = running;
+
+  if (!coroutine) return;
+
+  // Coroutines the script makes itself inherit the hook and count against the same budget
+  coroutine->instructions += SCRIPT_HOOK_INSTRUCTIONS;
+
+  auto now = std::chrono::steady_clock::now();
+
+  bool over = coroutine->instructions >= SCRIPT_FRAME_INSTRUCTIONS || now >= coroutine->deadline;
+
+  if (!over) return;
+
+  // Only the behaviour's own thread is preempted. Yielding a script's own coroutine would hand it a fake result.
+  if (L == coroutine->thread && lua_isyieldable(L)) {
+    coroutine->preempted = true;
+    lua_yield(L, 0);
+    return;
+  }
+
+  if (coroutine->instructions >= SCRIPT_FRAME_INSTRUCTIONS * SCRIPT_FRAME_OVERRUN) {
+    luaL_error(L, "used more than %d instructions in one frame", SCRIPT_FRAME_INSTRUCTIONS * SCRIPT_FRAME_OVERRUN);
+  }
+
+  if (now >= coroutine->limit) {
+    luaL_error(L, "ran for more than %d microseconds in one frame", SCRIPT_FRAME_MICROSECONDS * SCRIPT_FRAME_OVERRUN);
+  }
+}
@@ -0,0 +1,134 @@
+/*! \file bnScriptCoroutine.h */
+
+/*! \brief Runs a scripted behaviour a little every frame
+ *
+ * A behaviour is a lua function that runs as a coroutine. The owner calls
+ * Update() once a frame and the coroutine runs until it yields.
+ * Battle.WaitFrames(n) sleeps for n frames, Battle.WaitForEvent(name) sleeps
+ * until the owner calls Signal(name) and coroutine.yield() sleeps until the
+ * next frame.
+ *
+ * A count hook checks the coroutine every SCRIPT_HOOK_INSTRUCTIONS
+ * instructions. Once it has used SCRIPT_FRAME_INSTRUCTIONS instructions or
+ * SCRIPT_FRAME_MICROSECONDS in one frame it is preempted and carries on where
+ * it left off next frame. A script stuck in a loop costs one budget a frame
+ * instead of freezing the battle.
+ *
+ * Lua cannot yield from inside a C function that calls back into lua, like the
+ * comparator given to table.sort. A coroutine that runs SCRIPT_FRAME_OVERRUN
+ * times over either budget there is stopped with an error.
+ *
+ * Time spent in every resume is reported to ScriptResourceManager::Profile()
+ * under the name of the script the function came from.
+ */
+#pragma once
+#include <string>
+#include <chrono>
+
+struct lua_State;
+struct lua_Debug;
+
+/*! \brief How often the hook checks the budget */
+#define SCRIPT_HOOK_INSTRUCTIONS 1000
+
+/*! \brief Instructions a coroutine may run each frame before it is preempted */
+#define SCRIPT_FRAME_INSTRUCTIONS 100000
+
+/*! \brief Time a coroutine may run each frame before it is preempted */
+#define SCRIPT_FRAME_MICROSECONDS 1000
+
+/*! \brief How many budgets a coroutine that cannot be preempted may use before it is stopped */
+#define SCRIPT_FRAME_OVERRUN 4
+
+class ScriptCoroutine {
+public:
+  /**
+   * @brief What the coroutine does on the next Update()
+   */
+  enum class State : char {
+    RUNNING,        /*!< Resumes */
+    WAITING_FRAMES, /*!< Counts down frames */
+    WAITING_EVENT,  /*!< Sleeps until Signal() */
+    DONE,           /*!< Returned or never started */
+    FAILED          /*!< Raised an error. The error is logged. */
+  };
+
+  ScriptCoroutine();
+  ScriptCoroutine(const ScriptCoroutine& rhs) = delete;
+  ScriptCoroutine& operator=(const ScriptCoroutine& rhs) = delete;
+  ~ScriptCoroutine();
+
+  /**
+   * @brief Replace the behaviour with a function on the lua stack
+   * @param L stack with the function followed by its arguments. They are all popped.
+   * @param nargs number of arguments
+   *
+   * The function first runs on the next Update(). A coroutine may replace itself.
+   */
+  void Start(lua_State* L, int nargs);
+
+  /**
+   * @brief Drop the behaviour. It never runs again.
+   */
+  void Stop();
+
+  /**
+   * @brief Run the coroutine for one frame if it is not waiting
+   */
+  void Update();
+
+  /**
+   * @brief Wake the coroutine if it is waiting for this event
+   * @param event e.g. the name of an animation that finished
+   */
+  void Signal(const std::string& event);
+
+  /**
+   * @brief Get what the coroutine does next frame
+   * @return State
+   */
+  const State GetState() const;
+
+  /**
+   * @brief Get the name of the script the behaviour came from
+   * @return e.g. "resources/mobs/mettaur/entry.lua"
+   */
+  const std::string& GetName() const;
+
+  /**
+   * @brief Battle.WaitFrames(n). Sleeps the running coroutine for n frames (at least 1).
+   */
+  static int WaitFrames(lua_State* L);
+
+  /**
+   * @brief Battle.WaitForEvent(name). Sleeps the running coroutine until the event is signaled.
+   */
+  static int WaitForEvent(lua_State* L);
+
+private:
+  /**
+   * @brief Count hook. Preempts the running coroutine once it has used its budget.
+   */
+  static void Hook(lua_State* L, lua_Debug* ar);
+
+  /**
+   * @brief Let lua collect the thread. Deferred if the thread is being resumed.
+   */
+  void Release();
+
+  static ScriptCoroutine* running; /*!< Coroutine being resumed. Only the main thread resumes coroutines. */
+
+  lua_State* thread; /*!< nullptr if there is no behaviour */
+  int ref; /*!< Registry reference that keeps the thread alive */
+  lua_State* retired; /*!< Thread that was replaced while it was running */
+  int retiredRef;
+  int nargs; /*!< Arguments waiting for the first resume */
+  State state;
+  unsigned frames; /*!< Frames left to wait */
+  std::string event; /*!< Event being waited for */
+  std::string name;
+  bool preempted; /*!< Set by the hook when it yields */
+  long long instructions; /*!< Run since this frame's resume began */
+  std::chrono::steady_clock::time_point deadline; /*!< End of this frame's time budget */
+  std::chrono::steady_clock::time_point limit; /*!< Past this a coroutine that cannot be preempted is stopped */
+};
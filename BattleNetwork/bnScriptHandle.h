@@ -0,0 +1,99 @@
+/*! \file bnScriptHandle.h */
+
+/*! \brief Handles that scripts hold instead of pointers to engine objects
+ *
+ * Objects can be deleted while a script still holds on to them. Scripts are
+ * given a small handle made of a slot index and a generation. The object lives
+ * in that slot until it is removed, which bumps the generation. Old handles no
+ * longer match and resolve to nullptr, so a script can never reach a deleted
+ * object.
+ *
+ * Creating, removing and resolving a handle are all O(1). Freed slots are reused.
+ */
+#pragma once
+#include <vector>
+#include <cstdint>
+
+/**
+ * @struct ScriptHandle
+ * @brief Index and generation of an object in a ScriptHandleTable
+ *
+ * Templated on the object type so each kind of handle is its own type in lua
+ */
+template<typename T>
+struct ScriptHandle {
+  std::uint32_t index;
+  std::uint32_t generation; /*!< 0 is never used by a live object */
+};
+
+template<typename T>
+class ScriptHandleTable {
+public:
+  /**
+   * @brief Add an object and get a handle to it
+   * @param object must be removed before it is deleted
+   * @return handle
+   */
+  ScriptHandle<T> Create(T* object) {
+    std::uint32_t index;
+
+    if (freeSlots.empty()) {
+      index = (std::uint32_t)slots.size();
+      slots.push_back(Slot({ nullptr, 1 }));
+    }
+    else {
+      index = freeSlots.back();
+      freeSlots.pop_back();
+    }
+
+    slots[index].object = object;
+    return ScriptHandle<T>({ index, slots[index].generation });
+  }
+
+  /**
+   * @brief Remove an object. Every handle to it stops resolving.
+   * @param handle
+   *
+   * Removing a handle that is already stale does nothing
+   */
+  void Remove(ScriptHandle<T> handle) {
+    if (!Resolve(handle)) return;
+
+    Slot& slot = slots[handle.index];
+    slot.object = nullptr;
+
+    // Skip 0 when the generation wraps so a zeroed handle never matches
+    if (++slot.generation == 0) slot.generation = 1;
+
+    freeSlots.push_back(handle.index);
+  }
+
+  /**
+   * @brief Get the object for a handle
+   * @param handle
+   * @return the object or nullptr if it has been removed
+   */
+  T* Resolve(ScriptHandle<T> handle) const {
+    if (handle.index >= slots.size()) return nullptr;
+
+    const Slot& slot = slots[handle.index];
+    return slot.generation == handle.generation ? slot.object : nullptr;
+  }
+
+  /**
+   * @brief Query the number of live objects
+   * @return count
+   */
+  const std::size_t GetSize() const {
+    return slots.size() - freeSlots.size();
+  }
+
+private:
+  struct Slot {
+    T* object;
+    std::uint32_t generation;
+  };
+
+  std::vector<Slot> slots;
+  std::vector<std::uint32_t> freeSlots; /*!< Indices of removed objects to reuse */
+};
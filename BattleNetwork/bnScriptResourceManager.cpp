@@ -3,6 +3,18 @@
 #include "bnScriptedCharacter.h"
 #include "bnElements.h"
 #include "bnScriptedChipAction.h"
+#include "bnScriptCoroutine.h"
+#include "bnAnimationComponent.h"
+#include "bnFileUtil.h"
+#include "bnAssetLoader.h"
+#include "bnSaveService.h"
+
+#include <cstring>
+#include <cstddef>
+#include <cstdio>
+#include <algorithm>
+#include <mutex>
+#include <random>
 
 // Building the c lib on windows failed. 
 // Including the c files directly into source avoids static linking
@@ -41,28 +53,126 @@
 #include <lvm.c>
 #include <lzio.c>
 
+namespace {
+  std::uint64_t HashText(const std::string& text, std::uint64_t hash = 14695981039346656037ull) {
+    for (char c : text) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ull;
+    }
+
+    return hash;
+  }
+
+  /**
+   * @brief Keyed hash of a compiled script file
+   * @param key @see ScriptResourceManager::CacheKey()
+   * @param file header with a zero signature followed by the bytecode
+   * @return signature
+   *
+   * The key is hashed on both ends. A hash of the key and file alone could be
+   * run backwards from a valid file to forge others.
+   */
+  std::uint64_t Sign(const std::string& key, const std::string& file) {
+    return HashText(key, HashText(file, HashText(key)));
+  }
+
+  /**
+   * @brief lua_Writer that appends the dumped chunk to a std::string
+   */
+  int WriteChunk(lua_State* L, const void* data, size_t size, void* userdata) {
+    static_cast<std::string*>(userdata)->append(static_cast<const char*>(data), size);
+    return 0;
+  }
+
+  /**
+   * @brief Raise a lua error if a handle did not resolve
+   * @param object result of ScriptResourceManager::Resolve()
+   * @return object
+   */
+  template<typename T>
+  T* Expect(T* object) {
+    if (!object) {
+      // sol turns exceptions thrown by bound functions into lua errors
+      throw sol::error("handle is not valid");
+    }
+
+    return object;
+  }
+}
+
+ScriptResourceManager::ScriptResourceManager() : isConfigured(false) {
+}
+
 void ScriptResourceManager::ConfigureEnvironment() {
-  luaState.open_libraries(sol::lib::base);
+  // Behaviours wait with coroutine.yield() and may sort with table.sort
+  luaState.open_libraries(sol::lib::base, sol::lib::coroutine, sol::lib::table);
 
   auto battle_namespace = luaState.create_table("Battle");
 
-  // make usertype metatable
-  auto character_record = battle_namespace.new_usertype<ScriptedCharacter>("Character",
-    sol::constructors<ScriptedCharacter(Character::Rank)>(),
-    sol::base_classes, sol::bases<Entity>(),
-    "GetName", &Character::GetName,
-    "GetID", &Entity::GetID,
-    "GetHealth", &Character::GetHealth,
-    "GetMaxHealth", &Character::GetMaxHealth,
-    "SetHealth", &Character::SetHealth
+  // Scripts hold handles, never pointers. Each method checks the handle first.
+  auto character_record = battle_namespace.new_usertype<ScriptHandle<Character>>("Character",
+    "new", sol::factories([this](Character::Rank rank) {
+      // Owned by the engine once it is spawned on the field
+      return (new ScriptedCharacter(rank))->GetHandle();
+    }),
+    "IsValid", [this](ScriptHandle<Character> handle) { return Resolve(handle) != nullptr; },
+    "GetName", [this](ScriptHandle<Character> handle) { return Expect(Resolve(handle))->GetName(); },
+    "GetID", [this](ScriptHandle<Character> handle) { return Expect(Resolve(handle))->GetID(); },
+    "GetHealth", [this](ScriptHandle<Character> handle) { return Expect(Resolve(handle))->GetHealth(); },
+    "GetMaxHealth", [this](ScriptHandle<Character> handle) { return Expect(Resolve(handle))->GetMaxHealth(); },
+    "SetHealth", [this](ScriptHandle<Character> handle, int health) { Expect(Resolve(handle))->SetHealth(health); },
+    "Run", [this](ScriptHandle<Character> handle, sol::function behaviour) {
+      ScriptedCharacter* character = dynamic_cast<ScriptedCharacter*>(Expect(Resolve(handle)));
+
+      if (!character) {
+        throw sol::error("only scripted characters can run a behaviour");
+      }
+
+      character->Run(behaviour);
+    },
+    "PlayAnimation", [this](ScriptHandle<Character> handle, std::string state) {
+      AnimationComponent* anim = Expect(Resolve(handle))->GetFirstComponent<AnimationComponent>();
+
+      if (!anim) {
+        throw sol::error("character has no animation");
+      }
+
+      // Wakes a behaviour waiting on Battle.WaitForEvent(state)
+      anim->SetAnimation(state, [this, handle, state]() {
+        // The character can be deleted before the animation ends
+        if (ScriptedCharacter* character = dynamic_cast<ScriptedCharacter*>(Resolve(handle))) {
+          character->Signal(state);
+        }
+      });
+    }
     );
 
   // TODO: register animation callback methods
-  auto chip_record = battle_namespace.new_usertype<ScriptedChipAction>("ChipAction",
-    sol::constructors<ScriptedChipAction(Character*, int)>(),
-    sol::base_classes, sol::bases<ChipAction>()
+  auto chip_record = battle_namespace.new_usertype<ScriptHandle<ChipAction>>("ChipAction",
+    "new", sol::factories([this](ScriptHandle<Character> owner, int damage) {
+      return (new ScriptedChipAction(Expect(Resolve(owner)), damage))->GetHandle();
+    }),
+    "IsValid", [this](ScriptHandle<ChipAction> handle) { return Resolve(handle) != nullptr; },
+    "Run", [this](ScriptHandle<ChipAction> handle, sol::function behaviour) {
+      ScriptedChipAction* action = dynamic_cast<ScriptedChipAction*>(Expect(Resolve(handle)));
+
+      if (!action) {
+        throw sol::error("only scripted chip actions can run a behaviour");
+      }
+
+      action->Run(behaviour);
+    }
     );
 
+  // Behaviours yield with these. Plain C functions because they yield the calling coroutine.
+  lua_State* L = luaState.lua_state();
+  battle_namespace.push();
+  lua_pushcfunction(L, &ScriptCoroutine::WaitFrames);
+  lua_setfield(L, -2, "WaitFrames");
+  lua_pushcfunction(L, &ScriptCoroutine::WaitForEvent);
+  lua_setfield(L, -2, "WaitForEvent");
+  lua_pop(L, 1);
+
   auto elements_table = battle_namespace.new_enum("Element");
   elements_table["FIRE"] = Element::FIRE;
   elements_table["AQUA"] = Element::AQUA;
@@ -77,77 +187,101 @@ void ScriptResourceManager::ConfigureEnvironment() {
   elements_table["NONE"] = Element::NONE;
   elements_table["ICE"] = Element::ICE;
 
-  try {
-    luaState.script(
-      "--[[This system EXPECTS type Entity to have a GetID() function"
-      "call to return a unique identifier"
-      "--]]"
-
-      "Handles = {}"
-      "local memoizedFuncs = {}"
-
-      "-- metatable which caches function calls"
-      "local mt = {}"
-      "mt.__index = function(handle, key)"
-      "  if not handle.isValid then"
-      "    print(debug.traceback())"
-      "    error('Error: handle is not valid!', 2)"
-      "  end"
-
-      "  local f = memoizedFuncs[key]"
-      "     if not f then"
-      "       if handle.classType == 'Entity' then"
-      "         f = function(handle, ...) return Battle.Entity[key](handle.cppRef, ...) end"
-      "       elseif handle.classType == 'Character' then"
-      "         f = function(handle, ...) return Battle.Character[key](handle.cppRef, ...) end"
-      "       end"
-
-      "       memoizedFuncs[key] = f"
-      "     end"
-      "  return f"
-      "end"
-
-      "-- exception catcher to avoid problems in C++"
-      "function getWrappedSafeFunction(f)"
-      "  return function(handle, ...)"
-      "    if not handle.isValid then"
-      "      print(debug.traceback())"
-      "      error('Error: handle is not valid!', 2)"
-      "    end"
-
-      "    return f(handle.cppRef, ...)"
-      "  end"
-      "end"
-
-      "-- To be called at the beginning of an Entity's lifetime"
-      "  function createHandle(cppRef, classType)"
-      "  local handle = {"
-      "      cppRef = cppRef,"
-      "      classType = classType,"
-      "      isValid = true"
-      "  }"
-
-      "-- speedy access without __index call"
-      "-- decrease call - time and wraps in an exception - catcher:"
-      "-- handle.getName = getWrappedSafeFunction(Entity.getName)"
-
-      "setmetatable(handle, mt)"
-      "  Handles[cppRef:GetID()] = handle"
-      "  return handle"
-      "end"
-
-      "-- To be called at the end of an Entity's lifetime"
-      "function onEntityRemoved(cppRef)"
-      "  local handle = Handles[cppRef:GetID()];"
-      "  handle.cppRef = nil"
-      "  handle.isValid = false"
-      "  Handles[cppRef:GetID()] = nil"
-      "end"
-    );
+  isConfigured = true;
+}
+
+std::string ScriptResourceManager::CachePath(const std::string& path) {
+  char name[17];
+  std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(HashText(path)));
+
+  return std::string(COMPILED_SCRIPT_DIRECTORY) + "/" + name + COMPILED_SCRIPT_EXTENSION;
+}
+
+const std::string& ScriptResourceManager::CacheKey() {
+  // Workers compile in parallel. The first one to get here makes the key.
+  static const std::string key = []() {
+    std::string path = std::string(COMPILED_SCRIPT_DIRECTORY) + "/key";
+    std::string stored = FileUtil::Read(path);
+
+    if (stored.size() == COMPILED_SCRIPT_KEY_BYTES) return stored;
+
+    std::random_device random;
+    std::string made;
+
+    while (made.size() < COMPILED_SCRIPT_KEY_BYTES) {
+      made.push_back(static_cast<char>(random() & 0xFF));
+    }
+
+    // Without a saved key, files signed this run are compiled again next run
+    if (!FileUtil::MakeDirectory(COMPILED_SCRIPT_DIRECTORY) || !SaveService::WriteAtomic(path, made)) {
+      LOG_WARN(SCRIPT, "Could not write %s. Compiled scripts will not be reused.", path.c_str());
+    }
+
+    return made;
+  }();
+
+  return key;
+}
+
+bool ScriptResourceManager::LoadChunk(lua_State* L, const std::string& source, const std::string& chunkName, const std::string& cachePath, bool& cached) {
+  ChunkHeader expected;
+  std::memcpy(expected.magic, "OBNL", 4);
+  expected.version = CHUNK_VERSION;
+  expected.luaVersion = LUA_VERSION_NUM;
+  expected.numberSize = sizeof(lua_Number);
+  expected.sourceHash = HashText(source);
+  expected.sourceSize = source.size();
+  expected.signature = 0;
+
+  const std::size_t signatureOffset = offsetof(ChunkHeader, signature);
+
+  cached = false;
+
+  std::string bytes = cachePath.empty() ? std::string() : FileUtil::Read(cachePath);
+
+  if (bytes.size() > sizeof(ChunkHeader) && std::memcmp(bytes.data(), &expected, signatureOffset) == 0) {
+    std::uint64_t signature;
+    std::memcpy(&signature, bytes.data() + signatureOffset, sizeof(signature));
+    std::memset(&bytes[signatureOffset], 0, sizeof(signature));
+
+    const char* chunk = bytes.data() + sizeof(ChunkHeader);
+    std::size_t size = bytes.size() - sizeof(ChunkHeader);
+
+    // Not written by this install. Never run it.
+    if (signature != Sign(CacheKey(), bytes)) {
+      LOG_WARN(SCRIPT, "Ignoring compiled script %s for %s. It was not made by this install.", cachePath.c_str(), chunkName.c_str());
+    }
+    // "b" refuses anything that is not bytecode
+    else if (luaL_loadbufferx(L, chunk, size, chunkName.c_str(), "b") == LUA_OK) {
+      cached = true;
+      return true;
+    }
+    else {
+      // Damaged. Fall back to the source.
+      lua_pop(L, 1);
+    }
   }
-  catch (const sol::error& err) {
-    Logger::Logf("[ShaderResourceManager] Something went wrong while configuring the environment: thrown error, %s", err.what());
+
+  if (luaL_loadbufferx(L, source.data(), source.size(), chunkName.c_str(), "t") != LUA_OK) {
+    LOG_ERROR(SCRIPT, "Failed to compile %s: %s", chunkName.c_str(), lua_tostring(L, -1));
+    lua_pop(L, 1);
+    return false;
   }
+
+  std::string compiled(reinterpret_cast<const char*>(&expected), sizeof(ChunkHeader));
+
+  // Keep debug info so errors still report line numbers
+  if (!cachePath.empty() && lua_dump(L, WriteChunk, &compiled, 0) == 0) {
+    std::uint64_t signature = Sign(CacheKey(), compiled);
+    std::memcpy(&compiled[signatureOffset], &signature, sizeof(signature));
+
+    // Renamed into place so a worker or a crash never leaves half a file
+    if (FileUtil::MakeDirectory(COMPILED_SCRIPT_DIRECTORY)) {
+      SaveService::WriteAtomic(cachePath, compiled);
+    }
+  }
+
+  return true;
 }
 
 void ScriptResourceManager::AddToPaths(FileMeta pathInfo)
@@ -155,6 +289,178 @@ void ScriptResourceManager::AddToPaths(FileMeta pathInfo)
   paths.push_back(pathInfo);
 }
 
+ScriptHandle<Character> ScriptResourceManager::CreateHandle(Character* character)
+{
+  return characters.Create(character);
+}
+
+ScriptHandle<ChipAction> ScriptResourceManager::CreateHandle(ChipAction* action)
+{
+  return chipActions.Create(action);
+}
+
+void ScriptResourceManager::RemoveHandle(ScriptHandle<Character> handle)
+{
+  characters.Remove(handle);
+}
+
+void ScriptResourceManager::RemoveHandle(ScriptHandle<ChipAction> handle)
+{
+  chipActions.Remove(handle);
+}
+
+Character* ScriptResourceManager::Resolve(ScriptHandle<Character> handle) const
+{
+  return characters.Resolve(handle);
+}
+
+ChipAction* ScriptResourceManager::Resolve(ScriptHandle<ChipAction> handle) const
+{
+  return chipActions.Resolve(handle);
+}
+
+void ScriptResourceManager::Profile(const std::string& script, double seconds, bool preempted)
+{
+  ScriptProfile& profile = profiles.insert(std::make_pair(script, ScriptProfile({ 0, 0, 0, 0 }))).first->second;
+
+  profile.seconds += seconds;
+  profile.worstSeconds = std::max(profile.worstSeconds, seconds);
+  profile.resumes++;
+
+  if (preempted && profile.preemptions++ == 0) {
+    LOG_WARN(SCRIPT, "%s ran out of time this frame and will continue next frame", script.c_str());
+  }
+}
+
+const std::map<std::string, ScriptResourceManager::ScriptProfile>& ScriptResourceManager::GetProfiles() const
+{
+  return profiles;
+}
+
+void ScriptResourceManager::LogProfiles() const
+{
+  std::vector<std::pair<std::string, ScriptProfile>> sorted(profiles.begin(), profiles.end());
+
+  std::sort(sorted.begin(), sorted.end(), [](auto& a, auto& b) { return a.second.seconds > b.second.seconds; });
+
+  for (auto& entry : sorted) {
+    const ScriptProfile& profile = entry.second;
+
+    LOG_INFO(SCRIPT, "Script %s: %f secs over %i frames (worst %f secs, preempted %i times)",
+      entry.first.c_str(), profile.seconds, (int)profile.resumes, profile.worstSeconds, (int)profile.preemptions);
+  }
+}
+
+ScriptResourceManager::Compiled ScriptResourceManager::Compile(lua_State* L, const FileMeta& meta)
+{
+  Compiled result({ std::string(), false, 0, 0 });
+  sf::Clock clock;
+
+  std::string source = FileUtil::Read(meta.path);
+  result.readSecs = clock.restart().asSeconds();
+
+  // Nothing is cached for scripts that only exist in the resource archive
+  std::string cachePath = FileUtil::Exists(meta.path) ? CachePath(meta.path) : std::string();
+
+  if (L && !source.empty() && LoadChunk(L, source, "@" + meta.path, cachePath, result.cached)) {
+    lua_dump(L, WriteChunk, &result.bytecode, 0);
+    lua_pop(L, 1);
+  }
+
+  result.compileSecs = clock.getElapsedTime().asSeconds();
+
+  return result;
+}
+
 void ScriptResourceManager::LoadAllSCripts(std::atomic<int>& status)
 {
+  sf::Clock total;
+
+  if (!isConfigured) {
+    ConfigureEnvironment();
+  }
+
+  std::vector<Compiled> compiled(paths.size());
+
+  // Each worker borrows a bare state to compile in. A state is only ever used by one thread at a time.
+  std::vector<lua_State*> states;
+  std::mutex statesMutex;
+  int stateCount = 0;
+
+  LOADER.ParallelFor(paths.size(), [this, &compiled, &states, &statesMutex, &stateCount](std::size_t i) {
+    lua_State* worker = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(statesMutex);
+
+      if (!states.empty()) {
+        worker = states.back();
+        states.pop_back();
+      }
+    }
+
+    if (!worker) {
+      worker = luaL_newstate();
+    }
+
+    compiled[i] = Compile(worker, paths[i]);
+
+    if (worker) {
+      std::lock_guard<std::mutex> lock(statesMutex);
+      states.push_back(worker);
+      stateCount = std::max(stateCount, (int)states.size());
+    }
+  });
+
+  for (lua_State* worker : states) {
+    lua_close(worker);
+  }
+
+  float compileSecs = total.getElapsedTime().asSeconds();
+
+  // Running a script registers its table in the shared state so this part is serial
+  lua_State* L = luaState.lua_state();
+  int cachedCount = 0;
+
+  for (std::size_t i = 0; i < paths.size(); i++) {
+    const FileMeta& meta = paths[i];
+    const Compiled& result = compiled[i];
+
+    sf::Clock clock;
+    std::string chunkName = "@" + meta.path;
+
+    if (result.bytecode.empty() || luaL_loadbufferx(L, result.bytecode.data(), result.bytecode.size(), chunkName.c_str(), "b") != LUA_OK) {
+      if (!result.bytecode.empty()) {
+        lua_pop(L, 1);
+      }
+
+      LOG_ERROR(SCRIPT, "Script %s could not be loaded from %s", meta.name.c_str(), meta.path.c_str());
+
+      status++;
+      continue;
+    }
+
+    // Scripts return their table
+    if (lua_pcall(L, 0, 1, 0) != LUA_OK) {
+      LOG_ERROR(SCRIPT, "Script %s failed to run: %s", meta.name.c_str(), lua_tostring(L, -1));
+    }
+    else {
+      if (lua_istable(L, -1)) {
+        scriptTableHash[meta.name] = sol::table(L, -1);
+      }
+
+      nameToTypeHash[meta.name] = meta.type;
+    }
+
+    lua_pop(L, 1);
+
+    float runSecs = clock.getElapsedTime().asSeconds();
+    cachedCount += result.cached ? 1 : 0;
+
+    LOG_DEBUG(SCRIPT, "Script %s: read %f secs, %s %f secs, run %f secs", meta.name.c_str(), result.readSecs, result.cached ? "cached" : "compiled", result.compileSecs, runSecs);
+
+    status++;
+  }
+
+  LOG_INFO(SCRIPT, "Loaded %i scripts (%i from cache) in %f secs. Compiled on %i states in %f secs.", (int)paths.size(), cachedCount, total.getElapsedTime().asSeconds(), stateCount, compileSecs);
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "bnScriptMetaType.h"
+#include "bnScriptHandle.h"
 #include "bnLogger.h"
 
 #include <SFML/Graphics.hpp>
@@ -8,13 +9,75 @@
 #include <vector>
 #include <iostream>
 #include <atomic>
+#include <cstdint>
 
 #define SOL_ALL_SAFETIES_ON 1
 #define SOL_USING_CXX_LUA 1
 #include "sol/sol.hpp"
 
+#define COMPILED_SCRIPT_EXTENSION ".luac"
+#define COMPILED_SCRIPT_DIRECTORY "cache/scripts"
+#define COMPILED_SCRIPT_KEY_BYTES 16
+
+class Character;
+class ChipAction;
+
+/*! \brief Loads scripted content into one lua state
+ *
+ * Compiling lua source is most of the cost of loading a script. The first time
+ * a script is compiled its bytecode (lua_dump) is written to cache/scripts as a
+ * .luac file named by a hash of the script path. Later boots load the bytecode
+ * with luaL_loadbufferx and skip the compiler. Nothing is written next to the
+ * scripts so read-only installs still work.
+ *
+ * The compiled file remembers the hash and size of the source and the lua version
+ * it was made by. If any of those differ the source is compiled again and the
+ * cache rewritten. Lua does not check bytecode before running it, so every file
+ * is also signed with a random key this install made the first time it wrote the
+ * cache. Files without a matching signature, e.g. ones shipped with a mod, are
+ * ignored and the source is compiled instead.
+ *
+ * Reading and compiling are done in parallel on the asset loader. Every worker
+ * compiles into its own bare lua_State, which also checks the source for syntax
+ * errors. Only the bytecode comes back to the main thread where it is loaded
+ * into the one shared state and run to register the script's table and type.
+ *
+ * Scripts never see engine pointers. Characters and chip actions are passed to
+ * lua as ScriptHandle userdata and every bound method resolves the handle on
+ * the C++ side first. Calling a method on a removed object raises a lua error.
+ *
+ * Behaviours run as ScriptCoroutine and report their time here. GetProfiles()
+ * lists how long each script has run so a slow mod can be found.
+ */
 class ScriptResourceManager {
 public:
+  /**
+   * @struct ChunkHeader
+   * @brief Start of every compiled script file. The lua_dump bytes follow.
+   */
+  struct ChunkHeader {
+    char magic[4]; /*!< "OBNL" */
+    std::uint32_t version;
+    std::uint32_t luaVersion; /*!< LUA_VERSION_NUM */
+    std::uint32_t numberSize; /*!< sizeof(lua_Number) */
+    std::uint64_t sourceHash; /*!< FNV-1a hash of the source */
+    std::uint64_t sourceSize;
+    std::uint64_t signature; /*!< Keyed hash of the file with this field zeroed. @see CacheKey() */
+  };
+
+  static const std::uint32_t CHUNK_VERSION = 2;
+
+  /**
+   * @struct ScriptProfile
+   * @brief Time spent running the behaviours of one script
+   */
+  struct ScriptProfile {
+    double seconds; /*!< Total */
+    double worstSeconds; /*!< Longest single frame */
+    unsigned long long resumes; /*!< Frames the script ran in */
+    unsigned long long preemptions; /*!< Frames the script ran out of budget */
+  };
+
   struct FileMeta {
     ScriptMetaType type;
     std::string path;
@@ -36,12 +99,126 @@ private:
   std::map<std::string, ScriptMetaType> nameToTypeHash; /*!< Script name to type hash */
   std::map<std::string, sol::table> scriptTableHash; /*!< Script name to sol table hash */
   sol::state luaState; 
+  bool isConfigured; /*!< True once the bindings are registered */
+  ScriptHandleTable<Character> characters; /*!< Characters scripts can reach */
+  ScriptHandleTable<ChipAction> chipActions; /*!< Chip actions scripts can reach */
+  std::map<std::string, ScriptProfile> profiles; /*!< Script name to time spent in its behaviours */
+
+  /**
+   * @struct Compiled
+   * @brief Result of compiling one script on a worker
+   */
+  struct Compiled {
+    std::string bytecode; /*!< lua_dump of the chunk. Empty if it did not compile. */
+    bool cached; /*!< True if it came from the .luac file */
+    float readSecs;
+    float compileSecs;
+  };
 
   void ConfigureEnvironment(); 
 
+  /**
+   * @brief Read and compile a script into bytecode
+   * @param L a worker's lua state. Left as it was found.
+   * @param meta script to compile
+   * @return Compiled
+   *
+   * Safe to call from any thread as long as each thread uses its own state
+   */
+  static Compiled Compile(lua_State* L, const FileMeta& meta);
+
+  /**
+   * @brief Push a compiled chunk onto the lua stack, from the cache if it is up to date
+   * @param L state to compile in
+   * @param source lua source text
+   * @param chunkName name used in lua error messages e.g. "@path/to/script.lua"
+   * @param cachePath where the compiled chunk is read from and written to. Empty to always compile.
+   * @param cached set to true if the chunk came from the cache
+   * @return false if the source does not compile. The error is logged and nothing is pushed.
+   */
+  static bool LoadChunk(lua_State* L, const std::string& source, const std::string& chunkName, const std::string& cachePath, bool& cached);
+
+  /**
+   * @brief Path of the compiled file for a script
+   * @param path path to the .lua file
+   * @return file in the compiled script directory named by a hash of the path
+   */
+  static std::string CachePath(const std::string& path);
+
+  /**
+   * @brief Key compiled files are signed with
+   * @return COMPILED_SCRIPT_KEY_BYTES random bytes
+   *
+   * Read from the compiled script directory. Made and saved there the first time.
+   */
+  static const std::string& CacheKey();
+
 public:
   void AddToPaths(FileMeta pathInfo);
 
+  /**
+   * @brief Make a character reachable from scripts
+   * @param character
+   * @return handle to pass to lua. Remove it before the character is deleted.
+   */
+  ScriptHandle<Character> CreateHandle(Character* character);
+
+  /**
+   * @brief Make a chip action reachable from scripts
+   * @param action
+   * @return handle to pass to lua. Remove it before the action is deleted.
+   */
+  ScriptHandle<ChipAction> CreateHandle(ChipAction* action);
+
+  /**
+   * @brief Stop scripts from reaching a character. O(1).
+   * @param handle
+   */
+  void RemoveHandle(ScriptHandle<Character> handle);
+
+  /**
+   * @brief Stop scripts from reaching a chip action. O(1).
+   * @param handle
+   */
+  void RemoveHandle(ScriptHandle<ChipAction> handle);
+
+  /**
+   * @brief Get the character for a handle
+   * @param handle
+   * @return character or nullptr if it was removed
+   */
+  Character* Resolve(ScriptHandle<Character> handle) const;
+
+  /**
+   * @brief Get the chip action for a handle
+   * @param handle
+   * @return chip action or nullptr if it was removed
+   */
+  ChipAction* Resolve(ScriptHandle<ChipAction> handle) const;
+
+  /**
+   * @brief Add the time a behaviour ran for this frame
+   * @param script name of the script the behaviour came from
+   * @param seconds
+   * @param preempted true if it ran out of budget
+   *
+   * The first time a script runs out of budget a warning is logged
+   */
+  void Profile(const std::string& script, double seconds, bool preempted);
+
+  /**
+   * @brief Get the time spent in every script's behaviours
+   * @return script name to profile
+   */
+  const std::map<std::string, ScriptProfile>& GetProfiles() const;
+
+  /**
+   * @brief Log every profile, slowest script first
+   */
+  void LogProfiles() const;
+
+  ScriptResourceManager();
+
   static ScriptResourceManager& GetInstance() {
     static ScriptResourceManager* instance = new ScriptResourceManager();
 
@@ -50,7 +227,10 @@ public:
 
   /**
  * @brief Loads all scripts
- * @param status Increases the count after each shader loads
+ * @param status Increases the count after each script loads
+ *
+ * Scripts are compiled in parallel first and then run one after another in the shared state.
+ * Logs how long each script took to read, compile or load from the cache, and run
  */
   void LoadAllSCripts(std::atomic<int> &status);
 };
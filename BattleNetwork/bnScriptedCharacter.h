@@ -1,11 +1,46 @@
 #pragma once
 #include "bnCharacter.h"
 #include "bnScriptResourceManager.h"
+#include "bnScriptCoroutine.h"
 
 class ScriptedCharacter : public Character {
+  ScriptHandle<Character> handle; /*!< How scripts refer to this character */
+  ScriptCoroutine behaviour; /*!< Lua function that drives this character a little every frame */
+
 public:
   ScriptedCharacter(ScriptedCharacter::Rank rank) : Character(rank) {
+    handle = SCRIPTS.CreateHandle(this);
+  }
+
+  ~ScriptedCharacter() {
+    SCRIPTS.RemoveHandle(handle);
+  }
+
+  /**
+   * @brief Get the handle scripts use for this character
+   * @return handle. Stops resolving once the character is deleted.
+   */
+  const ScriptHandle<Character> GetHandle() const {
+    return handle;
+  }
+
+  /**
+   * @brief Drive this character with a lua function. Replaces the current behaviour.
+   * @param function called with this character's handle as a coroutine
+   */
+  void Run(sol::function function) {
+    lua_State* L = function.lua_state();
+    function.push();
+    sol::stack::push(L, handle);
+    behaviour.Start(L, 1);
+  }
 
+  /**
+   * @brief Wake the behaviour if it is waiting for an event
+   * @param event
+   */
+  void Signal(const std::string& event) {
+    behaviour.Signal(event);
   }
 
   const bool OnHit(const Hit::Properties props) final {
@@ -19,10 +54,13 @@ public:
   }
 
   void OnDelete() final {
-
+    // Scripts cannot reach a character that is being removed from the field
+    SCRIPTS.RemoveHandle(handle);
+    behaviour.Stop();
   }
 
   void OnUpdate(float elapsed) final {
-
+    // Runs until the script yields or uses up its budget for this frame
+    behaviour.Update();
   }
 };
\ No newline at end of file
@@ -1,24 +1,52 @@
 #pragma once
 #include "bnChipAction.h"
 #include "bnAnimation.h"
+#include "bnScriptResourceManager.h"
+#include "bnScriptCoroutine.h"
 #include <SFML/Graphics.hpp>
 
 class SpriteSceneNode;
 class Character;
 class ScriptedChipAction : public ChipAction {
+  ScriptHandle<ChipAction> handle; /*!< How scripts refer to this action */
+  ScriptCoroutine behaviour; /*!< Lua function that drives this action a little every frame */
+
 public:
   ScriptedChipAction(Character * owner, int damage) : ChipAction(owner, "PLAYER_IDLE", nullptr, "Buster") {
+    handle = SCRIPTS.CreateHandle(this);
     // SCRIPTS.callback(chip_name).onCreate(this);
   }
 
   ~ScriptedChipAction()
   {
+    SCRIPTS.RemoveHandle(handle);
+  }
+
+  /**
+   * @brief Get the handle scripts use for this action
+   * @return handle. Stops resolving once the action is deleted.
+   */
+  const ScriptHandle<ChipAction> GetHandle() const {
+    return handle;
+  }
+
+  /**
+   * @brief Drive this action with a lua function. Replaces the current behaviour.
+   * @param function called with this action's handle as a coroutine
+   */
+  void Run(sol::function function) {
+    lua_State* L = function.lua_state();
+    function.push();
+    sol::stack::push(L, handle);
+    behaviour.Start(L, 1);
   }
 
   void OnUpdate(float _elapsed)
   {
     ChipAction::OnUpdate(_elapsed);
 
+    behaviour.Update();
+
     // SCRIPTS.callback(chip_name).onUpdate(this);
   }
 
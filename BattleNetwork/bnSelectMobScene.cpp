@@ -17,7 +17,7 @@ SelectMobScene::SelectMobScene(swoosh::ActivityController& controller, SelectedN
   menuLabel->setCharacterSize(15);
   menuLabel->setPosition(sf::Vector2f(20.f, 5.0f));
 
-  navigator = sf::Sprite(LOAD_TEXTURE(MUG_NAVIGATOR));
+  navigator = sf::Sprite(HOLD_TEXTURE(textures, MUG_NAVIGATOR));
   navigator.setScale(2.0f, 2.0f);
   navigator.setPosition(10.0f, 208.0f);
 
@@ -28,7 +28,7 @@ SelectMobScene::SelectMobScene(swoosh::ActivityController& controller, SelectedN
 
   mobSpr = sf::Sprite();
 
-  cursor = sf::Sprite(LOAD_TEXTURE(FOLDER_CURSOR));
+  cursor = sf::Sprite(HOLD_TEXTURE(textures, FOLDER_CURSOR));
   cursor.setScale(2.f, 2.f);
 
   // Selection input delays
@@ -53,7 +53,7 @@ SelectMobScene::SelectMobScene(swoosh::ActivityController& controller, SelectedN
   numberCooldown = maxNumberCooldown; // half a second
 
   // select menu graphic
-  bg = sf::Sprite(LOAD_TEXTURE(BATTLE_SELECT_BG));
+  bg = sf::Sprite(HOLD_TEXTURE(textures, BATTLE_SELECT_BG));
   bg.setScale(2.f, 2.f);
 
   gotoNextScene = true; 
@@ -263,6 +263,9 @@ void SelectMobScene::onUpdate(double elapsed) {
     doOnce = false;
     factor = 125;
 
+    // Load the enemies in the background so the battle starts without a stall
+    MOBS.Prefetch(mobSelectionIndex);
+
     // Current mob graphic
     mobSpr = sf::Sprite(*mobinfo.GetPlaceholderTexture());
     mobSpr.setScale(2.f, 2.f);
@@ -464,11 +467,7 @@ void SelectMobScene::onDraw(sf::RenderTexture & surface) {
   if (mobSpr.getTexture()) {
     sf::IntRect t = mobSpr.getTextureRect();
     sf::Vector2u size = mobSpr.getTexture()->getSize();
-    shader.SetUniform("x", (float)t.left / (float)size.x);
-    shader.SetUniform("y", (float)t.top / (float)size.y);
-    shader.SetUniform("w", (float)t.width / (float)size.x);
-    shader.SetUniform("h", (float)t.height / (float)size.y);
-    shader.SetUniform("pixel_threshold", (float)(factor / 400.f));
+    PixelateUniforms::Set(shader, t, size, (float)(factor / 400.f));
 
     // Refresh mob graphic origin every frame as it may change
     mobSpr.setOrigin(mobSpr.getTextureRect().width / 2.f, mobSpr.getTextureRect().height / 2.f);
@@ -95,6 +95,7 @@ private:
   sf::Sprite cursor; /*!< LEFT / RIGHT cursors */
 
   sf::Sprite navigator; /*!< Mugshot spritesheet */
+  std::vector<TextureHandle> textures; /*!< Keeps the sprite textures loaded while the scene is alive */
   
   Animation navigatorAnimator; /*!< Animators mugshot */
 
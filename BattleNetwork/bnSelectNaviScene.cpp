@@ -58,29 +58,29 @@ SelectNaviScene::SelectNaviScene(swoosh::ActivityController& controller, Selecte
   UI_LEFT_POS = UI_LEFT_POS_START;
   UI_TOP_POS = UI_TOP_POS_START;
 
-  charName = sf::Sprite(LOAD_TEXTURE(CHAR_NAME));
+  charName = sf::Sprite(HOLD_TEXTURE(textures, CHAR_NAME));
   charName.setScale(2.f, 2.f);
   charName.setPosition(UI_LEFT_POS, 10);
 
-  charElement = sf::Sprite(LOAD_TEXTURE(CHAR_ELEMENT));
+  charElement = sf::Sprite(HOLD_TEXTURE(textures, CHAR_ELEMENT));
   charElement.setScale(2.f, 2.f);
   charElement.setPosition(UI_LEFT_POS, 80);
 
-  charStat = sf::Sprite(LOAD_TEXTURE(CHAR_STAT));
+  charStat = sf::Sprite(HOLD_TEXTURE(textures, CHAR_STAT));
   charStat.setScale(2.f, 2.f);
   charStat.setPosition(UI_RIGHT_POS, UI_TOP_POS);
 
-  charInfo = sf::Sprite(LOAD_TEXTURE(CHAR_INFO_BOX));
+  charInfo = sf::Sprite(HOLD_TEXTURE(textures, CHAR_INFO_BOX));
   charInfo.setScale(2.f, 2.f);
   charInfo.setPosition(UI_RIGHT_POS, 170);
 
-  element = sf::Sprite(*TEXTURES.GetTexture(TextureType::ELEMENT_ICON));
+  element = sf::Sprite(HOLD_TEXTURE(textures, ELEMENT_ICON));
   element.setScale(2.f, 2.f);
   element.setPosition(UI_LEFT_POS_MAX + 15.f, 90);
 
   // Current navi graphic
   loadNavi = false;
-  navi = sf::Sprite(LOAD_TEXTURE(NAVI_MEGAMAN_ATLAS));
+  navi = sf::Sprite(HOLD_TEXTURE(textures, NAVI_MEGAMAN_ATLAS));
   navi.setScale(2.f, 2.f);
   navi.setOrigin(navi.getLocalBounds().width / 2.f, navi.getLocalBounds().height / 2.f);
   navi.setPosition(100.f, 150.f);
@@ -109,15 +109,15 @@ SelectNaviScene::SelectNaviScene(swoosh::ActivityController& controller, Selecte
   glowpadAnimator.SetAnimation("GLOW");
   glowpadAnimator << Animator::Mode::Loop;
 
-  glowpad = sf::Sprite(LOAD_TEXTURE(GLOWING_PAD_ATLAS));
+  glowpad = sf::Sprite(HOLD_TEXTURE(textures, GLOWING_PAD_ATLAS));
   glowpad.setScale(2.f, 2.f);
   glowpad.setPosition(37, 135);
 
-  glowbase = sf::Sprite(LOAD_TEXTURE(GLOWING_PAD_BASE));
+  glowbase = sf::Sprite(HOLD_TEXTURE(textures, GLOWING_PAD_BASE));
   glowbase.setScale(2.f, 2.f);
   glowbase.setPosition(40, 200);
 
-  glowbottom = sf::Sprite(LOAD_TEXTURE(GLOWING_PAD_BOTTOM));
+  glowbottom = sf::Sprite(HOLD_TEXTURE(textures, GLOWING_PAD_BOTTOM));
   glowbottom.setScale(2.f, 2.f);
   glowbottom.setPosition(40, 200);
 
@@ -334,6 +334,9 @@ void SelectNaviScene::onUpdate(double elapsed) {
   if (naviSelectionIndex != prevSelect || !loadNavi) {
     factor = 125;
 
+    // Load what the navi draws in battle in the background
+    NAVIS.Prefetch(naviSelectionIndex);
+
     naviAnimator = Animation(NAVIS.At(naviSelectionIndex).GetBattleAnimationPath());
     naviAnimator.Reload();
     naviAnimator.SetAnimation("PLAYER_IDLE");
@@ -408,11 +411,7 @@ void SelectNaviScene::onUpdate(double elapsed) {
 
   sf::IntRect t = navi.getTextureRect();
   sf::Vector2u size = navi.getTexture()->getSize();
-  pixelated.SetUniform("x", (float)t.left / (float)size.x);
-  pixelated.SetUniform("y", (float)t.top / (float)size.y);
-  pixelated.SetUniform("w", (float)t.width / (float)size.x);
-  pixelated.SetUniform("h", (float)t.height / (float)size.y);
-  pixelated.SetUniform("pixel_threshold", (float)(factor / 400.f));
+  PixelateUniforms::Set(pixelated, t, size, (float)(factor / 400.f));
 
   // Refresh mob graphic origin every frame as it may change
   float xpos = ((glowbase.getTextureRect().width / 2.0f)*glowbase.getScale().x) + glowbase.getPosition().x;
@@ -93,6 +93,7 @@ private:
   sf::Sprite glowpad; /*!< Glow pad ring piece */
   sf::Sprite glowbase; /*!< G;ow pad base */
   sf::Sprite glowbottom; /*!< Glow pad bottom piece */
+  std::vector<TextureHandle> textures; /*!< Keeps the sprite textures loaded while the scene is alive */
 
   TextBox textbox; /*!< Displays extra navi info. Use UP/DOWN to read more */
 
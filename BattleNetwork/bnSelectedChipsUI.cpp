@@ -14,10 +14,12 @@ SelectedChipsUI::SelectedChipsUI(Player* _player) : ChipUsePublisher(), UICompon
   , player(_player) {
   player->RegisterComponent(this);
   chipCount = curr = 0;
-  icon = sf::Sprite(*TEXTURES.GetTexture(CHIP_ICONS));
+  iconTexture = TEXTURES.LoadTexture(CHIP_ICONS);
+  icon = sf::Sprite(*iconTexture);
   icon.setScale(sf::Vector2f(2.f, 2.f));
 
-  frame = sf::Sprite(*TEXTURES.GetTexture(CHIP_FRAME));
+  frameTexture = TEXTURES.LoadTexture(CHIP_FRAME);
+  frame = sf::Sprite(*frameTexture);
   frame.setScale(sf::Vector2f(2.f, 2.f));
 
   font = TEXTURES.LoadFontFromFile("resources/fonts/mmbnthick_regular.ttf");
@@ -74,4 +74,5 @@ private:
   mutable Text text; /*!< Text displays chip name */
   mutable Text dmg; /*!< Text displays chip damage */
   mutable sf::Sprite icon, frame; /*!< Sprite for the chip icon and the black border */
+  TextureHandle iconTexture, frameTexture; /*!< Keeps the icon and border textures loaded */
 };
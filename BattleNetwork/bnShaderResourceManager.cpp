@@ -1,5 +1,7 @@
 #include "bnShaderResourceManager.h"
 #include "bnShaderType.h"
+#include "bnFileUtil.h"
+#include "bnSmartShader.h"
 #include <stdlib.h>
 #include <sstream>
 using std::stringstream;
@@ -12,69 +14,208 @@ ShaderResourceManager& ShaderResourceManager::GetInstance() {
 }
 
 void ShaderResourceManager::LoadAllShaders(std::atomic<int> &status) {
-    ShaderType shaderType = static_cast<ShaderType>(0);
-    while (shaderType != ShaderType::SHADER_TYPE_SIZE)
+#ifdef __ANDROID__
+    // The loading screen draws with the default shader and so does everything else until its own shader is ready
+    Build(ShaderType::DEFAULT);
+#endif
+
+    // Everything else compiles the first time it is used
+    status += static_cast<int>(ShaderType::SHADER_TYPE_SIZE);
+}
+
+bool ShaderResourceManager::Build(ShaderType _stype) {
     {
-        status++;
-
-        // TODO: Catch failed resources and try again
-        sf::Shader* shader = LoadShaderFromFile(paths[static_cast<int>(shaderType)]);
-        if (shader)
-        {
-            shaders.insert(pair<ShaderType, sf::Shader*>(shaderType, shader));
-        }
-        shaderType = (ShaderType)(static_cast<int>(shaderType) + 1);
+      std::lock_guard<std::mutex> lock(queueMutex);
+      requested[static_cast<int>(_stype)] = true;
+    }
+
+    sf::Shader* shader = shaders.at(_stype);
+    if (shader->getNativeHandle()) return true;
+
+    const string& path = paths[static_cast<int>(_stype)];
+
+    sf::Clock clock;
+
+    if (!Compile(*shader, path)) {
+      LOG_ERROR(CONTENT, "Error loading shader: %s", path.c_str());
+
+      return false;
     }
 
+    // Values sent while the shader was not compiled went nowhere
+    Replay(shader);
+    SmartShader::Invalidate(shader);
+
+    LOG_DEBUG(CONTENT, "Loaded shader: %s (%f secs)", path.c_str(), clock.getElapsedTime().asSeconds());
+
+    return true;
 }
 
-sf::Shader* ShaderResourceManager::LoadShaderFromFile(string _path)
+void ShaderResourceManager::Prefetch(const std::vector<ShaderType>& _stypes) {
+    for (auto type : _stypes) {
+      Build(type);
+    }
+}
+
+const unsigned ShaderResourceManager::Update(sf::Time budget) {
+    sf::Clock clock;
+    unsigned count = 0;
+
+    while (count == 0 || clock.getElapsedTime() < budget) {
+      ShaderType type;
+
+      {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (queue.empty()) break;
+
+        type = queue.front();
+        queue.erase(queue.begin());
+      }
+
+      Build(type);
+      count++;
+    }
+
+    return count;
+}
+
+const sf::Shader* ShaderResourceManager::Resolve(const sf::Shader* shader) {
+    if (!shader || shader->getNativeHandle()) return shader;
+
+#ifdef __ANDROID__
+    return SHADERS.GetShader(ShaderType::DEFAULT);
+#else
+    // The fixed pipeline is the default on desktop
+    return nullptr;
+#endif
+}
+
+bool ShaderResourceManager::Compile(sf::Shader& shader, const string& _path)
 {
 #ifdef __ANDROID__
-    sf::Shader* shader = new sf::Shader();
-    bool result = false;
+    // Read through FileUtil so packed shaders are found too
+    std::string frag = FileUtil::Read(_path + ".frag");
+    std::string vert = FileUtil::Read(_path + ".vert");
 
-    if(shader->loadFromFile(_path + ".vert", _path + ".frag"))
+    if(!vert.empty() && shader.loadFromMemory(vert, frag))
     {
-        result = true;
-    }
-    else // default vert shader
-    {
-        result = shader->loadFromFile(paths[static_cast<int>(ShaderType::DEFAULT)] + ".vert", _path + ".frag");
+        return true;
     }
 
-    if (!result)
-    {
-        Logger::GetMutex()->lock();
-        Logger::Log("Error loading shader: " + _path);
-        Logger::GetMutex()->unlock();
+    // default vert shader
+    vert = FileUtil::Read(paths[static_cast<int>(ShaderType::DEFAULT)] + ".vert");
+    return shader.loadFromMemory(vert, frag);
+#else
+    ArchiveView packed;
 
-        return nullptr;
-    }
-#else 
+    return FileUtil::IsPacked(_path + ".frag", packed)
+      ? shader.loadFromMemory(std::string(packed.data, packed.size), sf::Shader::Fragment)
+      : shader.loadFromFile(_path + ".frag", sf::Shader::Fragment);
+#endif
+}
+
+sf::Shader* ShaderResourceManager::LoadShaderFromFile(string _path)
+{
     sf::Shader* shader = new sf::Shader();
-    if (!shader->loadFromFile(_path + ".frag", sf::Shader::Fragment)) {
 
-      Logger::GetMutex()->lock();
-      Logger::Log("Error loading shader: " + _path + ".frag");
-      Logger::GetMutex()->unlock();
+    if (!Compile(*shader, _path)) {
+
+      LOG_ERROR(CONTENT, "Error loading shader: %s", _path.c_str());
 
+      delete shader;
+
+#ifndef __ANDROID__
       exit(EXIT_FAILURE);
+#endif
       return nullptr;
     }
-#endif
 
     //shader->setUniform("texture", sf::Shader::CurrentTexture);
 
-    Logger::GetMutex()->lock();
-    Logger::Log("Loaded shader: " + _path);
-    Logger::GetMutex()->unlock();
+    LOG_DEBUG(CONTENT, "Loaded shader: %s", _path.c_str());
 
     return shader;
 }
 
+bool ShaderResourceManager::Reload(const string& _path)
+{
+    // Accept the .frag or .vert file that changed as well as the path without an extension
+    string base = _path;
+    std::size_t dot = base.find_last_of('.');
+
+    if (dot != string::npos && base.find('/', dot) == string::npos) {
+      base = base.substr(0, dot);
+    }
+
+    for (auto& pair : shaders) {
+      if (paths[static_cast<int>(pair.first)] != base) continue;
+
+      // Not used yet. It will compile from the new source when it is.
+      if (!pair.second->getNativeHandle()) return false;
+
+      // sf::Shader throws away its old program before compiling so check the source first.
+      // A typo while editing should not take the shader away.
+      sf::Shader test;
+
+      if (!Compile(test, base)) {
+        LOG_ERROR(CONTENT, "Error reloading shader: %s", base.c_str());
+        return false;
+      }
+
+      Compile(*pair.second, base);
+
+      // The new program starts with no uniform values
+      Replay(pair.second);
+      SmartShader::Invalidate(pair.second);
+
+      LOG_INFO(CONTENT, "Reloaded shader: %s", base.c_str());
+      return true;
+    }
+
+    return false;
+}
+
+void ShaderResourceManager::SetUniform(sf::Shader* shader, const string& name, const std::shared_ptr<sf::Texture>& texture) {
+  // Hold the texture so a replay never points at a texture that was evicted
+  Persist(shader, name, [texture](sf::Shader& target, const string& name) { target.setUniform(name, *texture); });
+}
+
+void ShaderResourceManager::Persist(sf::Shader* shader, const string& name, UniformSetter setter) {
+  std::lock_guard<std::mutex> lock(uniformMutex);
+
+  UniformSetter& stored = uniforms[shader][name];
+  stored = std::move(setter);
+
+  if (shader->getNativeHandle()) {
+    stored(*shader, name);
+    SmartShader::Invalidate(shader);
+  }
+}
+
+void ShaderResourceManager::Replay(sf::Shader* shader) {
+  std::lock_guard<std::mutex> lock(uniformMutex);
+
+  auto iter = uniforms.find(shader);
+  if (iter == uniforms.end()) return;
+
+  for (auto& uniform : iter->second) {
+    uniform.second(*shader, uniform.first);
+  }
+}
+
 sf::Shader* ShaderResourceManager::GetShader(ShaderType _stype) {
-  return shaders.at(_stype);
+  sf::Shader* shader = shaders.at(_stype);
+
+  if (!shader->getNativeHandle()) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+
+    if (!requested[static_cast<int>(_stype)]) {
+      requested[static_cast<int>(_stype)] = true;
+      queue.push_back(_stype);
+    }
+  }
+
+  return shader;
 }
 
 ShaderResourceManager::ShaderResourceManager(void) {
@@ -109,6 +250,13 @@ ShaderResourceManager::ShaderResourceManager(void) {
     paths[(int)ShaderType::COLORIZE] = std::string() + "resources/shaders/" + version + "/colorize";
     paths[(int)ShaderType::ADDITIVE] = std::string() + "resources/shaders/" + version + "/additive";
     paths[(int)ShaderType::PALETTE_SWAP] = std::string() + "resources/shaders/" + version + "/palette_swap";
+
+    requested.resize((size_t)ShaderType::SHADER_TYPE_SIZE, false);
+
+    // Objects exist up front so their pointers can be handed out before they compile
+    for (int i = 0; i < (int)ShaderType::SHADER_TYPE_SIZE; i++) {
+      shaders.insert(pair<ShaderType, sf::Shader*>((ShaderType)i, new sf::Shader()));
+    }
 }
 
 ShaderResourceManager::~ShaderResourceManager(void) {
@@ -16,6 +16,9 @@
 #include <vector>
 #include <iostream>
 #include <atomic>
+#include <mutex>
+#include <functional>
+#include <memory>
 
 using std::cerr;
 using std::endl;
@@ -33,8 +36,13 @@ public:
   static ShaderResourceManager& GetInstance();
   
   /**
-   * @brief Loads all hard-coded shaders
-   * @param status Increases the count after each shader loads
+   * @brief Registers all hard-coded shaders
+   * @param status Increases the count for each shader
+   *
+   * Only the default shader is compiled right away. The rest compile the first
+   * time they are asked for. Until then draws with them fall back to the default shader.
+   * @see GetShader()
+   * @see Update()
    */
   void LoadAllShaders (std::atomic<int> &status);
   
@@ -46,18 +54,111 @@ public:
   sf::Shader* LoadShaderFromFile(string _path);
   
   /**
-   * @brief Returns pointer to the pre-loaded shader type
+   * @brief Returns pointer to the shader type. Queues it to compile if this is the first use.
    * @param _ttype shader type to fetch from cache
-   * @return Shader pointer. 
+   * @return Shader pointer. The pointer never changes so it is safe to keep.
    * @warning Do not delete! This resource is managed by the manager.
+   *
+   * Safe to call from any thread
    */
   sf::Shader* GetShader(ShaderType _ttype);
 
+  /**
+   * @brief Compiles a list of shaders now
+   * @param _stypes shaders a scene will draw with
+   *
+   * Call while the scene is being set up so its first frames do not fall back
+   */
+  void Prefetch(const std::vector<ShaderType>& _stypes);
+
+  /**
+   * @brief Set a uniform that must survive the shader compiling or reloading
+   * @param shader shader from GetShader()
+   * @param name uniform name
+   * @param value
+   *
+   * sf::Shader drops values sent before it is compiled. Use this for values set once
+   * when an object is made. The value is sent now if the shader is compiled and again
+   * every time it is built or reloaded. Setting the same name replaces the old value.
+   */
+  template<typename T>
+  void SetUniform(sf::Shader* shader, const string& name, const T& value) {
+    Persist(shader, name, [value](sf::Shader& target, const string& name) { target.setUniform(name, value); });
+  }
+
+  /**
+   * @brief Set a texture uniform that must survive the shader compiling or reloading
+   * @param shader shader from GetShader()
+   * @param name uniform name
+   * @param texture kept loaded until the uniform is set again
+   */
+  void SetUniform(sf::Shader* shader, const string& name, const std::shared_ptr<sf::Texture>& texture);
+
+  /**
+   * @brief Compiles queued shaders. Call once per frame from the main thread.
+   * @param budget stop after this much time has passed. At least one shader always compiles.
+   * @return number of shaders compiled
+   */
+  const unsigned Update(sf::Time budget);
+
+  /**
+   * @brief Get the shader to actually draw with
+   * @param shader shader the drawable asked for
+   * @return shader if it is compiled, otherwise the default shader
+   */
+  static const sf::Shader* Resolve(const sf::Shader* shader);
+
+  /**
+   * @brief Compile a loaded shader again from its source file
+   * @param _path path of the changed .frag or .vert file
+   * @return true if the shader was recompiled. Shaders that fail to compile are left as they were.
+   *
+   * The same sf::Shader object is kept so everything drawing with it picks up the change.
+   * Must be called from the main thread.
+   */
+  bool Reload(const string& _path);
+
 private:
   ShaderResourceManager();
   ~ShaderResourceManager();
   vector<string> paths;  /*!< Paths to all shaders. Must be in order of ShaderType @see ShaderType */
-  map<ShaderType, sf::Shader*> shaders; /*!< cache */
+  map<ShaderType, sf::Shader*> shaders; /*!< cache. Every type has a shader object from the start. */
+  vector<ShaderType> queue; /*!< Shaders asked for that have not compiled yet */
+  vector<bool> requested; /*!< Shader types that were queued or compiled. Failed shaders are not tried again. */
+  std::mutex queueMutex; /*!< Guards queue and requested */
+
+  typedef std::function<void(sf::Shader&, const string&)> UniformSetter;
+  map<sf::Shader*, map<string, UniformSetter>> uniforms; /*!< Values set with SetUniform() by shader and name */
+  std::mutex uniformMutex; /*!< Guards uniforms */
+
+  /**
+   * @brief Record a uniform and send it if the shader is compiled
+   * @param shader
+   * @param name
+   * @param setter sends the value to a shader
+   */
+  void Persist(sf::Shader* shader, const string& name, UniformSetter setter);
+
+  /**
+   * @brief Send every recorded uniform to a freshly compiled shader
+   * @param shader
+   */
+  void Replay(sf::Shader* shader);
+
+  /**
+   * @brief Compile a queued shader into its shader object. Main thread only.
+   * @param _stype
+   * @return true if the shader compiled
+   */
+  bool Build(ShaderType _stype);
+
+  /**
+   * @brief Compile the shader source at a path into a shader object
+   * @param shader shader object to compile into
+   * @param _path path without the .frag or .vert extension
+   * @return true if the shader compiled
+   */
+  bool Compile(sf::Shader& shader, const string& _path);
 };
 
 /*! \brief Shorthand to get instance of the manager */
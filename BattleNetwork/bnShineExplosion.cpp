@@ -11,7 +11,7 @@ ShineExplosion::ShineExplosion(Field* _field, Team _team) : Artifact(_field)
   SetLayer(0);
   field = _field;
   team = _team;
-  setTexture(LOAD_TEXTURE(MOB_BOSS_SHINE));
+  setTexture(TEXTURES.LoadTexture(TextureType::MOB_BOSS_SHINE));
   setScale(2.f, 2.f);
 
   animationComponent = new AnimationComponent(this);
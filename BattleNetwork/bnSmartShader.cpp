@@ -1,19 +1,48 @@
 #include "bnSmartShader.h"
 
+  std::vector<std::string> SmartShader::uniformNames;
+  std::unordered_map<std::string, SmartShader::Uniform> SmartShader::uniformHandles;
+  std::unordered_map<sf::Shader*, std::vector<SmartShader::UniformValue>> SmartShader::uploaded;
+
+  const bool SmartShader::UniformValue::operator==(const UniformValue& rhs) const {
+    if (handle != rhs.handle || type != rhs.type) return false;
+
+    switch (type) {
+    case UniformType::integer:
+      return ivalue == rhs.ivalue;
+    case UniformType::floating:
+      return fvalue == rhs.fvalue;
+    case UniformType::vector2f:
+      return vfvalue.x == rhs.vfvalue.x && vfvalue.y == rhs.vfvalue.y;
+    }
+
+    return false;
+  }
+
+  const bool SmartShader::UniformValue::IsZero() const {
+    switch (type) {
+    case UniformType::integer:
+      return ivalue == 0;
+    case UniformType::floating:
+      return fvalue == 0.f;
+    case UniformType::vector2f:
+      return vfvalue.x == 0.f && vfvalue.y == 0.f;
+    }
+
+    return true;
+  }
+
   SmartShader::SmartShader() {
     ref = nullptr;
   }
 
   SmartShader::SmartShader(const SmartShader& copy) {
-    funiforms = copy.funiforms;
-    iuniforms = copy.iuniforms;
-    vfuniforms = copy.vfuniforms;
+    uniforms = copy.uniforms;
     ref = copy.ref;
   }
 
   SmartShader::~SmartShader() {
-    iuniforms.clear();
-    funiforms.clear();
+    uniforms.clear();
     ref = nullptr;
   }
 
@@ -21,6 +50,12 @@
     ref = &const_cast<sf::Shader&>(rhs);
   }
 
+ SmartShader& SmartShader::operator=(const SmartShader& rhs) {
+   uniforms = rhs.uniforms;
+   ref = rhs.ref;
+   return *this;
+ }
+
  SmartShader& SmartShader::operator=(const sf::Shader& rhs) {
    ref = &const_cast<sf::Shader&>(rhs);
    return *this;
@@ -35,63 +70,165 @@
    return ref;
  }
 
-  void SmartShader::ApplyUniforms() {
-    iiter iIter = iuniforms.begin();
-    fiter fIter = funiforms.begin();
-    vfiter vfIter = vfuniforms.begin();
+  SmartShader::Uniform SmartShader::GetUniformHandle(const std::string& uniform) {
+    auto iter = uniformHandles.find(uniform);
 
-    for (; iIter != iuniforms.end(); iIter++) {
-      ref->setUniform(iIter->first, iIter->second);
+    if (iter != uniformHandles.end()) {
+      return iter->second;
     }
 
-    for (; fIter != funiforms.end(); fIter++) {
-      ref->setUniform(fIter->first, fIter->second);
+    Uniform handle = (Uniform)uniformNames.size();
+    uniformNames.push_back(uniform);
+    uniformHandles.insert(std::make_pair(uniform, handle));
+
+    return handle;
+  }
+
+  SmartShader::UniformValue* SmartShader::Find(std::vector<UniformValue>& list, Uniform handle) {
+    for (auto& value : list) {
+      if (value.handle == handle) return &value;
     }
 
-    for (; vfIter != vfuniforms.end(); vfIter++) {
-      ref->setUniform(vfIter->first, vfIter->second);
+    return nullptr;
+  }
+
+  void SmartShader::Upload(sf::Shader* shader, const UniformValue& value) {
+    const std::string& name = uniformNames[value.handle];
+
+    switch (value.type) {
+    case UniformType::integer:
+      shader->setUniform(name, value.ivalue);
+      break;
+    case UniformType::floating:
+      shader->setUniform(name, value.fvalue);
+      break;
+    case UniformType::vector2f:
+      shader->setUniform(name, value.vfvalue);
+      break;
     }
   }
 
-  void SmartShader::ResetUniforms() {
-    if (!ref) {
-      return;
+  void SmartShader::ApplyUniforms() {
+    if (!ref) return;
+
+    std::vector<UniformValue>& values = uploaded[ref];
+
+    // Values left over from the last draw that we don't use must not leak into this one
+    for (auto& value : values) {
+      if (!value.IsZero() && !Find(uniforms, value.handle)) {
+        value.ivalue = 0;
+        value.fvalue = 0.f;
+        value.vfvalue = sf::Vector2f();
+        Upload(ref, value);
+      }
     }
 
-    iiter iIter = iuniforms.begin();
-    fiter fIter = funiforms.begin();
-    vfiter vfIter = vfuniforms.begin();
+    // Only upload what changed
+    for (auto& value : uniforms) {
+      UniformValue* prev = Find(values, value.handle);
+
+      if (!prev) {
+        Upload(ref, value);
+        values.push_back(value);
+      }
+      else if (!(*prev == value)) {
+        Upload(ref, value);
+        *prev = value;
+      }
+    }
+  }
 
-    for (; iIter != iuniforms.end(); iIter++) {
-      ref->setUniform(iIter->first, 0);
+  void SmartShader::ResetUniforms() {
+    uniforms.clear();
+  }
+
+  void SmartShader::ReleaseUniforms() {
+    for (auto& pair : uploaded) {
+      for (auto& value : pair.second) {
+        if (value.IsZero()) continue;
+
+        value.ivalue = 0;
+        value.fvalue = 0.f;
+        value.vfvalue = sf::Vector2f();
+        Upload(pair.first, value);
+      }
     }
 
-    for (; fIter != funiforms.end(); fIter++) {
-      ref->setUniform(fIter->first, 0.f);
+    uploaded.clear();
+  }
+
+  void SmartShader::Invalidate(sf::Shader* shader) {
+    uploaded.erase(shader);
+  }
+
+  const bool SmartShader::HasUniforms() const {
+    return !uniforms.empty();
+  }
+
+  const bool SmartShader::HasSameUniforms(const SmartShader& other) const {
+    if (ref != other.ref || uniforms.size() != other.uniforms.size()) return false;
+
+    for (std::size_t i = 0; i < uniforms.size(); i++) {
+      if (!(uniforms[i] == other.uniforms[i])) return false;
     }
 
-    for (; vfIter != vfuniforms.end(); vfIter++) {
-      ref->setUniform(vfIter->first, 0.f);
+    return true;
+  }
+
+  void SmartShader::Store(const UniformValue& value) {
+    UniformValue* prev = Find(uniforms, value.handle);
+
+    if (prev) {
+      *prev = value;
+    }
+    else {
+      uniforms.push_back(value);
     }
+  }
+
+  void SmartShader::SetUniform(const std::string& uniform, float fvalue) {
+    SetUniform(GetUniformHandle(uniform), fvalue);
+  }
+
+  void SmartShader::SetUniform(Uniform uniform, float fvalue) {
+    UniformValue value{ uniform, UniformType::floating, 0, fvalue, sf::Vector2f() };
+    Store(value);
+  }
 
-    iuniforms.clear();
-    funiforms.clear();
-    vfuniforms.clear();
+  void SmartShader::SetUniform(const std::string& uniform, int ivalue) {
+    SetUniform(GetUniformHandle(uniform), ivalue);
   }
 
-  void SmartShader::SetUniform(std::string uniform, float fvalue) {
-    funiforms[uniform] = fvalue;
+  void SmartShader::SetUniform(Uniform uniform, int ivalue) {
+    UniformValue value{ uniform, UniformType::integer, ivalue, 0.f, sf::Vector2f() };
+    Store(value);
   }
 
-  void SmartShader::SetUniform(std::string uniform, int ivalue) {
-    iuniforms[uniform] = ivalue;
+  void SmartShader::SetUniform(const std::string& uniform, const sf::Vector2f& vfvalue) {
+    SetUniform(GetUniformHandle(uniform), vfvalue);
   }
 
-  void SmartShader::SetUniform(std::string uniform, const sf::Vector2f& vfvalue) {
-    vfuniforms[uniform] = vfvalue;
+  void SmartShader::SetUniform(Uniform uniform, const sf::Vector2f& vfvalue) {
+    UniformValue value{ uniform, UniformType::vector2f, 0, 0.f, vfvalue };
+    Store(value);
   }
 
   void SmartShader::Reset() {
     this->ResetUniforms();
     this->ref = nullptr;
   }
+
+  void PixelateUniforms::Set(SmartShader& shader, const sf::IntRect& rect, const sf::Vector2u& size, float threshold) {
+    // Resolve the uniform names once
+    static const SmartShader::Uniform x = SmartShader::GetUniformHandle("x");
+    static const SmartShader::Uniform y = SmartShader::GetUniformHandle("y");
+    static const SmartShader::Uniform w = SmartShader::GetUniformHandle("w");
+    static const SmartShader::Uniform h = SmartShader::GetUniformHandle("h");
+    static const SmartShader::Uniform pixelThreshold = SmartShader::GetUniformHandle("pixel_threshold");
+
+    shader.SetUniform(x, (float)rect.left / (float)size.x);
+    shader.SetUniform(y, (float)rect.top / (float)size.y);
+    shader.SetUniform(w, (float)rect.width / (float)size.x);
+    shader.SetUniform(h, (float)rect.height / (float)size.y);
+    shader.SetUniform(pixelThreshold, threshold);
+  }
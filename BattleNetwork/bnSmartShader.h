@@ -1,98 +1,201 @@
 /*! \brief A shader wrapper that intelligently applies itself during draw calls
- * 
- * Currently supports int, float, double, vector2f uniforms
- * 
+ *
+ * Currently supports int, float, vector2f uniforms
+ *
+ * Uniform names are resolved once to integer handles with GetUniformHandle().
+ * Values are stored in a flat list and only uploaded to the GPU when they differ
+ * from what the shader already has. Consecutive draws that share a shader
+ * only pay for the uniforms that changed between them.
+ *
+ * What each shader has is tracked separately. A draw that sets no uniforms
+ * still resets the values an earlier draw left on its shader. Code that calls
+ * sf::Shader::setUniform() directly must call Invalidate() afterwards.
+ *
  * Additional uniforms must be added
  */
 
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <map>
+#include <string>
+#include <vector>
+#include <unordered_map>
 
 class SmartShader
 {
   friend class Engine;
+  friend class SpriteBatch;
+  friend class ShaderResourceManager;
+public:
+  typedef int Uniform; /*!< Handle to a uniform name. @see GetUniformHandle() */
+
 private:
+  enum class UniformType : int {
+    integer = 0,
+    floating,
+    vector2f
+  };
+
+  /**
+   * @struct UniformValue
+   * @brief Tagged uniform value stored in flat arrays
+   */
+  struct UniformValue {
+    Uniform handle;
+    UniformType type;
+    int ivalue;
+    float fvalue;
+    sf::Vector2f vfvalue;
+
+    const bool operator==(const UniformValue& rhs) const;
+    const bool IsZero() const;
+  };
+
   sf::Shader* ref; /*!< Pointer to shader object */
-  std::map<std::string, int>    iuniforms; /*!< lookup of integer uniforms */
-  std::map<std::string, float>  funiforms; /*!< lookup of float uniforms */
-  std::map<std::string, double> duniforms; /*!< lookup of double uniforms */
-  std::map<std::string, sf::Vector2f> vfuniforms; /*!< lookup of vector2f uniforms */
+  std::vector<UniformValue> uniforms; /*!< Uniform values to apply on the next draw */
 
-  typedef std::map<std::string, int>::iterator iiter; 
-  typedef std::map<std::string, float>::iterator fiter;
-  typedef std::map<std::string, sf::Vector2f>::iterator vfiter;
+  static std::vector<std::string> uniformNames; /*!< Handle to uniform name */
+  static std::unordered_map<std::string, Uniform> uniformHandles; /*!< Uniform name to handle */
+  static std::unordered_map<sf::Shader*, std::vector<UniformValue>> uploaded; /*!< Values last sent to each shader */
+
+  /**
+   * @brief Find the value for a handle in a list
+   * @return pointer to the value or nullptr if the handle is not in the list
+   */
+  static UniformValue* Find(std::vector<UniformValue>& list, Uniform handle);
+
+  /**
+   * @brief Sends a value to the shader
+   */
+  static void Upload(sf::Shader* shader, const UniformValue& value);
 
   /**
-   * @brief Applies all registered uniform values before drawing
+   * @brief Stores the value in the uniform list
+   */
+  void Store(const UniformValue& value);
+
+  /**
+   * @brief Uploads uniform values that differ from the values the shader already has
+   *
+   * Uniforms the shader has from a previous draw that this object does not set are zeroed,
+   * so a shader with no uniforms set draws with the defaults
    */
   void ApplyUniforms();
-  
+
   /**
-   * @brief Clears the shader object of all uniform values
+   * @brief Clears the uniform values after the draw
+   *
+   * The values stay on the GPU so the next draw with the same shader can skip them.
+   * @see ReleaseUniforms()
    */
   void ResetUniforms();
 
+  /**
+   * @brief Query if any uniform values are waiting to be applied
+   * @return true if there are uniforms, false otherwise
+   */
+  const bool HasUniforms() const;
+
+  /**
+   * @brief Query if this shader would upload the same values as another
+   * @param other
+   * @return true if the shader and all uniform values are the same
+   */
+  const bool HasSameUniforms(const SmartShader& other) const;
+
+  /**
+   * @brief Zeroes any uniform values left on any shader
+   *
+   * Called once per frame so shaders shared with non-smart draws start clean
+   */
+  static void ReleaseUniforms();
+
 public:
+  /**
+   * @brief Forget the values uploaded to a shader
+   * @param shader
+   *
+   * Call after writing to the shader with sf::Shader::setUniform() or recompiling it.
+   * The next draw uploads all of its values again and leaves the other uniforms alone.
+   */
+  static void Invalidate(sf::Shader* shader);
+
   /**
    * @brief Constructs a smart shader with pointer to sf::Shader ref set to nullptr
    */
   SmartShader();
-  
+
   /**
    * @brief Constructs a smart shader from another smart shader
    */
   SmartShader(const SmartShader&);
-  
+
   /**
-   * @brief Frees the reference to the shader object and empties the uniform dictionaries
+   * @brief Frees the reference to the shader object and empties the uniform list
    */
   ~SmartShader();
-  
+
   /**
    * @brief Assigns shader object ref to rhs
    * @param rhs shader object to assign itself to
    */
   SmartShader(const sf::Shader& rhs);
-  
+
+  /**
+   * @brief Copies the shader object ref and uniform values
+   * @param rhs
+   */
+  SmartShader& operator=(const SmartShader& rhs);
+
   /**
    * @brief Assignment ops assigns ref to a shader object rhs
    * @param rhs
    */
   SmartShader& operator=(const sf::Shader& rhs);
-  
+
   /**
    * @brief Assignment ops assigns ref to a shader object rhs
    * @param rhs
    */
   SmartShader& operator=(const sf::Shader* rhs);
-  
+
+  /**
+   * @brief Resolves a uniform name to a handle
+   * @param uniform the name of the uniform
+   * @return Uniform handle. The same name always returns the same handle.
+   *
+   * Cache the handle to avoid looking up the name every frame
+   */
+  static Uniform GetUniformHandle(const std::string& uniform);
+
   /**
    * @brief Set a float uniform value
    * @param uniform the name of the uniform
    * @param fvalue
    */
-  void SetUniform(std::string uniform, float fvalue);
-  
+  void SetUniform(const std::string& uniform, float fvalue);
+  void SetUniform(Uniform uniform, float fvalue);
+
   /**
    * @brief Set an integer uniform value
    * @param uniform the name of the uniform
    * @param ivalue
    */
-  void SetUniform(std::string uniform, int ivalue);
-  
+  void SetUniform(const std::string& uniform, int ivalue);
+  void SetUniform(Uniform uniform, int ivalue);
+
   /**
    * @brief Set a vector2f uniform values
    * @param uniform the name of the uniform
    * @param vfvalue
    */
-  void SetUniform(std::string uniform, const sf::Vector2f& vfvalue);
-  
+  void SetUniform(const std::string& uniform, const sf::Vector2f& vfvalue);
+  void SetUniform(Uniform uniform, const sf::Vector2f& vfvalue);
+
   /**
-   * @brief Sets all pre-existing uniforms to 0, empties the lookups, and frees ref
+   * @brief Empties the uniform list and frees ref
    */
   void Reset();
-  
+
   /**
    * @brief Fetch the shader object
    * @return sf::Shader*
@@ -100,3 +203,14 @@ public:
   sf::Shader* Get();
 };
 
+/*! \brief Uniforms of the pixelate shader used when navis and mobs appear */
+struct PixelateUniforms {
+  /**
+   * @brief Set the uniforms to pixelate one frame of a texture
+   * @param shader
+   * @param rect the frame in the texture
+   * @param size size of the texture
+   * @param threshold pixel size. 0 draws the frame as is.
+   */
+  static void Set(SmartShader& shader, const sf::IntRect& rect, const sf::Vector2u& size, float threshold);
+};
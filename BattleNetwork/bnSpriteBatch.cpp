@@ -0,0 +1,201 @@
+#include "bnSpriteBatch.h"
+#include "bnSpriteSceneNode.h"
+#include "bnSmartShader.h"
+#include "bnShaderResourceManager.h"
+
+#include <cmath>
+
+SpriteBatch::SpriteBatch() : order(Order::sequential), count(0), drawCalls(0) {
+}
+
+SpriteBatch::~SpriteBatch() {
+}
+
+void SpriteBatch::Begin(Order order) {
+  this->order = order;
+
+  // Keep the vertex arrays allocated so we don't hit the heap every frame
+  for (std::size_t i = 0; i < count; i++) {
+    batches[i].vertices.clear();
+  }
+
+  count = 0;
+}
+
+SpriteBatch::Batch& SpriteBatch::Next() {
+  if (count == batches.size()) {
+    batches.push_back(Batch());
+  }
+
+  Batch& batch = batches[count++];
+  batch.texture = nullptr;
+  batch.shader = nullptr;
+  batch.uniforms.Reset();
+  batch.hasUniforms = false;
+  batch.drawable = nullptr;
+  batch.states = sf::RenderStates::Default;
+  batch.vertices.clear();
+  batch.vertices.setPrimitiveType(sf::Triangles);
+
+  return batch;
+}
+
+SpriteBatch::Batch& SpriteBatch::Acquire(const sf::Texture* texture, const sf::Shader* shader, const SmartShader* uniforms) {
+  auto matches = [texture, shader, uniforms](const Batch& batch) {
+    if (batch.drawable || batch.texture != texture || batch.shader != shader) return false;
+    if (batch.hasUniforms != (uniforms != nullptr)) return false;
+
+    // Quads with per-node uniforms can still share a draw if the values are identical
+    return !uniforms || batch.uniforms.HasSameUniforms(*uniforms);
+  };
+
+  if (order == Order::grouped) {
+    for (std::size_t i = 0; i < count; i++) {
+      if (matches(batches[i])) return batches[i];
+    }
+  }
+  else if (count > 0 && matches(batches[count - 1])) {
+    return batches[count - 1];
+  }
+
+  Batch& batch = Next();
+  batch.texture = texture;
+  batch.shader = shader;
+
+  if (uniforms) {
+    batch.uniforms = *uniforms;
+    batch.hasUniforms = true;
+  }
+  else {
+    // No values of its own. Applying it still clears what an earlier draw left on the shader.
+    batch.uniforms = shader;
+  }
+
+  return batch;
+}
+
+void SpriteBatch::Append(const sf::Sprite& sprite, const sf::RenderStates& states, const SmartShader* uniforms) {
+  const sf::Texture* texture = sprite.getTexture();
+  const sf::IntRect& rect = sprite.getTextureRect();
+
+  if (!texture || rect.width == 0 || rect.height == 0) return;
+
+  sf::Transform transform = states.transform * sprite.getTransform();
+
+  float width = static_cast<float>(std::abs(rect.width));
+  float height = static_cast<float>(std::abs(rect.height));
+  float left = static_cast<float>(rect.left);
+  float right = left + rect.width;
+  float top = static_cast<float>(rect.top);
+  float bottom = top + rect.height;
+
+  sf::Color color = sprite.getColor();
+
+  // Same corners as sf::Sprite uses for its triangle strip
+  sf::Vertex corners[4] = {
+    sf::Vertex(transform.transformPoint(0.f, 0.f), color, sf::Vector2f(left, top)),
+    sf::Vertex(transform.transformPoint(0.f, height), color, sf::Vector2f(left, bottom)),
+    sf::Vertex(transform.transformPoint(width, 0.f), color, sf::Vector2f(right, top)),
+    sf::Vertex(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom))
+  };
+
+  sf::VertexArray& vertices = Acquire(texture, states.shader, uniforms).vertices;
+  vertices.append(corners[0]);
+  vertices.append(corners[1]);
+  vertices.append(corners[2]);
+  vertices.append(corners[2]);
+  vertices.append(corners[1]);
+  vertices.append(corners[3]);
+}
+
+void SpriteBatch::Submit(const sf::Sprite& sprite, sf::RenderStates states) {
+  Append(sprite, states, nullptr);
+}
+
+void SpriteBatch::Submit(const SpriteSceneNode& node, sf::RenderStates states) {
+  if (!node.show) return;
+
+  states.transform *= node.getTransform();
+
+  const sf::Shader* s = node.shader.Get();
+  const SmartShader* uniforms = nullptr;
+
+  if (s) {
+    states.shader = s;
+
+    // The batch keeps a copy of the values
+    if (node.shader.HasUniforms()) {
+      uniforms = &node.shader;
+    }
+  }
+  else if (!node.IsUsingParentShader()) {
+    states.shader = nullptr;
+  }
+
+  node.SortChildNodes();
+
+  // Same order as SpriteSceneNode::draw()
+  bool submittedSelf = false;
+
+  for (std::size_t i = 0; i < node.childNodes.size(); i++) {
+    SceneNode* child = node.childNodes[i];
+
+    if (!submittedSelf && child->GetLayer() <= node.GetLayer()) {
+      Append(*node.sprite, states, uniforms);
+      submittedSelf = true;
+    }
+
+    if (SpriteSceneNode* sprite = dynamic_cast<SpriteSceneNode*>(child)) {
+      Submit(*sprite, states);
+    }
+    else {
+      // This node draws itself. Record it in order.
+      Batch& batch = Next();
+      batch.drawable = child;
+      batch.states = states;
+    }
+  }
+
+  if (!submittedSelf) {
+    Append(*node.sprite, states, uniforms);
+  }
+
+  // Uniforms are consumed by the draw like Engine::Draw(SpriteSceneNode*)
+  if (uniforms) {
+    node.shader.ResetUniforms();
+  }
+}
+
+void SpriteBatch::Flush(sf::RenderTarget& target, sf::RenderStates states) {
+  drawCalls = 0;
+
+  for (std::size_t i = 0; i < count; i++) {
+    Batch& batch = batches[i];
+
+    if (batch.drawable) {
+      sf::RenderStates drawableStates = batch.states;
+      drawableStates.shader = ShaderResourceManager::Resolve(drawableStates.shader);
+
+      target.draw(*batch.drawable, drawableStates);
+      drawCalls++;
+      continue;
+    }
+
+    if (batch.vertices.getVertexCount() == 0) continue;
+
+    sf::RenderStates batchStates = states;
+    batchStates.texture = batch.texture;
+    batchStates.shader = ShaderResourceManager::Resolve(batch.shader);
+
+    batch.uniforms.ApplyUniforms();
+
+    target.draw(batch.vertices, batchStates);
+    drawCalls++;
+
+    batch.uniforms.ResetUniforms();
+  }
+}
+
+const unsigned SpriteBatch::GetDrawCallCount() const {
+  return drawCalls;
+}
@@ -0,0 +1,109 @@
+/*! \brief Collects sprite quads into vertex arrays and draws them with as few draw calls as possible
+ *
+ * Every sprite submitted to the batch is transformed on the CPU into two triangles
+ * and appended to a vertex array that shares its texture and shader. When the
+ * batch is flushed, each vertex array is drawn with a single draw call.
+ *
+ * There are two ordering modes:
+ *
+ * Order::grouped merges every quad with the same texture+shader regardless of submission
+ * order. Use this for content that never overlaps such as the field tiles.
+ *
+ * Order::sequential only merges a quad with the previous batch. Draw order is
+ * preserved exactly so this is safe for overlapping entities sorted by layer.
+ *
+ * Scene nodes that are not SpriteSceneNodes (e.g. Aura) cannot be flattened into quads.
+ * They are recorded in submission order and drawn with their own draw() during flush.
+ */
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+#include "bnSmartShader.h"
+
+class SceneNode;
+class SpriteSceneNode;
+
+class SpriteBatch {
+public:
+  enum class Order : int {
+    grouped = 0,
+    sequential
+  };
+
+private:
+  /**
+   * @struct Batch
+   * @brief A single draw call. Either a vertex array of quads or a drawable that draws itself
+   */
+  struct Batch {
+    const sf::Texture* texture; /*!< Texture shared by all quads in this batch */
+    const sf::Shader* shader; /*!< Shader shared by all quads in this batch */
+    SmartShader uniforms; /*!< Uniform values applied around this batch only */
+    bool hasUniforms; /*!< If true, quads must share the same uniform values to join this batch */
+    sf::VertexArray vertices; /*!< Pre-transformed quads as triangles */
+    const sf::Drawable* drawable; /*!< If non-null, this batch draws the drawable instead */
+    sf::RenderStates states; /*!< States used for the drawable */
+  };
+
+  Order order; /*!< How quads are merged */
+  std::vector<Batch> batches; /*!< Batches are kept between frames to reuse the allocated vertices */
+  std::size_t count; /*!< Number of batches used this frame */
+  unsigned drawCalls; /*!< Number of draw calls issued by the last flush */
+
+  /**
+   * @brief Finds a batch that can accept quads with this texture+shader or creates a new one
+   * @return Batch&
+   */
+  Batch& Acquire(const sf::Texture* texture, const sf::Shader* shader, const SmartShader* uniforms);
+
+  /**
+   * @brief Reserves the next unused batch and resets it
+   * @return Batch&
+   */
+  Batch& Next();
+
+  /**
+   * @brief Transforms the sprite into two triangles and appends them to a matching batch
+   */
+  void Append(const sf::Sprite& sprite, const sf::RenderStates& states, const SmartShader* uniforms);
+
+public:
+  SpriteBatch();
+  ~SpriteBatch();
+
+  /**
+   * @brief Empties the batch for a new frame
+   * @param order how quads should be merged
+   */
+  void Begin(Order order = Order::sequential);
+
+  /**
+   * @brief Appends the sprite's quad
+   * @param sprite the sprite to draw
+   * @param states transform and shader to draw the sprite with
+   */
+  void Submit(const sf::Sprite& sprite, sf::RenderStates states = sf::RenderStates::Default);
+
+  /**
+   * @brief Flattens the sprite node and its children into the batch in Z order
+   * @param node the node to draw
+   * @param states parent transform and the shader to inherit
+   *
+   * Mirrors SpriteSceneNode::draw()
+   */
+  void Submit(const SpriteSceneNode& node, sf::RenderStates states = sf::RenderStates::Default);
+
+  /**
+   * @brief Draws every batch onto the target
+   * @param target
+   * @param states base states. Transform must be identity because quads are pre-transformed.
+   */
+  void Flush(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default);
+
+  /**
+   * @brief Query how many draw calls the last flush issued
+   * @return unsigned
+   */
+  const unsigned GetDrawCallCount() const;
+};
@@ -59,6 +59,11 @@ void SpriteSceneNode::setTexture(const sf::Texture& texture, bool resetRect) {
   sprite->setTexture(texture, resetRect);
 }
 
+void SpriteSceneNode::setTexture(const TextureHandle& texture, bool resetRect) {
+  sprite->setTexture(*texture, resetRect);
+  this->texture = texture;
+}
+
 void SpriteSceneNode::SetShader(sf::Shader* _shader) {
   if (shader.Get() == _shader && _shader != nullptr) return;
 
@@ -99,18 +104,22 @@ void SpriteSceneNode::draw(sf::RenderTarget& target, sf::RenderStates states) co
     states.shader = nullptr;
   }
 
-  std::vector<SceneNode*> copies = this->childNodes;
-  copies.push_back((SceneNode*)this);
+  SortChildNodes();
 
-  std::sort(copies.begin(), copies.end(), [](SceneNode* a, SceneNode* b) { return (a->GetLayer() > b->GetLayer()); });
+  // Children are sorted by descending layer. Nodes with a higher layer are behind this sprite.
+  bool drawnSelf = false;
 
-  // draw its children
-  for (std::size_t i = 0; i < copies.size(); i++) {
+  for (std::size_t i = 0; i < childNodes.size(); i++) {
     // If it's time to draw our scene node, we draw the proxy sprite
-    if(copies[i] == this) {
+    if (!drawnSelf && childNodes[i]->GetLayer() <= GetLayer()) {
       target.draw(*sprite, states);
-    } else {
-      copies[i]->draw(target, states);
+      drawnSelf = true;
     }
+
+    childNodes[i]->draw(target, states);
+  }
+
+  if (!drawnSelf) {
+    target.draw(*sprite, states);
   }
 }
@@ -13,12 +13,15 @@
 #pragma once
 #include "bnSceneNode.h"
 #include "bnSmartShader.h"
+#include "bnTextureResourceManager.h"
 
 class SpriteSceneNode : public SceneNode {
+  friend class SpriteBatch;
 private:
   bool allocatedSprite; /*!< Whether or not SpriteSceneNode owns the sprite pointer */
   mutable SmartShader shader; /*!< Sprites can have shaders attached to them */
   sf::Sprite* sprite; /*!< Reference to sprite behind proxy */
+  TextureHandle texture; /*!< Keeps the texture loaded while the sprite draws with it */
 
 public:
   /**
@@ -104,6 +107,15 @@ public:
    */
   void setTexture(const sf::Texture& texture, bool resetRect = false);
 
+  /**
+   * @brief Set sprite texture proxy and hold on to the texture
+   * @param texture 
+   * @param resetRect
+   *
+   * The texture stays loaded until the node is deleted or given another handle
+   */
+  void setTexture(const TextureHandle& texture, bool resetRect = false);
+
   /**
    * @brief Converts sf::Shader to SmartShader and attaches it.
    * @param _shader
@@ -137,7 +149,8 @@ public:
    * @param states
    * 
    * SpriteSceneNodes can have child nodes in front of them. To achieve this,
-   * we sort by Z and if this sprite node is to be drawn, drawns the proxy sprite
+   * children are kept sorted by Z and the proxy sprite is drawn before the first 
+   * child that is not behind it
    */
   virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
 };
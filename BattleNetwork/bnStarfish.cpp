@@ -29,7 +29,7 @@ Starfish::Starfish(Rank _rank)
 
   hitHeight = 60;
 
-  setTexture(*TEXTURES.GetTexture(textureType));
+  setTexture(TEXTURES.LoadTexture(textureType));
   setScale(2.f, 2.f);
 
   this->SetHealth(health);
@@ -7,8 +7,8 @@
 SuperVulcan::SuperVulcan(Field* _field, Team _team, int damage) : damage(damage), Spell(_field, _team) {
   SetLayer(1);
 
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_SUPER_VULCAN);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_SUPER_VULCAN);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   //When the animation ends, delete this
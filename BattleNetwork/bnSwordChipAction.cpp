@@ -20,7 +20,8 @@ SwordChipAction::SwordChipAction(Character * owner, int damage) : ChipAction(own
   attachmentAnim.Reload();
   attachmentAnim.SetAnimation("DEFAULT");
 
-  overlay.setTexture(*TextureResourceManager::GetInstance().LoadTextureFromFile(PATH));
+  overlayTexture = TEXTURES.LoadTexture(PATH);
+  overlay.setTexture(*overlayTexture);
   this->attachment = new SpriteSceneNode(overlay);
   this->attachment->SetLayer(-2);
 
@@ -32,7 +33,8 @@ SwordChipAction::SwordChipAction(Character * owner, int damage) : ChipAction(own
   hiltAttachmentAnim.Reload();
   hiltAttachmentAnim.SetAnimation("HILT");
 
-  overlay.setTexture(*TextureResourceManager::GetInstance().LoadTextureFromFile(PATH));
+  overlayTexture = TEXTURES.LoadTexture(PATH);
+  overlay.setTexture(*overlayTexture);
   attachmentAnim = Animation(ANIM);
   attachmentAnim.Reload();
   attachmentAnim.SetAnimation("DEFAULT");
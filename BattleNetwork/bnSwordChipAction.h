@@ -2,6 +2,7 @@
 #include "bnChipAction.h"
 #include "bnAnimation.h"
 #include <SFML/Graphics.hpp>
+#include "bnTextureResourceManager.h"
 
 class SpriteSceneNode;
 class Character;
@@ -10,6 +11,7 @@ class Character;
 class SwordChipAction : public ChipAction {
 protected:
   sf::Sprite overlay;
+  TextureHandle overlayTexture;
   SpriteSceneNode* attachment;
   SpriteSceneNode* hiltAttachment;
   Animation attachmentAnim,hiltAttachmentAnim;
@@ -11,7 +11,7 @@ using sf::IntRect;
 SwordEffect::SwordEffect(Field* field) : Artifact(field)
 {
   SetLayer(0);
-  this->setTexture(*TEXTURES.GetTexture(TextureType::SPELL_SWORD));
+  this->setTexture(TEXTURES.LoadTexture(TextureType::SPELL_SWORD));
   this->setScale(2.f, 2.f);
 
   //Components setup and load
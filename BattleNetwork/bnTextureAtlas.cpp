@@ -0,0 +1,312 @@
+#include "bnTextureAtlas.h"
+#include "bnFileUtil.h"
+#include "bnKeyValueReader.h"
+#include "bnLogger.h"
+#include "bnAssetLoader.h"
+#include "bnSaveService.h"
+
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <sstream>
+
+namespace {
+  const char* ATLAS_VERSION = "1";
+  const char* ATLAS_TABLE = "atlas.txt";
+  const unsigned MAX_PAGE_SIZE = 2048;
+  const int PADDING = 1;
+}
+
+TextureAtlas::TextureAtlas() : pageSize(0) {
+}
+
+TextureAtlas::~TextureAtlas() {
+  Clear();
+}
+
+void TextureAtlas::Clear() {
+  for (auto page : pages) {
+    delete page;
+  }
+
+  pages.clear();
+  regions.clear();
+}
+
+void TextureAtlas::Add(const std::string& path) {
+  sources.push_back(Source{ path, 0, 0 });
+}
+
+void TextureAtlas::Build(const std::string& cacheDir, const std::function<void()>& onReady) {
+  Clear();
+
+  pageSize = std::min(MAX_PAGE_SIZE, sf::Texture::getMaximumSize());
+
+  LOADER.Decode([this, cacheDir, onReady]() {
+    for (auto& source : sources) {
+      source.size = static_cast<unsigned long long>(FileUtil::GetSize(source.path));
+      source.modified = FileUtil::GetModifiedTime(source.path);
+    }
+
+    auto result = std::make_shared<BuildResult>();
+    bool cached = LoadCache(cacheDir, *result);
+
+    if (!cached) {
+      *result = BuildResult();
+      Pack(*result);
+    }
+
+    // Textures can only be created on the main thread
+    LOADER.Upload([this, result, cached, onReady]() {
+      for (auto& image : result->pageImages) {
+        sf::Texture* texture = new sf::Texture();
+        texture->loadFromImage(image);
+        pages.push_back(texture);
+      }
+
+      regions = result->regions;
+
+      LOG_INFO(CONTENT, "%s texture atlas: %i images in %i pages", cached ? "Loaded cached" : "Packed", (int)regions.size(), (int)pages.size());
+
+      if (onReady) onReady();
+    });
+
+    // Only reading the images from here so this can overlap the upload
+    if (!cached) {
+      WriteCache(cacheDir, *result);
+    }
+  });
+}
+
+bool TextureAtlas::LoadCache(const std::string& cacheDir, BuildResult& result) {
+  const std::string tablePath = cacheDir + "/" + ATLAS_TABLE;
+  std::string data = FileUtil::Read(tablePath);
+
+  if (data.empty()) return false;
+
+  KeyValueReader reader(data, tablePath);
+
+  if (!reader.Next() || reader.Get("VERSION", "") != ATLAS_VERSION) return false;
+
+  std::size_t sourceIndex = 0;
+  std::vector<std::string> pagePaths;
+
+  while (reader.Next()) {
+    std::string_view tag = reader.GetTag();
+
+    if (tag == "source") {
+      // Sources must match the order they were added in and be unchanged on disk
+      if (sourceIndex >= sources.size()) return false;
+
+      const Source& source = sources[sourceIndex++];
+
+      if (reader.Require("path") != source.path) return false;
+      if ((unsigned long long)KeyValueReader::ToInt64(reader.Require("size")) != source.size) return false;
+      if (KeyValueReader::ToInt64(reader.Require("modified")) != source.modified) return false;
+    }
+    else if (tag == "page") {
+      int index = KeyValueReader::ToInt(reader.Require("index"));
+
+      if (index != (int)pagePaths.size()) return false;
+
+      pagePaths.push_back(KeyValueReader::ToString(reader.Require("path")));
+    }
+    else if (tag == "region") {
+      Placement placement;
+      placement.page = KeyValueReader::ToInt(reader.Require("page"));
+      placement.rect.left = KeyValueReader::ToInt(reader.Require("x"));
+      placement.rect.top = KeyValueReader::ToInt(reader.Require("y"));
+      placement.rect.width = KeyValueReader::ToInt(reader.Require("w"));
+      placement.rect.height = KeyValueReader::ToInt(reader.Require("h"));
+
+      if (placement.page < 0 || placement.page >= (int)pagePaths.size()) return false;
+
+      result.regions.insert(std::make_pair(KeyValueReader::ToString(reader.Require("key")), placement));
+    }
+  }
+
+  if (reader.GetErrorCount() > 0) {
+    LOG_WARN(CONTENT, "Texture atlas cache is corrupt");
+    return false;
+  }
+
+  if (sourceIndex != sources.size()) return false;
+
+  // Decode the pages in parallel
+  result.pageImages.resize(pagePaths.size());
+  std::atomic<bool> ok{ true };
+
+  LOADER.ParallelFor(pagePaths.size(), [&result, &pagePaths, &ok](std::size_t i) {
+    if (!result.pageImages[i].loadFromFile(pagePaths[i])) {
+      ok = false;
+    }
+  });
+
+  return ok;
+}
+
+void TextureAtlas::Pack(BuildResult& result) {
+  std::vector<sf::Image> images(sources.size());
+  std::vector<char> loaded(sources.size(), 0);
+
+  // Decoding is the slow part. Spread it across the workers.
+  LOADER.ParallelFor(sources.size(), [this, &images, &loaded](std::size_t i) {
+    loaded[i] = FileUtil::LoadResource(images[i], sources[i].path) ? 1 : 0;
+  });
+
+  std::vector<std::size_t> order;
+
+  for (std::size_t i = 0; i < sources.size(); i++) {
+    if (!loaded[i]) {
+      LOG_ERROR(CONTENT, "Failed to load atlas image: %s", sources[i].path.c_str());
+      continue;
+    }
+
+    sf::Vector2u size = images[i].getSize();
+
+    if (size.x + PADDING > pageSize || size.y + PADDING > pageSize) {
+      LOG_WARN(CONTENT, "Image is too large for the texture atlas and will be loaded on its own: %s", sources[i].path.c_str());
+      continue;
+    }
+
+    order.push_back(i);
+  }
+
+  // Tallest first keeps the shelves tight
+  std::stable_sort(order.begin(), order.end(), [&images](std::size_t a, std::size_t b) {
+    return images[a].getSize().y > images[b].getSize().y;
+  });
+
+  std::vector<int> pageHeights;
+  std::vector<std::pair<std::size_t, Placement>> placements;
+
+  int page = -1;
+  int x = 0, y = 0, shelfHeight = 0;
+
+  for (auto i : order) {
+    int w = static_cast<int>(images[i].getSize().x);
+    int h = static_cast<int>(images[i].getSize().y);
+
+    if (page >= 0 && x + w > static_cast<int>(pageSize)) {
+      // Start a new shelf
+      x = 0;
+      y += shelfHeight + PADDING;
+      shelfHeight = 0;
+    }
+
+    if (page < 0 || y + h > static_cast<int>(pageSize)) {
+      // Start a new page
+      page++;
+      pageHeights.push_back(0);
+      x = y = shelfHeight = 0;
+    }
+
+    placements.push_back(std::make_pair(i, Placement{ page, sf::IntRect(x, y, w, h) }));
+
+    x += w + PADDING;
+    shelfHeight = std::max(shelfHeight, h);
+    pageHeights[page] = std::max(pageHeights[page], y + h);
+  }
+
+  // Pages are only as tall as what was packed into them
+  result.pageImages.resize(pageHeights.size());
+
+  for (std::size_t p = 0; p < pageHeights.size(); p++) {
+    result.pageImages[p].create(pageSize, static_cast<unsigned>(pageHeights[p]), sf::Color::Transparent);
+  }
+
+  for (auto& placement : placements) {
+    const Placement& where = placement.second;
+    result.pageImages[where.page].copy(images[placement.first], where.rect.left, where.rect.top);
+    result.regions.insert(std::make_pair(sources[placement.first].path, where));
+  }
+}
+
+void TextureAtlas::WriteCache(const std::string& cacheDir, const BuildResult& result) {
+  // If this fails we pack again next run
+  if (!FileUtil::MakeDirectory(cacheDir)) {
+    LOG_WARN(CONTENT, "Could not create texture atlas cache directory %s", cacheDir.c_str());
+    return;
+  }
+
+  const std::string tablePath = cacheDir + "/" + ATLAS_TABLE;
+
+  // The old table must not survive a crash while the pages are being replaced.
+  // Its sources still match so it would load the new pages with the old layout.
+  if (!FileUtil::Remove(tablePath)) {
+    LOG_WARN(CONTENT, "Could not remove texture atlas table %s", tablePath.c_str());
+    return;
+  }
+
+  std::atomic<bool> ok{ true };
+
+  // PNG compression is slow too
+  LOADER.ParallelFor(result.pageImages.size(), [&cacheDir, &result, &ok](std::size_t p) {
+    std::string pagePath = cacheDir + "/page_" + std::to_string(p) + ".png";
+
+    if (!result.pageImages[p].saveToFile(pagePath)) {
+      LOG_WARN(CONTENT, "Could not write texture atlas page %s", pagePath.c_str());
+      ok = false;
+    }
+  });
+
+  // Without every page the table would point at missing files
+  if (!ok) return;
+
+  std::ostringstream ws;
+
+  ws << "VERSION=\"" << ATLAS_VERSION << "\"" << '\n';
+
+  for (auto& source : sources) {
+    ws << "source size=\"" << std::to_string(source.size) << "\" modified=\"" << std::to_string(source.modified)
+       << "\" path=\"" << source.path << "\"" << '\n';
+  }
+
+  for (std::size_t p = 0; p < result.pageImages.size(); p++) {
+    ws << "page index=\"" << std::to_string(p) << "\" path=\"" << cacheDir << "/page_" << std::to_string(p) << ".png\"" << '\n';
+  }
+
+  for (auto& region : result.regions) {
+    const sf::IntRect& rect = region.second.rect;
+
+    ws << "region page=\"" << std::to_string(region.second.page)
+       << "\" x=\"" << std::to_string(rect.left) << "\" y=\"" << std::to_string(rect.top)
+       << "\" w=\"" << std::to_string(rect.width) << "\" h=\"" << std::to_string(rect.height)
+       << "\" key=\"" << region.first << "\"" << '\n';
+  }
+
+  // The pages are all on disk. A half written table would be ignored but could not be trusted either.
+  if (!SaveService::WriteAtomic(tablePath, ws.str())) {
+    LOG_WARN(CONTENT, "Could not write texture atlas table %s", tablePath.c_str());
+  }
+}
+
+const bool TextureAtlas::Contains(const std::string& path) const {
+  return regions.find(path) != regions.end();
+}
+
+TextureRegion TextureAtlas::Find(const std::string& path) const {
+  auto iter = regions.find(path);
+
+  if (iter == regions.end()) return TextureRegion();
+
+  return TextureRegion(pages[iter->second.page], iter->second.rect);
+}
+
+bool TextureAtlas::Update(const std::string& path, const sf::Image& image) {
+  auto iter = regions.find(path);
+
+  if (iter == regions.end()) return false;
+
+  const sf::IntRect& rect = iter->second.rect;
+  sf::Vector2u size = image.getSize();
+
+  if (size.x != (unsigned)rect.width || size.y != (unsigned)rect.height) return false;
+
+  pages[iter->second.page]->update(image, rect.left, rect.top);
+  return true;
+}
+
+const std::size_t TextureAtlas::GetPageCount() const {
+  return pages.size();
+}
@@ -0,0 +1,154 @@
+/*! \brief Packs many small textures into a few large atlas pages
+ *
+ * Every texture switch ends a sprite batch. Textures that are drawn together
+ * during battle are packed into shared pages so that their sprites can be
+ * merged into the same draw call.
+ *
+ * Sources are packed on shelves sorted by height with 1px of padding between
+ * regions. Sources too large to fit on a page are skipped and should be loaded
+ * on their own.
+ *
+ * The packed pages and the region table are cached on disk. The cache is only
+ * rebuilt when a source image changes size or modified time, or when the list
+ * of sources changes.
+ *
+ * Cache table format (one entry per line):
+ *
+ * VERSION="1"
+ * source size="1234" modified="5678" path="resources/tiles/tile_atlas_blue.png"
+ * page index="0" path="cache/atlas/page_0.png"
+ * region page="0" x="0" y="0" w="720" h="180" key="resources/tiles/tile_atlas_blue.png"
+ */
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+
+/**
+ * @struct TextureRegion
+ * @brief A texture and the sub-rectangle of it that holds the image
+ *
+ * Texture coordinates for the image must be offset by rect.left and rect.top
+ */
+struct TextureRegion {
+  const sf::Texture* texture; /*!< Page or standalone texture. nullptr if not loaded */
+  sf::IntRect rect; /*!< Where the image lives in the texture */
+
+  TextureRegion() : texture(nullptr), rect() { }
+  TextureRegion(const sf::Texture* texture, const sf::IntRect& rect) : texture(texture), rect(rect) { }
+};
+
+class TextureAtlas {
+private:
+  /**
+   * @struct Source
+   * @brief An image file that should be packed
+   */
+  struct Source {
+    std::string path;
+    unsigned long long size;
+    long long modified;
+  };
+
+  /**
+   * @struct Placement
+   * @brief Where a source image was packed
+   */
+  struct Placement {
+    int page;
+    sf::IntRect rect;
+  };
+
+  /**
+   * @struct BuildResult
+   * @brief Decoded pages waiting to be uploaded on the main thread
+   */
+  struct BuildResult {
+    std::vector<sf::Image> pageImages;
+    std::map<std::string, Placement> regions;
+  };
+
+  std::vector<Source> sources; /*!< Images to pack in the order they were added */
+  std::vector<sf::Texture*> pages; /*!< Packed atlas pages */
+  std::map<std::string, Placement> regions; /*!< Source path to region */
+  unsigned pageSize; /*!< Width and height of each page */
+
+  /**
+   * @brief Try to decode the pages and region table from the cache
+   * @param cacheDir directory with the cached table
+   * @param result decoded pages and regions
+   * @return true if the cache exists and matches every source
+   */
+  bool LoadCache(const std::string& cacheDir, BuildResult& result);
+
+  /**
+   * @brief Decode and pack every source into new page images
+   * @param result packed pages and regions
+   */
+  void Pack(BuildResult& result);
+
+  /**
+   * @brief Write the packed pages and region table to disk
+   * @param cacheDir directory to write the cache to
+   * @param result packed pages and regions
+   */
+  void WriteCache(const std::string& cacheDir, const BuildResult& result);
+
+  /**
+   * @brief Deletes all pages and clears the region table
+   */
+  void Clear();
+
+public:
+  TextureAtlas();
+  ~TextureAtlas();
+
+  /**
+   * @brief Queue an image to be packed by the next Build()
+   * @param path path to the image. Also used as the key for Find()
+   */
+  void Add(const std::string& path);
+
+  /**
+   * @brief Loads the atlas from the cache or packs it if the cache is stale
+   * @param cacheDir directory for the cached pages and table
+   * @param onReady called on the main thread after the pages are uploaded
+   *
+   * Images are decoded and packed on the asset loader's worker threads.
+   * The pages are uploaded when the main thread drains the loader's upload queue.
+   * @see AssetLoader
+   */
+  void Build(const std::string& cacheDir, const std::function<void()>& onReady = nullptr);
+
+  /**
+   * @brief Query if an image was packed
+   * @param path path the image was added with
+   * @return true if the image is in a page
+   */
+  const bool Contains(const std::string& path) const;
+
+  /**
+   * @brief Find the page and rect an image was packed into
+   * @param path path the image was added with
+   * @return region. The texture is nullptr if the image was not packed.
+   */
+  TextureRegion Find(const std::string& path) const;
+
+  /**
+   * @brief Copy a changed image over its region in the page
+   * @param path path the image was added with
+   * @param image new pixels. Must be the same size as the region.
+   * @return false if the image was not packed or changed size
+   *
+   * The cached pages are rebuilt the next time Build() runs because the source changed
+   */
+  bool Update(const std::string& path, const sf::Image& image);
+
+  /**
+   * @brief Query the number of pages
+   * @return page count
+   */
+  const std::size_t GetPageCount() const;
+};
@@ -1,4 +1,5 @@
 #include "bnTextureResourceManager.h"
+#include "bnFileUtil.h"
 
 #include <stdlib.h>
 #include <atomic>
@@ -12,39 +13,241 @@ TextureResourceManager& TextureResourceManager::GetInstance() {
   return instance;
 }
 
+const bool TextureResourceManager::IsPacked(TextureType _ttype) {
+  // Only pack what is drawn through GetTextureRegion(). Anything else would be
+  // loaded again as a standalone texture by GetTexture() and take twice the memory.
+  return _ttype == TextureType::TILE_ATLAS_BLUE || _ttype == TextureType::TILE_ATLAS_RED;
+}
+
 void TextureResourceManager::LoadAllTextures(std::atomic<int> &status) {
+  int packed = 0;
+
   TextureType textureType = static_cast<TextureType>(0);
   while (textureType != TEXTURE_TYPE_SIZE) {
-    status++;
+    // Everything else is loaded the first time it is used
+    if (IsPacked(textureType)) {
+      atlas.Add(paths[static_cast<int>(textureType)]);
+      packed++;
+    }
+    else {
+      status++;
+    }
 
-    // TODO: Catch failed resources and try again
-    Texture* texture = nullptr;
-    texture = LoadTextureFromFile(paths[static_cast<int>(textureType)]);
-    if (texture) textures.insert(pair<TextureType, Texture*>(textureType, texture));
     textureType = (TextureType)(static_cast<int>(textureType) + 1);
   }
+
+  // Packed textures are counted when their pages are on the GPU
+  atlas.Build("cache/atlas", [&status, packed]() { status += packed; });
 }
 
 Texture* TextureResourceManager::LoadTextureFromFile(string _path) {
   Texture* texture = new Texture();
-  if (!texture->loadFromFile(_path)) {
+  if (!FileUtil::LoadResource(*texture, _path)) {
 
-    Logger::GetMutex()->lock();
-    Logger::Logf("Failed loading texture: %s", _path.c_str());
-    Logger::GetMutex()->unlock();
+    LOG_ERROR(CONTENT, "Failed loading texture: %s", _path.c_str());
 
   } else {
 
-    Logger::GetMutex()->lock();
-    Logger::Logf("Loaded texture: %s", _path.c_str());
-    Logger::GetMutex()->unlock();
+    LOG_DEBUG(CONTENT, "Loaded texture: %s", _path.c_str());
 
   }
   return texture;
 }
 
+TextureHandle TextureResourceManager::Acquire(const string& _path, bool pin) {
+  {
+    std::lock_guard<std::mutex> lock(textureMutex);
+
+    auto iter = cache.find(_path);
+    if (iter != cache.end()) return Use(iter->second, pin);
+  }
+
+  // Decode without the lock so other threads can load other textures
+  return Store(_path, TextureHandle(LoadTextureFromFile(_path)), pin);
+}
+
+TextureHandle TextureResourceManager::Store(const string& _path, const TextureHandle& texture, bool pin) {
+  std::lock_guard<std::mutex> lock(textureMutex);
+
+  auto iter = cache.find(_path);
+
+  // If another thread loaded it first, share theirs
+  if (iter == cache.end()) {
+    CachedTexture entry;
+    entry.texture = texture;
+    sf::Vector2u size = texture->getSize();
+    entry.bytes = static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * 4u;
+    entry.lastUsed = 0;
+    entry.pinned = false;
+
+    cacheBytes += entry.bytes;
+    iter = cache.insert(std::make_pair(_path, entry)).first;
+  }
+
+  return Use(iter->second, pin);
+}
+
+TextureHandle TextureResourceManager::Use(CachedTexture& entry, bool pin) {
+  entry.lastUsed = ++useCounter;
+  entry.pinned = entry.pinned || pin;
+
+  TextureHandle texture = entry.texture;
+
+  // The texture we just asked for is the most recent and is never evicted here
+  Evict();
+
+  return texture;
+}
+
+bool TextureResourceManager::Reload(const string& _path) {
+  std::lock_guard<std::mutex> lock(textureMutex);
+
+  bool reloaded = false;
+
+  if (atlas.Contains(_path)) {
+    sf::Image image;
+
+    if (FileUtil::LoadResource(image, _path) && atlas.Update(_path, image)) {
+      reloaded = true;
+    }
+    else {
+      LOG_WARN(CONTENT, "Packed texture %s changed size. Restart to repack the atlas.", _path.c_str());
+    }
+  }
+
+  auto iter = cache.find(_path);
+
+  if (iter != cache.end()) {
+    // Loading into the same texture keeps every sprite pointing at it valid
+    if (!FileUtil::LoadResource(*iter->second.texture, _path)) {
+      LOG_ERROR(CONTENT, "Failed reloading texture: %s", _path.c_str());
+      return reloaded;
+    }
+
+    sf::Vector2u size = iter->second.texture->getSize();
+    std::size_t bytes = static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * 4u;
+
+    cacheBytes = cacheBytes - iter->second.bytes + bytes;
+    iter->second.bytes = bytes;
+    reloaded = true;
+  }
+
+  return reloaded;
+}
+
+void TextureResourceManager::Evict() {
+  while (cacheBytes > budget) {
+    auto oldest = cache.end();
+
+    for (auto iter = cache.begin(); iter != cache.end(); ++iter) {
+      // Only the cache holds a reference. Nothing is drawing with it.
+      bool unused = !iter->second.pinned && iter->second.texture.use_count() == 1 && iter->second.lastUsed != useCounter;
+
+      if (unused && (oldest == cache.end() || iter->second.lastUsed < oldest->second.lastUsed)) {
+        oldest = iter;
+      }
+    }
+
+    // Everything left is in use
+    if (oldest == cache.end()) return;
+
+    LOG_DEBUG(CONTENT, "Evicted texture: %s", oldest->first.c_str());
+
+    cacheBytes -= oldest->second.bytes;
+    cache.erase(oldest);
+  }
+}
+
+TextureHandle TextureResourceManager::LoadTexture(TextureType _ttype) {
+  return LoadTexture(paths[static_cast<int>(_ttype)]);
+}
+
+TextureHandle TextureResourceManager::LoadTexture(const string& _path) {
+  return Acquire(_path, false);
+}
+
+std::vector<TextureResourceManager::DecodedTexture> TextureResourceManager::Decode(const std::vector<TextureType>& _ttypes) {
+  std::vector<DecodedTexture> decoded(_ttypes.size());
+
+  for (std::size_t i = 0; i < _ttypes.size(); i++) {
+    DecodedTexture& entry = decoded[i];
+    entry.path = paths[static_cast<int>(_ttypes[i])];
+    entry.decoded = false;
+
+    {
+      std::lock_guard<std::mutex> lock(textureMutex);
+      if (cache.find(entry.path) != cache.end()) continue;
+    }
+
+    entry.decoded = FileUtil::LoadResource(entry.image, entry.path);
+
+    if (!entry.decoded) {
+      LOG_ERROR(CONTENT, "Failed loading texture: %s", entry.path.c_str());
+    }
+  }
+
+  return decoded;
+}
+
+std::vector<TextureHandle> TextureResourceManager::Upload(const std::vector<DecodedTexture>& _decoded) {
+  std::vector<TextureHandle> handles;
+  handles.reserve(_decoded.size());
+
+  for (auto& entry : _decoded) {
+    if (!entry.decoded) {
+      // Cached when it was decoded. Loads it again here if it was evicted since.
+      handles.push_back(Acquire(entry.path, false));
+      continue;
+    }
+
+    TextureHandle texture = std::make_shared<Texture>();
+    texture->loadFromImage(entry.image);
+
+    LOG_DEBUG(CONTENT, "Loaded texture: %s", entry.path.c_str());
+
+    handles.push_back(Store(entry.path, texture, false));
+  }
+
+  return handles;
+}
+
+std::vector<TextureHandle> TextureResourceManager::Prefetch(const std::vector<TextureType>& _ttypes) {
+  std::vector<TextureHandle> handles;
+  handles.reserve(_ttypes.size());
+
+  for (auto type : _ttypes) {
+    handles.push_back(LoadTexture(type));
+  }
+
+  return handles;
+}
+
 Texture* TextureResourceManager::GetTexture(TextureType _ttype) {
-  return textures.at(_ttype);
+  // Callers keep the raw pointer so this texture can never be evicted
+  return Acquire(paths[static_cast<int>(_ttype)], true).get();
+}
+
+void TextureResourceManager::SetBudget(std::size_t bytes) {
+  std::lock_guard<std::mutex> lock(textureMutex);
+  budget = bytes;
+  Evict();
+}
+
+const std::size_t TextureResourceManager::GetCacheSize() {
+  std::lock_guard<std::mutex> lock(textureMutex);
+  return cacheBytes;
+}
+
+TextureRegion TextureResourceManager::GetTextureRegion(TextureType _ttype) {
+  TextureRegion region = atlas.Find(paths[static_cast<int>(_ttype)]);
+
+  if (region.texture) return region;
+
+  // Not packed. Use the whole texture.
+  Texture* texture = GetTexture(_ttype);
+  sf::Vector2u size = texture->getSize();
+
+  return TextureRegion(texture, sf::IntRect(0, 0, (int)size.x, (int)size.y));
 }
 
 sf::IntRect TextureResourceManager::GetCardRectFromID(unsigned ID) {
@@ -58,15 +261,21 @@ sf::IntRect TextureResourceManager::GetIconRectFromID(unsigned ID) {
 
 Font* TextureResourceManager::LoadFontFromFile(string _path) {
   Font* font = new Font();
-  if (!font->loadFromFile(_path)) {
-    Logger::Logf("Failed loading font: %s", _path.c_str());
+  if (!FileUtil::LoadResource(*font, _path)) {
+    LOG_ERROR(CONTENT, "Failed loading font: %s", _path.c_str());
   } else {
-    Logger::Logf("Loaded font: %s", _path.c_str());
+    LOG_DEBUG(CONTENT, "Loaded font: %s", _path.c_str());
   }
   return font;
 }
 
-TextureResourceManager::TextureResourceManager(void) {
+TextureResourceManager::TextureResourceManager(void) : useCounter(0), cacheBytes(0) {
+#ifdef __ANDROID__
+  budget = 64u * 1024u * 1024u;
+#else
+  budget = 256u * 1024u * 1024u;
+#endif
+
   //-Tiles-
   //Blue tile
   paths.push_back("resources/tiles/tile_atlas_blue.png");
@@ -271,7 +480,5 @@ TextureResourceManager::TextureResourceManager(void) {
 }
 
 TextureResourceManager::~TextureResourceManager(void) {
-  for (auto it = textures.begin(); it != textures.end(); ++it) {
-    delete it->second;
-  }
+  cache.clear();
 }
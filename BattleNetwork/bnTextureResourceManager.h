@@ -14,6 +14,7 @@
 
 #pragma once
 #include "bnTextureType.h"
+#include "bnTextureAtlas.h"
 #include "bnLogger.h"
 
 #include <SFML/Graphics.hpp>
@@ -21,6 +22,8 @@
 #include <vector>
 #include <iostream>
 #include <atomic>
+#include <mutex>
+#include <memory>
 
 using std::cerr;
 using std::endl;
@@ -31,8 +34,22 @@ using sf::Texture;
 using sf::Font;
 using std::string;
 
+/*! \brief Reference counted texture. The texture can be evicted once no handles are left. */
+typedef std::shared_ptr<sf::Texture> TextureHandle;
+
 class TextureResourceManager {
 public:
+  /**
+   * @struct DecodedTexture
+   * @brief A texture file decoded off the main thread that is not on the GPU yet
+   * @see Decode()
+   */
+  struct DecodedTexture {
+    string path;
+    sf::Image image;
+    bool decoded; /*!< false if the texture was already cached or failed to load */
+  };
+
   /**
    * @brief If this is the first call, initializes the resource manager. 
    * @return Returns reference to texture resource manager.
@@ -40,25 +57,100 @@ public:
   static TextureResourceManager& GetInstance();
   
   /**
-   * @brief Loads all hard-coded textures
-   * @param status Increases the count after each texture loads
+   * @brief Packs the tile textures into the texture atlas
+   * @param status Increases the count for each hard-coded texture
+   *
+   * Returns right away. The atlas is decoded on the asset loader and packed textures
+   * are counted once the main thread has uploaded the pages.
+   *
+   * All other textures are loaded the first time they are used
+   * @see GetTextureRegion()
+   * @see LoadTexture()
    */
   void LoadAllTextures(std::atomic<int> &status);
   
   /**
-   * @brief Given a file path, returns a pointer to the loaded texture
-   * @param _path Relative path to the application
-   * @return Texture pointer. Must manually delete.
-   */
-  Texture* LoadTextureFromFile(string _path);
-  
-  /**
-   * @brief Returns pointer to the pre-loaded texture type
+   * @brief Returns pointer to the texture type. Loads it if this is the first use.
    * @param _ttype Texture type to fetch from cache
    * @return Texture pointer. 
    * @warning Do not delete! This resource is managed by the manager.
+   *
+   * The texture stays loaded for the rest of the program. Only use this when the
+   * pointer has to outlive the scene. Prefer LoadTexture().
    */
   Texture* GetTexture(TextureType _ttype);
+
+  /**
+   * @brief Returns a reference counted handle to the texture type. Loads it if this is the first use.
+   * @param _ttype Texture type to fetch from cache
+   * @return TextureHandle
+   *
+   * Keep the handle for as long as anything draws with the texture.
+   * Once all handles are gone the texture may be evicted to stay under the budget.
+   */
+  TextureHandle LoadTexture(TextureType _ttype);
+
+  /**
+   * @brief Returns a reference counted handle to a texture file. Loads it if this is the first use.
+   * @param _path Relative path to the application
+   * @return TextureHandle
+   */
+  TextureHandle LoadTexture(const string& _path);
+
+  /**
+   * @brief Loads a list of textures ahead of time
+   * @param _ttypes textures a scene or mob will use
+   * @return Handles that keep the textures loaded. Hold on to them for the lifetime of the scene.
+   */
+  std::vector<TextureHandle> Prefetch(const std::vector<TextureType>& _ttypes);
+
+  /**
+   * @brief Decode texture files without touching the GL context
+   * @param _ttypes textures to load
+   * @return one entry per type in the same order. Pass them to Upload() on the main thread.
+   *
+   * Safe to call from the asset loader. Textures that are already cached are not decoded again.
+   */
+  std::vector<DecodedTexture> Decode(const std::vector<TextureType>& _ttypes);
+
+  /**
+   * @brief Create the textures decoded by Decode(). Main thread only.
+   * @param _decoded
+   * @return Handles in the same order. Hold on to them for as long as the textures are needed.
+   */
+  std::vector<TextureHandle> Upload(const std::vector<DecodedTexture>& _decoded);
+
+  /**
+   * @brief Set how many bytes of texture memory the cache may use before evicting unused textures
+   * @param bytes
+   */
+  void SetBudget(std::size_t bytes);
+
+  /**
+   * @brief Query how much texture memory the cache is using
+   * @return bytes
+   */
+  const std::size_t GetCacheSize();
+
+  /**
+   * @brief Returns the atlas page and sub-rect the texture type was packed into
+   * @param _ttype Texture type to fetch
+   * @return TextureRegion. Falls back to the whole standalone texture if the type was not packed.
+   *
+   * Texture rects used with the region must be offset by the region's left and top
+   */
+  TextureRegion GetTextureRegion(TextureType _ttype);
+
+  /**
+   * @brief Load a changed image file into the textures that are already using it
+   * @param _path Relative path to the application
+   * @return true if a texture or atlas region was updated
+   *
+   * Textures are reloaded in place so every sprite and handle keeps working.
+   * Packed images are copied into their atlas page if they did not change size.
+   * Must be called from the main thread.
+   */
+  bool Reload(const string& _path);
   
   /**
    * @brief Legacy code. Returns card rectangle for spritesheet.
@@ -85,11 +177,74 @@ private:
   TextureResourceManager();
   ~TextureResourceManager();
   vector<string> paths; /**< Paths to all textures. Must be in order of TextureType @see TextureType */
-  map<TextureType, Texture*> textures; /**< Cache */
+  /**
+   * @struct CachedTexture
+   * @brief A loaded texture and its bookkeeping
+   */
+  struct CachedTexture {
+    TextureHandle texture;
+    std::size_t bytes; /**< Approximate texture memory: width * height * 4 */
+    unsigned long long lastUsed; /**< Value of useCounter when last requested */
+    bool pinned; /**< Handed out with GetTexture() and can never be evicted */
+  };
+
+  map<string, CachedTexture> cache; /**< Loaded textures by path */
+  unsigned long long useCounter; /**< Increments on every request. Orders textures by last use. */
+  std::size_t cacheBytes; /**< Sum of all cached texture sizes */
+  std::size_t budget; /**< Evict unused textures when cacheBytes goes over this */
+  TextureAtlas atlas; /**< Tile textures packed together so every tile shares draw calls */
+  std::mutex textureMutex; /**< Guards the cache. Textures can be requested from the loading threads. */
+
+  /**
+   * @brief Find or load a texture. The file is decoded without holding textureMutex.
+   * @param _path
+   * @param pin true to keep the texture loaded for the rest of the program
+   * @return TextureHandle
+   */
+  TextureHandle Acquire(const string& _path, bool pin);
+
+  /**
+   * @brief Decode a texture file. Called by Acquire() without textureMutex locked.
+   * @param _path Relative path to the application
+   * @return Texture pointer. Must manually delete.
+   */
+  Texture* LoadTextureFromFile(string _path);
+
+  /**
+   * @brief Add a loaded texture to the cache unless another thread added the path first
+   * @param _path
+   * @param texture
+   * @param pin true to keep the texture loaded for the rest of the program
+   * @return the cached texture
+   */
+  TextureHandle Store(const string& _path, const TextureHandle& texture, bool pin);
+
+  /**
+   * @brief Mark a cache entry as the most recently used. textureMutex must be locked.
+   * @param entry
+   * @param pin true to keep the texture loaded for the rest of the program
+   * @return TextureHandle
+   */
+  TextureHandle Use(CachedTexture& entry, bool pin);
+
+  /**
+   * @brief Drop the least recently used textures nobody holds until the cache is under budget. textureMutex must be locked.
+   */
+  void Evict();
+
+  /**
+   * @brief Query if the texture type is packed into the atlas
+   * @param _ttype
+   * @return true if packed
+   */
+  static const bool IsPacked(TextureType _ttype);
 };
 
 /*! \brief Shorthand to get instance of the manager */
 #define TEXTURES TextureResourceManager::GetInstance()
 
-/*! \brief Shorthand to get a preloaded texture */
-#define LOAD_TEXTURE(x) *TEXTURES.GetTexture(TextureType::x)
\ No newline at end of file
+/*! \brief Shorthand to get a preloaded texture. Pins it for the rest of the program. */
+#define LOAD_TEXTURE(x) *TEXTURES.GetTexture(TextureType::x)
+
+/*! \brief Shorthand to load a texture and keep its handle in a list. Evaluates to the texture. */
+#define HOLD_TEXTURE(handles, x) *(handles).emplace_back(TEXTURES.LoadTexture(TextureType::x))
\ No newline at end of file
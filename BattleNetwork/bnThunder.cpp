@@ -8,8 +8,8 @@
 Thunder::Thunder(Field* _field, Team _team) : Spell(_field, _team) {
   SetLayer(0);
 
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_THUNDER);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_THUNDER);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   this->elapsed = 0;
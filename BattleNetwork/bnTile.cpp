@@ -48,7 +48,7 @@ namespace Battle {
     isBattleActive = false;
     brokenCooldown = 0;
     flickerTeamCooldown = teamCooldown = 0;
-    red_team_atlas = blue_team_atlas = nullptr; // Set by field
+    red_team_atlas = blue_team_atlas = TextureRegion(); // Set by field
 
     burncycle = 0.12; // milliseconds
     elapsedBurnTime = burncycle;
@@ -83,6 +83,8 @@ namespace Battle {
     flickerTeamCooldown = other.flickerTeamCooldown;
     red_team_atlas = other.red_team_atlas;
     blue_team_atlas = other.blue_team_atlas;
+    atlasOffset = other.atlasOffset;
+    animationFrame = other.animationFrame;
     animation = other.animation;
     burncycle = other.burncycle;
     elapsedBurnTime = other.elapsedBurnTime;
@@ -120,6 +122,8 @@ namespace Battle {
     flickerTeamCooldown = other.flickerTeamCooldown;
     red_team_atlas = other.red_team_atlas;
     blue_team_atlas = other.blue_team_atlas;
+    atlasOffset = other.atlasOffset;
+    animationFrame = other.animationFrame;
     animation = other.animation;
     burncycle = other.burncycle;
     elapsedBurnTime = other.elapsedBurnTime;
@@ -229,11 +233,11 @@ namespace Battle {
       animState = std::move(GetAnimState(state));
     }
 
-    if (currTeam == Team::RED) {
-      this->setTexture(*red_team_atlas);
-    }
-    else {
-      this->setTexture(*blue_team_atlas);
+    const TextureRegion& region = (currTeam == Team::RED) ? red_team_atlas : blue_team_atlas;
+
+    if (region.texture) {
+      this->setTexture(*region.texture);
+      atlasOffset = sf::Vector2i(region.rect.left, region.rect.top);
     }
 
     if (prevAnimState != animState) {
@@ -527,7 +531,13 @@ namespace Battle {
     this->RefreshTexture();
 
     animation.SyncTime(totalElapsed);
-    animation.Refresh(*this);
+    animation.Refresh(animationFrame);
+
+    // Animation frames are relative to the tile atlas. Move them to where it was packed.
+    sf::IntRect frame = animationFrame.getTextureRect();
+    frame.left += atlasOffset.x;
+    frame.top += atlasOffset.y;
+    setTextureRect(frame);
 
     switch (highlightMode) {
     case Highlight::solid:
@@ -34,6 +34,7 @@ class Artifact;
 
 #include "bnTeam.h"
 #include "bnTextureType.h"
+#include "bnTextureAtlas.h"
 #include "bnTileState.h"
 #include "bnAnimation.h"
 #include "bnField.h"
@@ -275,8 +276,10 @@ namespace Battle {
     Field* field;
     float teamCooldown;
 
-    sf::Texture* red_team_atlas;
-    sf::Texture* blue_team_atlas;
+    TextureRegion red_team_atlas; /**< Set by field */
+    TextureRegion blue_team_atlas; /**< Set by field */
+    sf::Vector2i atlasOffset; /**< Where the current team atlas starts in its page */
+    sf::Sprite animationFrame; /**< The animation draws its frames here, relative to the tile atlas. Never offset. */
 
     static float teamCooldownLength;
     float brokenCooldown;
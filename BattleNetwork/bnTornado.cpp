@@ -8,8 +8,8 @@
 Tornado::Tornado(Field* _field, Team _team, int damage) : damage(damage), Spell(_field, _team) {
   SetLayer(-1);
 
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_TORNADO);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_TORNADO);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   //When the animation ends, delete this
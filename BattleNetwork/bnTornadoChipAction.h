@@ -2,12 +2,14 @@
 #include "bnChipAction.h"
 #include "bnAnimation.h"
 #include <SFML/Graphics.hpp>
+#include "bnTextureResourceManager.h"
 
 class SpriteSceneNode;
 class Character;
 class TornadoChipAction : public ChipAction {
 private:
   sf::Sprite fan;
+  TextureHandle fanTexture;
   SpriteSceneNode* attachment;
   Animation attachmentAnim;
   bool armIsOut;
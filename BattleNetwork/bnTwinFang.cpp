@@ -26,8 +26,8 @@ TwinFang::TwinFang(Field* _field, Team _team, Type _type, int damage) : Spell(_f
 
   SetLayer(0);
 
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_TWIN_FANG);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_TWIN_FANG);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   // Twin fang move from tile to tile in 4 frames
@@ -18,7 +18,8 @@
 
 VulcanChipAction::VulcanChipAction(Character * owner, int damage) : ChipAction(owner, "PLAYER_SHOOTING", &attachment, "Buster"), attachmentAnim(ANIM) {
   this->damage = damage;
-  overlay.setTexture(*TextureResourceManager::GetInstance().LoadTextureFromFile(PATH));
+  overlayTexture = TEXTURES.LoadTexture(PATH);
+  overlay.setTexture(*overlayTexture);
   this->attachment = new SpriteSceneNode(overlay);
   this->attachment->SetLayer(-1);
   attachmentAnim.Reload();
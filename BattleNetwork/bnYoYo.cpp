@@ -12,8 +12,8 @@ YoYo::YoYo(Field* _field, Team _team, int damage, double speed) : Spell(_field,
 
   SetLayer(0);
 
-  auto texture = TEXTURES.GetTexture(TextureType::SPELL_YOYO);
-  setTexture(*texture);
+  auto texture = TEXTURES.LoadTexture(TextureType::SPELL_YOYO);
+  setTexture(texture);
   setScale(2.f, 2.f);
 
   this->speed = speed;
@@ -18,7 +18,8 @@ YoYoChipAction::YoYoChipAction(Character * owner, int damage) : ChipAction(owner
   this->damage = damage;
 
   this->attachment = new SpriteSceneNode();
-  this->attachment->setTexture(*TextureResourceManager::GetInstance().LoadTextureFromFile(NODE_PATH));
+  attachmentTexture = TEXTURES.LoadTexture(NODE_PATH);
+  this->attachment->setTexture(*attachmentTexture);
   this->attachment->SetLayer(-1);
 
   attachmentAnim.Reload();
@@ -2,12 +2,14 @@
 #include "bnChipAction.h"
 #include "bnAnimation.h"
 #include <SFML/Graphics.hpp>
+#include "bnTextureResourceManager.h"
 
 class SpriteSceneNode;
 class Character;
 class YoYoChipAction : public ChipAction {
 private:
   SpriteSceneNode* attachment;
+  TextureHandle attachmentTexture;
   Animation attachmentAnim;
   Entity* yoyo;
   int damage;
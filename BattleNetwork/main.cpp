@@ -19,6 +19,14 @@
 #include "bnTextureResourceManager.h"
 #include "bnAudioResourceManager.h"
 #include "bnShaderResourceManager.h"
+#include "bnAssetLoader.h"
+#include "bnLoadGraph.h"
+#include "bnArchive.h"
+#include "bnAssetWatcher.h"
+#include "bnSaveService.h"
+#include "bnScriptResourceManager.h"
+#include "bnAnimationCache.h"
+#include "bnChipLibrary.h"
 #include "bnNaviRegistration.h"
 #include "bnInputManager.h"
 #include "bnEngine.h"
@@ -62,81 +70,44 @@ using swoosh::ActivityController;
 // GBA draws 60 frames in one seconds
 #define FIXED_TIME_STEP 1.0f/60.0f
 
-/*! \brief This thread initializes all navis
+/*! \brief Adds every registered navi and mob to the load graph
  * 
- * Uses an std::atomic<int> pointer 
+ * Uses std::atomic<int> counters
  * to keep track of all successfully loaded
  * objects.
  * 
- * After the media resources are loaded we
- * safely load all registered navis.
- * Loaded navis will show up in navi select
- * screen and can be chosen to play as in 
- * battle.
+ * Navis load as soon as their own textures
+ * are loaded. Mobs wait for the media event
+ * because every mob builds a battle field
+ * out of the packed atlas.
+ * Loaded navis and mobs will show up in the
+ * select screens.
  */
-void RunNaviInit(std::atomic<int>* progress) {
-  clock_t begin_time = clock();
-
-  NAVIS.LoadAllNavis(*progress);
-
-  Logger::GetMutex()->lock();
-  Logger::Logf("Loaded registered navis: %f secs", float(clock() - begin_time) / CLOCKS_PER_SEC);
-  Logger::GetMutex()->unlock();
+void RunRegistrationInit(LoadGraph& graph, LoadGraph::Node media, std::atomic<int>* navis, std::atomic<int>* mobs) {
+  NAVIS.LoadAllNavis(graph, *navis);
+  MOBS.LoadAllMobs(graph, media, *mobs);
 }
 
-/*! \brief This thread tnitializes all mobs
- * 
- * @see RunNaviInit()
- * 
- * After the media resources are loaded we 
- * safely load all registed mobs.
- * Loaded mobs will show up in mob select
- * screen and can be chosen to battle 
- * against.
- */
-void RunMobInit(std::atomic<int>* progress) {
-  clock_t begin_time = clock();
-
-  MOBS.LoadAllMobs(*progress);
-
-  Logger::GetMutex()->lock();
-  Logger::Logf("Loaded registered mobs: %f secs", float(clock() - begin_time) / CLOCKS_PER_SEC);
-  Logger::GetMutex()->unlock();
-}
-
-/*! \brief This thread loads textures and shaders
+/*! \brief Queues textures and shaders on the asset loader
  * 
  * Uses and std::atomic<int> pointer to keep
  * count of successfully loaded objects
+ *
+ * Returns right away. Decoding happens on the loader's workers
+ * and GL uploads happen when the main loop drains the loader.
  */
 void RunGraphicsInit(std::atomic<int> * progress) {
-  clock_t begin_time = clock();
   TEXTURES.LoadAllTextures(*progress);
-
-  Logger::GetMutex()->lock();
-  Logger::Logf("Loaded textures: %f secs", float(clock() - begin_time) / CLOCKS_PER_SEC);
-  Logger::GetMutex()->unlock();
-
-  begin_time = clock();
   SHADERS.LoadAllShaders(*progress);
-
-  Logger::GetMutex()->lock();
-  Logger::Logf("Loaded shaders: %f secs", float(clock() - begin_time) / CLOCKS_PER_SEC);
-  Logger::GetMutex()->unlock();
 }
 
-/*! \brief This thread loads sound effects
+/*! \brief Queues sound effects on the asset loader
  * 
  * Uses and std::atomic<int> pointer to keep
  * count of successfully loaded objects
  */
 void RunAudioInit(std::atomic<int> * progress) {
-  const clock_t begin_time = clock();
   AUDIO.LoadAllSources(*progress);
-
-  Logger::GetMutex()->lock();
-  Logger::Logf("Loaded audio sources: %f secs", float(clock() - begin_time) / CLOCKS_PER_SEC);
-  Logger::GetMutex()->unlock();
 }
 
 /*! \brief This function describes how the app behaves on focus regain
@@ -170,7 +141,36 @@ void AppLoseFocus() {
   AUDIO.EnableAudio(false);
 }
 
+/*! \brief Reload assets under resources/ as soon as they are saved
+ *
+ * Enabled with --hot-reload. Each change is applied on the main thread
+ * by the manager that owns the asset.
+ */
+void StartHotReload() {
+  WATCHER.Watch(".animation", [](const std::string& path) { ANIMATIONS.Reload(path); });
+  WATCHER.Watch(".frag", [](const std::string& path) { SHADERS.Reload(path); });
+  WATCHER.Watch(".vert", [](const std::string& path) { SHADERS.Reload(path); });
+  WATCHER.Watch(".png", [](const std::string& path) { TEXTURES.Reload(path); });
+  WATCHER.Watch("resources/database/library.txt", [](const std::string& path) { CHIPLIB.Reload(path); });
+
+  WATCHER.Start("resources");
+}
+
 int main(int argc, char** argv) {
+  bool hotReload = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (std::string(argv[i]) == "--hot-reload") {
+      hotReload = true;
+    }
+  }
+
+  // Packed resources are optional. Loose files are used when there is no archive.
+  // Hot reload reads the loose files so that edits show up.
+  if (!hotReload) {
+    ARCHIVE.Mount("resources.pak");
+  }
+
   // Initialize the engine and log the startup time
   const clock_t begin_time = clock();
   ENGINE.Initialize();
@@ -184,6 +184,8 @@ int main(int argc, char** argv) {
   TEXTURES;
   SHADERS;
   AUDIO;
+  LOADER.Start();
+  SAVES.Start();
   QueuNaviRegistration(); // Queues navis to be loaded later
   QueueMobRegistration(); // Queues mobs to be loaded later
 
@@ -195,6 +197,7 @@ int main(int argc, char** argv) {
   // try to read the config file
   ConfigReader config("options.ini");
   INPUT.SupportConfigSettings(config);
+  Logger::Configure(config.GetConfigSettings().GetLogLevels());
 
   if (config.GetConfigSettings().IsOK()) {
     // If the file is good, use the audio and 
@@ -202,20 +205,24 @@ int main(int argc, char** argv) {
     AUDIO.EnableAudio(config.GetConfigSettings().IsAudioEnabled());
     AUDIO.SetStreamVolume(((config.GetConfigSettings().GetMusicLevel()) / 3.0f)*100.0f);
     AUDIO.SetChannelVolume(((config.GetConfigSettings().GetSFXLevel()) / 3.0f)*100.0f);
+
+    if (config.GetConfigSettings().GetVoicesPerFrame() > 0) {
+      AUDIO.SetVoicesPerFrame(config.GetConfigSettings().GetVoicesPerFrame());
+    }
   }
 
   /**
     Because the resource managers have yet to be loaded 
     We must manually load some graphics ourselves
   */
-  sf::Texture* alert = TEXTURES.LoadTextureFromFile("resources/ui/alert.png");
+  TextureHandle alert = TEXTURES.LoadTexture("resources/ui/alert.png");
   sf::Sprite alertSprite(*alert);
   alertSprite.setScale(2.f, 2.f);
   alertSprite.setOrigin(alertSprite.getLocalBounds().width / 2, alertSprite.getLocalBounds().height / 2);
   sf::Vector2f alertPos = (sf::Vector2f)((sf::Vector2i)ENGINE.GetWindow()->getSize() / 2);
   alertSprite.setPosition(sf::Vector2f(100.f, alertPos.y));
 
-  sf::Texture* mouseTexture = TEXTURES.LoadTextureFromFile("resources/ui/mouse.png");
+  TextureHandle mouseTexture = TEXTURES.LoadTexture("resources/ui/mouse.png");
   sf::Sprite mouse(*mouseTexture);
   mouse.setScale(2.f, 2.f);
   Animation mouseAnimation("resources/ui/mouse.animation");
@@ -227,14 +234,14 @@ int main(int argc, char** argv) {
 
   // Title screen logo based on region
 #if OBN_REGION_JAPAN
-  sf::Texture* logo = TEXTURES.LoadTextureFromFile("resources/backgrounds/title/tile.png");
+  TextureHandle logo = TEXTURES.LoadTexture("resources/backgrounds/title/tile.png");
 #else
-  sf::Texture* logo = TEXTURES.LoadTextureFromFile("resources/backgrounds/title/tile_en.png");
+  TextureHandle logo = TEXTURES.LoadTexture("resources/backgrounds/title/tile_en.png");
 #endif
 
   SpriteSceneNode logoSprite;
 
-  logoSprite.setTexture(*logo);
+  logoSprite.setTexture(logo);
   logoSprite.setOrigin(logoSprite.getLocalBounds().width / 2, logoSprite.getLocalBounds().height / 2);
   sf::Vector2f logoPos = sf::Vector2f(240.f, 160.f);
   logoSprite.setPosition(logoPos);
@@ -339,9 +346,10 @@ int main(int argc, char** argv) {
 
   // Title screen background
   // This will be loaded from the resource manager AFTER it's ready
-  sf::Texture* bg = nullptr;
-  sf::Texture* progs = nullptr;
-  sf::Texture* cursor = nullptr;
+  TextureHandle bg;
+  TextureHandle progs;
+  TextureHandle cursor;
+  TextureHandle gamePadIcon;
 
   // List of frames
   FrameList progAnim;
@@ -364,29 +372,28 @@ int main(int argc, char** argv) {
   std::atomic<int> navisLoaded{0};
   std::atomic<int> mobsLoaded{0};
 
+  sf::Clock mediaClock;
   RunGraphicsInit(&progress);
+  RunAudioInit(&progress);
+
+  // Registration loads alongside the media. Must outlive LOADER.Stop().
+  LoadGraph registrations;
+  LoadGraph::Node mediaLoaded = registrations.AddEvent();
+  RunRegistrationInit(registrations, mediaLoaded, &navisLoaded, &mobsLoaded);
+  registrations.Start();
+
   ENGINE.SetShader(nullptr);
 
 #ifdef __ANDROID__
   loadSurface.setDefaultShader(&LOAD_SHADER(DEFAULT));
 #endif
 
-    //sf::Thread graphicsLoad(&RunGraphicsInit, &progress);
-  sf::Thread audioLoad(&RunAudioInit, &progress);
-
-  // We must deffer these threads until graphics and audio are finished
-  sf::Thread navisLoad(&RunNaviInit, &navisLoaded);
-  sf::Thread mobsLoad(&RunMobInit, &mobsLoaded);
-
-  audioLoad.launch();
-
   // stream some music while we wait
   AUDIO.Stream("resources/loops/loop_theme.ogg");
 
   // Draw some log info while we wait
   bool inLoadState = true;
   bool ready = false;
-  bool loadMobs = false;
   bool pressedStart = false;
 
   int selected = 0; // menu options are CONTINUE (0) and CONFIGURE (1)
@@ -405,6 +412,13 @@ int main(int argc, char** argv) {
     
     INPUT.Update();
 
+    // Finish textures and shaders the loader decoded. Keep the frame responsive.
+    LOADER.DrainUploads(sf::milliseconds(8));
+    SHADERS.Update(sf::milliseconds(4));
+
+    // Title screen sounds
+    AUDIO.Update();
+
     // Set title bar to loading %
     float percentage = (float)progress / (float)totalObjects;
     std::string percentageStr = std::to_string((int)(percentage*100));
@@ -434,11 +448,9 @@ int main(int argc, char** argv) {
     */
     std::string log;
 
-    Logger::GetMutex()->lock();
     if(Logger::GetNextLog(log)) {
       logs.insert(logs.begin(), log);
     }
-    Logger::GetMutex()->unlock();
 
     // If progress is equal to total resources, 
     // we can show graphics and load external data
@@ -447,15 +459,19 @@ int main(int argc, char** argv) {
       if (!ready) {
         ready = true;
 
-        // Now that media is ready, we can launch the navis thread
-        navisLoad.launch();
+        LOG_INFO(CORE, "Loaded media: %f secs", mediaClock.getElapsedTime().asSeconds());
+
+        AUDIO.LogReport();
+
+        // Now that media is ready, mobs can build their fields
+        registrations.Complete(mediaLoaded);
       }
       else { 
         // Else we may be ready this frame
         if (!bg) {
           // Load resources from internal storage
           try {
-            bg = TEXTURES.GetTexture(TextureType::BG_BLUE);
+            bg = TEXTURES.LoadTexture(TextureType::BG_BLUE);
             bgSprite.setTexture(*bg);
             bgSprite.setScale(2.f, 2.f);
           }
@@ -467,7 +483,7 @@ int main(int argc, char** argv) {
         if (!progs) {
           // Load resources from internal storage
           try {
-            progs = TEXTURES.GetTexture(TextureType::TITLE_ANIM_CHAR);
+            progs = TEXTURES.LoadTexture(TextureType::TITLE_ANIM_CHAR);
 
             progSprite.setTexture(*progs);
             progSprite.setPosition(200.f, 0.f);
@@ -490,7 +506,7 @@ int main(int argc, char** argv) {
         if (!cursor) {
           // Load resources from internal storage
           try {
-            cursor = TEXTURES.GetTexture(TextureType::TEXT_BOX_CURSOR);
+            cursor = TEXTURES.LoadTexture(TextureType::TEXT_BOX_CURSOR);
 
             cursorSprite.setTexture(*cursor);
             cursorSprite.setPosition(sf::Vector2f(160.0f, 225.f));
@@ -505,6 +521,7 @@ int main(int argc, char** argv) {
           try {
             whiteShader = SHADERS.GetShader(ShaderType::WHITE_FADE);
             whiteShader->setUniform("opacity", 0.0f);
+            SmartShader::Invalidate(whiteShader);
             ENGINE.SetShader(whiteShader);
           }
           catch (std::exception e) {
@@ -541,6 +558,7 @@ int main(int argc, char** argv) {
 
         // update white flash
         whiteShader->setUniform("opacity", (float)(shaderCooldown / 1000.f)*0.5f);
+        SmartShader::Invalidate(whiteShader);
       }
     }
 
@@ -554,7 +572,11 @@ int main(int argc, char** argv) {
 
       // Show the gamepad icon at the top-left if we have joystick support
       if (INPUT.IsJosytickAvailable()) {
-        sf::Sprite gamePadICon(*TEXTURES.GetTexture(TextureType::GAMEPAD_SUPPORT_ICON));
+        if (!gamePadIcon) {
+          gamePadIcon = TEXTURES.LoadTexture(TextureType::GAMEPAD_SUPPORT_ICON);
+        }
+
+        sf::Sprite gamePadICon(*gamePadIcon);
         gamePadICon.setScale(2.f, 2.f);
         gamePadICon.setPosition(10.f, 5.0f);
         ENGINE.Draw(gamePadICon);
@@ -590,19 +612,13 @@ int main(int argc, char** argv) {
         ENGINE.Draw(navisLoadedLabel);
       }
       else {
-        // Else, navis are loaded, launch next thread and display mob %
+        // Else, navis are loaded, display mob %
         if (mobsLoaded < (int)MOBS.Size()) {
-          if (!loadMobs) {
-            loadMobs = true;
-            mobsLoad.launch();
-          }
-          else {
-            mobLoadedLabel->setString(std::string("Loading Mob Data ") + std::to_string(mobsLoaded) + " / " + std::to_string(MOBS.Size()));
-            sf::FloatRect bounds = mobLoadedLabel->getLocalBounds();
-            sf::Vector2f origin = { bounds.width / 2.0f, bounds.height / 2.0f };
-            mobLoadedLabel->setOrigin(origin);
-            ENGINE.Draw(mobLoadedLabel);
-          }
+          mobLoadedLabel->setString(std::string("Loading Mob Data ") + std::to_string(mobsLoaded) + " / " + std::to_string(MOBS.Size()));
+          sf::FloatRect bounds = mobLoadedLabel->getLocalBounds();
+          sf::Vector2f origin = { bounds.width / 2.0f, bounds.height / 2.0f };
+          mobLoadedLabel->setOrigin(origin);
+          ENGINE.Draw(mobLoadedLabel);
         }
         else {
           // Finally everything is loaded
@@ -727,7 +743,13 @@ int main(int argc, char** argv) {
 
   //delete logLabel;
   //delete font;
-  delete logo;
+  logo.reset();
+
+  // The title screen textures can be evicted now
+  bg.reset();
+  progs.reset();
+  cursor.reset();
+  gamePadIcon.reset();
 
   // Stop music and go to menu screen
   AUDIO.StopStream();
@@ -764,8 +786,15 @@ int main(int argc, char** argv) {
   logLabel->setPosition(296,18);
   logLabel->setStyle(sf::Text::Style::Bold);
 
+  if (hotReload) {
+    StartHotReload();
+  }
+
   // Make sure we didn't quit the loop prematurely
   while (ENGINE.Running()) {
+      // Swap in assets that were saved since the last frame
+      WATCHER.Poll();
+
       // Non-simulation
       elapsed = static_cast<float>(clock.restart().asSeconds()) + static_cast<float>(remainder);
 
@@ -783,6 +812,15 @@ int main(int argc, char** argv) {
       // Use the activity controller to update and draw scenes
       app.update((float) FIXED_TIME_STEP);
 
+      // Start the sounds the scenes asked for this frame
+      AUDIO.Update();
+
+      // Create textures the loader decoded for the scenes, e.g. select screen prefetches
+      LOADER.DrainUploads(sf::milliseconds(4));
+
+      // Compile shaders the scenes started using
+      SHADERS.Update(sf::milliseconds(4));
+
       sf::Vector2f mousepos = ENGINE.GetWindow()->mapPixelToCoords(sf::Mouse::getPosition(*ENGINE.GetWindow()));
       mouseAlpha -= FIXED_TIME_STEP;
       mouseAlpha = std::max(0.0, mouseAlpha);
@@ -820,9 +858,17 @@ int main(int argc, char** argv) {
       ENGINE.GetWindow()->display();
 
   }
-  delete mouseTexture;
   delete logLabel;
   delete font;
 
+  WATCHER.Stop();
+  LOADER.Stop();
+
+  // Write anything the scenes saved in their last frames
+  SAVES.Stop();
+
+  // How long each mod's behaviours ran for
+  SCRIPTS.LogProfiles();
+
   return EXIT_SUCCESS;
 }
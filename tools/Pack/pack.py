@@ -0,0 +1,85 @@
+import os
+import struct
+import sys
+
+# Optional. Without it every file is stored uncompressed.
+try:
+	import lz4.block
+except ImportError:
+	lz4 = None
+
+MAGIC = b"OBNP"
+VERSION = 1
+HEADER = struct.Struct("<4sIII")
+ENTRY = struct.Struct("<QQQQIIII")
+FLAG_LZ4 = 1
+ALIGN = 16
+
+if len(sys.argv) <= 1:
+	print("Provide (1) the directory that contains resources/ (2) optional output file (default resources.pak)")
+	quit()
+
+def fnv1a(text):
+	hash = 14695981039346656037
+	for byte in text.encode("utf-8"):
+		hash ^= byte
+		hash = (hash * 1099511628211) & 0xFFFFFFFFFFFFFFFF
+	return hash
+
+def align(offset):
+	return (offset + ALIGN - 1) & ~(ALIGN - 1)
+
+root = sys.argv[1]
+output = sys.argv[2] if len(sys.argv) > 2 else "resources.pak"
+
+files = []
+for folder, _, names in os.walk(os.path.join(root, "resources")):
+	for name in names:
+		full = os.path.join(folder, name)
+		# The game asks for paths relative to its working directory
+		files.append((os.path.relpath(full, root).replace(os.sep, "/"), full))
+
+files.sort(key=lambda f: fnv1a(f[0]))
+
+paths = b""
+path_offsets = []
+base = HEADER.size + ENTRY.size * len(files)
+
+for path, _ in files:
+	path_offsets.append(base + len(paths))
+	paths += path.encode("utf-8")
+
+entries = []
+blobs = []
+offset = align(base + len(paths))
+stored = 0
+
+for (path, full), path_offset in zip(files, path_offsets):
+	with open(full, "rb") as f:
+		data = f.read()
+
+	blob = data
+	flags = 0
+
+	if lz4 is not None and len(data) > 0:
+		packed = lz4.block.compress(data, store_size=False)
+		# Images and audio are already compressed
+		if len(packed) < len(data):
+			blob = packed
+			flags = FLAG_LZ4
+
+	entries.append(ENTRY.pack(fnv1a(path), offset, len(data), len(blob), path_offset, len(path.encode("utf-8")), flags, 0))
+	blobs.append((offset, blob))
+	offset = align(offset + len(blob))
+	stored += len(blob)
+
+with open(output, "wb") as f:
+	f.write(HEADER.pack(MAGIC, VERSION, len(files), 0))
+	for entry in entries:
+		f.write(entry)
+	f.write(paths)
+	for blob_offset, blob in blobs:
+		f.write(b"\0" * (blob_offset - f.tell()))
+		f.write(blob)
+
+print("Packed %i files (%i bytes) into %s" % (len(files), stored, output))